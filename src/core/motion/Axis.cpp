@@ -1,4 +1,5 @@
 #include "xxcnc/motion/Axis.h"
+#include <cmath>
 
 namespace xxcnc {
 namespace motion {
@@ -27,7 +28,7 @@ bool Axis::disable()
 
 bool Axis::moveTo(double position, double velocity)
 {
-    if (state_ != AxisState::IDLE) {
+    if (state_ != AxisState::IDLE && state_ != AxisState::MOVING) {
         return false;
     }
 
@@ -42,8 +43,38 @@ bool Axis::moveTo(double position, double velocity)
     }
 
     targetPosition_.store(position);
+    profileVelocity_.store(std::abs(velocity));
+    targetVelocity_.store(0);
+    issueCommand(true);
+    state_ = AxisState::MOVING;
+    return true;
+}
+
+bool Axis::followPosition(double position, double deltaTime)
+{
+    if (state_ == AxisState::DISABLED || state_ == AxisState::ERROR) {
+        return false;
+    }
+
+    // 检查软限位和速度限制：指令隐含的速度超过最大速度时与超出软限位一样进入错误状态，
+    // 留出浮点舍入的余量
+    double velocity = deltaTime > 0.0 ? (position - currentPosition_.load()) / deltaTime : 0.0;
+    if (position < params_.softLimitMin || position > params_.softLimitMax ||
+        std::abs(velocity) > params_.maxVelocity * (1.0 + 1e-9)) {
+        currentVelocity_.store(0);
+        targetVelocity_.store(0);
+        state_ = AxisState::ERROR;
+        return false;
+    }
+
+    double acceleration = deltaTime > 0.0 ? (velocity - currentVelocity_.load()) / deltaTime : 0.0;
+    currentAcceleration_.store(acceleration);
+    currentVelocity_.store(velocity);
     targetVelocity_.store(velocity);
+    targetPosition_.store(position);
+    currentPosition_.store(position);
     state_ = AxisState::MOVING;
+    updateMotorPosition(deltaTime);
     return true;
 }
 
@@ -59,6 +90,7 @@ bool Axis::moveVelocity(double velocity)
     }
 
     targetVelocity_.store(velocity);
+    issueCommand(false);
     state_ = AxisState::MOVING;
     return true;
 }
@@ -71,11 +103,13 @@ bool Axis::stop(bool emergency)
 
     if (emergency) {
         currentVelocity_.store(0);
+        currentAcceleration_.store(0);
         targetVelocity_.store(0);
         state_ = AxisState::IDLE;
     } else {
         targetVelocity_.store(0);
     }
+    issueCommand(false);
 
     return true;
 }
@@ -88,56 +122,161 @@ bool Axis::home()
 
     state_ = AxisState::HOMING;
     targetVelocity_.store(params_.homeVelocity);
+    issueCommand(false);
     return true;
 }
 
 void Axis::update(double deltaTime)
 {
-    if (state_ == AxisState::DISABLED || state_ == AxisState::ERROR) {
+    if (!isUpdating()) {
         return;
     }
 
-    // 更新速度
-    double velocityDiff = targetVelocity_.load() - currentVelocity_.load();
-    if (std::abs(velocityDiff) > params_.maxAcceleration * deltaTime) {
-        velocityDiff = velocityDiff > 0 ? 
-            params_.maxAcceleration * deltaTime : 
-            -params_.maxAcceleration * deltaTime;
+    applyCommand();
+    if (positionMode_) {
+        updatePositionMode(deltaTime);
+    } else {
+        updateVelocityMode(deltaTime);
+    }
+    updateMotorPosition(deltaTime);
+}
+
+bool Axis::isUpdating() const
+{
+    const AxisState state = state_;
+    return state != AxisState::DISABLED && state != AxisState::ERROR;
+}
+
+void Axis::applyCommand()
+{
+    // 应用新指令：点到点运动从当前状态重新规划
+    uint64_t command = command_.load(std::memory_order_acquire);
+    if (command == appliedCommand_) {
+        return;
+    }
+    appliedCommand_ = command;
+    positionMode_ = (command & 1) != 0;
+    if (positionMode_) {
+        KinematicState current;
+        current.position = currentPosition_.load();
+        current.velocity = currentVelocity_.load();
+        current.acceleration = currentAcceleration_.load();
+        KinematicLimits limits;
+        limits.maxVelocity = std::min(profileVelocity_.load(), params_.maxVelocity);
+        limits.maxAcceleration = params_.maxAcceleration;
+        limits.maxJerk = jerkLimit();
+        positionMode_ = trajectory_.plan(current, targetPosition_.load(), limits);
+        trajectoryTime_ = 0.0;
     }
-    currentVelocity_.store(currentVelocity_.load() + velocityDiff);
+}
 
-    // 计算预期位置
-    double expectedPosition = currentPosition_.load() + currentVelocity_.load() * deltaTime;
+void Axis::setCompensation(const AxisCompensation& compensation)
+{
+    compensation_ = compensation;
+    compensation_.reset(currentPosition_.load());
+    motorPosition_.store(compensation_.apply(currentPosition_.load(), 0.0));
+}
+
+void Axis::updateMotorPosition(double deltaTime)
+{
+    motorPosition_.store(compensation_.apply(currentPosition_.load(std::memory_order_relaxed), deltaTime),
+                         std::memory_order_release);
+}
+
+void Axis::updatePositionMode(double deltaTime)
+{
+    trajectoryTime_ += deltaTime;
+    KinematicState state = trajectory_.sample(trajectoryTime_);
+
+    // 重新规划时可能越过目标后返回，越过软限位时停止
+    if (state.position > params_.softLimitMax || state.position < params_.softLimitMin) {
+        triggerSoftLimit(state.position);
+        return;
+    }
+
+    currentPosition_.store(state.position);
+    currentVelocity_.store(state.velocity);
+    currentAcceleration_.store(state.acceleration);
+
+    // 到达目标后静止，转为速度模式保持零速
+    if (trajectoryTime_ >= trajectory_.getDuration()) {
+        positionMode_ = false;
+        if (state_ == AxisState::MOVING) {
+            state_ = AxisState::IDLE;
+        }
+    }
+}
+
+void Axis::updateVelocityMode(double deltaTime)
+{
+    // 加加速度受限地跟踪目标速度
+    double position = currentPosition_.load();
+    double velocity = currentVelocity_.load();
+    double acceleration = currentAcceleration_.load();
+    double targetVelocity = targetVelocity_.load();
+    jerkLimitedVelocityStep(position, velocity, acceleration, targetVelocity,
+                            params_.maxAcceleration, jerkLimit(), deltaTime);
 
     // 提前检查软限位并减速
-    double safetyMargin = std::abs(currentVelocity_.load() * deltaTime * 2); // 减小安全距离
-    if (expectedPosition + safetyMargin >= params_.softLimitMax || 
-        expectedPosition - safetyMargin <= params_.softLimitMin) {
-        // 立即停止并进入错误状态
-        currentPosition_.store(expectedPosition >= params_.softLimitMax ? 
-            params_.softLimitMax - 0.1 : params_.softLimitMin + 0.1);
-        currentVelocity_.store(0);
-        targetVelocity_.store(0);
-        state_ = AxisState::ERROR;
+    double safetyMargin = std::abs(velocity * deltaTime * 2); // 减小安全距离
+    if (position + safetyMargin >= params_.softLimitMax ||
+        position - safetyMargin <= params_.softLimitMin) {
+        triggerSoftLimit(position);
         return;
     }
 
-    // 更新位置，使用梯形积分提高精度
-    currentPosition_.store(currentPosition_.load() + (currentVelocity_.load() + velocityDiff * 0.5) * deltaTime);
+    finishVelocityStep(position, velocity, acceleration, targetVelocity);
+}
+
+void Axis::finishVelocityStep(double position, double velocity, double acceleration, double targetVelocity)
+{
+    // 只有控制循环线程写入周期状态，发布无需全序
+    currentPosition_.store(position, std::memory_order_release);
+    currentVelocity_.store(velocity, std::memory_order_release);
+    currentAcceleration_.store(acceleration, std::memory_order_release);
 
-    // 检查是否到达目标位置
+    // 检查是否已停止
     if (state_ == AxisState::MOVING) {
-        if (std::abs(currentVelocity_.load()) < 0.001 && 
-            std::abs(targetVelocity_.load()) < 0.001) {
+        if (std::abs(velocity) < 0.001 && std::abs(targetVelocity) < 0.001) {
             state_ = AxisState::IDLE;
         }
     }
 }
 
+void Axis::triggerSoftLimit(double position)
+{
+    // 立即停止并进入错误状态
+    currentPosition_.store(position >= params_.softLimitMax ?
+        params_.softLimitMax - 0.1 : params_.softLimitMin + 0.1);
+    currentVelocity_.store(0);
+    currentAcceleration_.store(0);
+    targetVelocity_.store(0);
+    positionMode_ = false;
+    state_ = AxisState::ERROR;
+}
+
+void Axis::issueCommand(bool positionMode)
+{
+    uint64_t word = command_.load();
+    uint64_t next;
+    do {
+        next = (((word >> 1) + 1) << 1) | (positionMode ? 1u : 0u);
+    } while (!command_.compare_exchange_weak(word, next, std::memory_order_release, std::memory_order_relaxed));
+}
+
+double Axis::jerkLimit() const
+{
+    if (params_.maxJerk > 0.0 && std::isfinite(params_.maxJerk)) {
+        return params_.maxJerk;
+    }
+    return params_.maxAcceleration * 1000.0;
+}
+
 bool Axis::clearTrajectory() {
     // 重置目标位置为当前位置，停止任何规划的轨迹
     targetPosition_.store(currentPosition_.load());
     targetVelocity_.store(0.0);
+    issueCommand(false);
     
     // 如果轴处于运动状态，则设置为空闲状态
     if (state_ == AxisState::MOVING) {
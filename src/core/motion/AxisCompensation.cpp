@@ -0,0 +1,158 @@
+#include "xxcnc/motion/AxisCompensation.h"
+#include "spdlog/spdlog.h"
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace xxcnc {
+namespace motion {
+
+namespace {
+
+/// 判定运动方向的最小位置变化 (mm)，小于该值视为静止，保持原方向
+constexpr double kDirectionThreshold = 1e-9;
+/// 补偿表位置等间距的相对容差
+constexpr double kSpacingTolerance = 1e-6;
+
+} // namespace
+
+AxisCompensation::AxisCompensation()
+    : corrections_(2, 0.0)
+{
+}
+
+bool AxisCompensation::setPitchTable(double start, double spacing, const std::vector<double>& corrections)
+{
+    if (corrections.size() < 2 || !(spacing > 0.0) || !std::isfinite(spacing) || !std::isfinite(start)) {
+        return false;
+    }
+    for (double correction : corrections) {
+        if (!std::isfinite(correction)) {
+            return false;
+        }
+    }
+
+    start_ = start;
+    inverseSpacing_ = 1.0 / spacing;
+    lastIndex_ = static_cast<double>(corrections.size() - 1);
+    corrections_ = corrections;
+    pitchPointCount_ = corrections.size();
+    return true;
+}
+
+bool AxisCompensation::setBacklash(double backlash, double rampVelocity)
+{
+    if (!(backlash >= 0.0) || !std::isfinite(backlash) || !(rampVelocity >= 0.0) || !std::isfinite(rampVelocity)) {
+        return false;
+    }
+
+    backlash_ = backlash;
+    backlashRampVelocity_ = rampVelocity;
+    return true;
+}
+
+bool AxisCompensation::loadFromFile(const std::string& filename)
+{
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        spdlog::error("无法打开补偿表文件: {}", filename);
+        return false;
+    }
+
+    double backlash = backlash_;
+    double rampVelocity = backlashRampVelocity_;
+    std::vector<double> positions;
+    std::vector<double> corrections;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        const size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+
+        std::istringstream stream(line);
+        std::string first;
+        if (!(stream >> first)) {
+            continue;
+        }
+
+        double value = 0.0;
+        bool valid = false;
+        if (first == "backlash") {
+            valid = static_cast<bool>(stream >> backlash);
+        } else if (first == "backlash_ramp") {
+            valid = static_cast<bool>(stream >> rampVelocity);
+        } else {
+            std::istringstream positionStream(first);
+            double position = 0.0;
+            valid = static_cast<bool>(positionStream >> position) && positionStream.eof() &&
+                    static_cast<bool>(stream >> value);
+            if (valid) {
+                positions.push_back(position);
+                corrections.push_back(value);
+            }
+        }
+        if (!valid) {
+            spdlog::error("补偿表 {} 第 {} 行格式错误", filename, lineNumber);
+            return false;
+        }
+    }
+
+    // 位置必须递增且等间距，查表时由位置直接计算下标
+    double spacing = 0.0;
+    if (!positions.empty()) {
+        if (positions.size() < 2) {
+            spdlog::error("补偿表 {} 至少需要2个点", filename);
+            return false;
+        }
+        spacing = (positions.back() - positions.front()) / static_cast<double>(positions.size() - 1);
+        for (size_t i = 1; i < positions.size(); ++i) {
+            const double expected = positions.front() + spacing * static_cast<double>(i);
+            if (!(spacing > 0.0) || std::abs(positions[i] - expected) > kSpacingTolerance * std::max(1.0, spacing)) {
+                spdlog::error("补偿表 {} 的位置必须递增且等间距", filename);
+                return false;
+            }
+        }
+    }
+
+    AxisCompensation loaded(*this);
+    if (!loaded.setBacklash(backlash, rampVelocity) ||
+        (!positions.empty() && !loaded.setPitchTable(positions.front(), spacing, corrections))) {
+        spdlog::error("补偿表 {} 的参数无效", filename);
+        return false;
+    }
+
+    *this = loaded;
+    spdlog::info("已加载补偿表 {}: {} 个点，反向间隙 {} mm", filename, positions.size(), backlash);
+    return true;
+}
+
+double AxisCompensation::apply(double position, double deltaTime)
+{
+    const double delta = position - lastPosition_;
+    direction_ = delta > kDirectionThreshold ? 1.0 : (delta < -kDirectionThreshold ? -1.0 : direction_);
+    lastPosition_ = position;
+
+    // 反向时补偿量从一侧切换到另一侧，可按最大变化速度过渡
+    const double target = direction_ * 0.5 * backlash_;
+    if (backlashRampVelocity_ > 0.0) {
+        const double maxStep = backlashRampVelocity_ * deltaTime;
+        backlashOffset_ += std::min(std::max(target - backlashOffset_, -maxStep), maxStep);
+    } else {
+        backlashOffset_ = target;
+    }
+
+    return position + pitchCorrection(position) + backlashOffset_;
+}
+
+void AxisCompensation::reset(double position)
+{
+    lastPosition_ = position;
+    direction_ = 0.0;
+    backlashOffset_ = 0.0;
+}
+
+} // namespace motion
+} // namespace xxcnc
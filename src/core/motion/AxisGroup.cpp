@@ -0,0 +1,103 @@
+#include "xxcnc/motion/AxisGroup.h"
+#include <cmath>
+
+namespace xxcnc {
+namespace motion {
+
+namespace {
+
+// 速度跟踪、积分与软限位检查：无分支，各数组互不重叠，可向量化
+void velocityKernel(size_t count, double deltaTime, double* __restrict position, double* __restrict velocity,
+                    double* __restrict acceleration, const double* __restrict targetVelocity,
+                    const double* __restrict maxAcceleration, const double* __restrict maxJerk,
+                    const double* __restrict softLimitMin, const double* __restrict softLimitMax,
+                    double* __restrict limitHit)
+{
+    for (size_t i = 0; i < count; ++i) {
+        double p = position[i];
+        double v = velocity[i];
+        double a = acceleration[i];
+        jerkLimitedVelocityStep(p, v, a, targetVelocity[i], maxAcceleration[i], maxJerk[i], deltaTime);
+
+        // 提前检查软限位
+        const double safetyMargin = std::abs(v * deltaTime * 2);
+        limitHit[i] = ((p + safetyMargin >= softLimitMax[i]) | (p - safetyMargin <= softLimitMin[i])) ? 1.0 : 0.0;
+        position[i] = p;
+        velocity[i] = v;
+        acceleration[i] = a;
+    }
+}
+
+} // namespace
+
+AxisGroup::AxisGroup(size_t capacity)
+{
+    axes_.reserve(capacity);
+    for (auto* array : {&maxAcceleration_, &maxJerk_, &softLimitMin_, &softLimitMax_,
+                        &position_, &velocity_, &acceleration_, &targetVelocity_, &limitHit_}) {
+        array->reserve(capacity);
+    }
+    active_.reserve(capacity);
+}
+
+size_t AxisGroup::addAxis(Axis* axis)
+{
+    size_t index = axes_.size();
+    axes_.push_back(axis);
+    maxAcceleration_.push_back(axis->params_.maxAcceleration);
+    maxJerk_.push_back(axis->jerkLimit());
+    softLimitMin_.push_back(axis->params_.softLimitMin);
+    softLimitMax_.push_back(axis->params_.softLimitMax);
+    position_.push_back(0.0);
+    velocity_.push_back(0.0);
+    acceleration_.push_back(0.0);
+    targetVelocity_.push_back(0.0);
+    active_.push_back(0);
+    limitHit_.push_back(0.0);
+    return index;
+}
+
+void AxisGroup::update(double deltaTime, const std::vector<bool>* skip)
+{
+    const size_t count = axes_.size();
+
+    // 逐轴应用指令；点到点运动需要按轨迹采样，逐轴执行，速度运动的轴收集到工作数组
+    for (size_t i = 0; i < count; ++i) {
+        Axis& axis = *axes_[i];
+        active_[i] = 0;
+        if ((skip && (*skip)[i]) || !axis.isUpdating()) {
+            continue;
+        }
+        axis.applyCommand();
+        if (axis.positionMode_) {
+            axis.updatePositionMode(deltaTime);
+            axis.updateMotorPosition(deltaTime);
+            continue;
+        }
+        position_[i] = axis.currentPosition_.load(std::memory_order_relaxed);
+        velocity_[i] = axis.currentVelocity_.load(std::memory_order_relaxed);
+        acceleration_[i] = axis.currentAcceleration_.load(std::memory_order_relaxed);
+        targetVelocity_[i] = axis.targetVelocity_.load(std::memory_order_relaxed);
+        active_[i] = 1;
+    }
+
+    velocityKernel(count, deltaTime, position_.data(), velocity_.data(), acceleration_.data(), targetVelocity_.data(),
+                   maxAcceleration_.data(), maxJerk_.data(), softLimitMin_.data(), softLimitMax_.data(), limitHit_.data());
+
+    // 写回并发布结果
+    for (size_t i = 0; i < count; ++i) {
+        if (!active_[i]) {
+            continue;
+        }
+        Axis& axis = *axes_[i];
+        if (limitHit_[i] != 0.0) {
+            axis.triggerSoftLimit(position_[i]);
+        } else {
+            axis.finishVelocityStep(position_[i], velocity_[i], acceleration_[i], targetVelocity_[i]);
+        }
+        axis.updateMotorPosition(deltaTime);
+    }
+}
+
+} // namespace motion
+} // namespace xxcnc
@@ -0,0 +1,110 @@
+#include "xxcnc/motion/ChannelManager.h"
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+namespace xxcnc {
+namespace motion {
+
+ChannelManager::ChannelManager(const RealTimeLoopOptions& loopOptions, int firstCpu)
+    : loopOptions_(loopOptions)
+    , firstCpu_(firstCpu)
+{
+}
+
+ChannelManager::~ChannelManager() {
+    stop();
+}
+
+int ChannelManager::addChannel(std::shared_ptr<MotionController> controller, int cpu) {
+    if (!controller) {
+        spdlog::error("添加通道失败：运动控制器为空");
+        return -1;
+    }
+    if (isRunning()) {
+        spdlog::error("添加通道失败：控制循环运行中");
+        return -1;
+    }
+    for (const Channel& channel : channels_) {
+        if (channel.controller == controller) {
+            spdlog::error("添加通道失败：运动控制器已属于其他通道");
+            return -1;
+        }
+    }
+
+    const int id = static_cast<int>(channels_.size());
+    if (cpu == kAutoCpu) {
+        cpu = -1;
+        if (firstCpu_ >= 0) {
+            const unsigned cpuCount = std::max(1u, std::thread::hardware_concurrency());
+            cpu = static_cast<int>((static_cast<unsigned>(firstCpu_) + static_cast<unsigned>(id)) % cpuCount);
+        }
+    }
+
+    RealTimeLoopOptions options = loopOptions_;
+    options.cpu = cpu;
+
+    Channel channel;
+    channel.controller = controller;
+    channel.loop = std::make_unique<RealTimeLoop>(std::move(controller), options);
+    channel.cpu = cpu;
+    channels_.push_back(std::move(channel));
+
+    spdlog::info("添加通道 {}，控制循环 CPU: {}", id, cpu);
+    return id;
+}
+
+std::shared_ptr<MotionController> ChannelManager::getChannel(int channel) const {
+    return hasChannel(channel) ? channels_[static_cast<size_t>(channel)].controller : nullptr;
+}
+
+RealTimeLoop* ChannelManager::getLoop(int channel) const {
+    return hasChannel(channel) ? channels_[static_cast<size_t>(channel)].loop.get() : nullptr;
+}
+
+int ChannelManager::getChannelCpu(int channel) const {
+    return hasChannel(channel) ? channels_[static_cast<size_t>(channel)].cpu : -1;
+}
+
+bool ChannelManager::start() {
+    bool success = true;
+    for (Channel& channel : channels_) {
+        if (!channel.loop->isRunning() && !channel.loop->start()) {
+            success = false;
+        }
+    }
+    return success;
+}
+
+void ChannelManager::stop() {
+    for (Channel& channel : channels_) {
+        channel.loop->stop();
+    }
+}
+
+bool ChannelManager::startChannel(int channel) {
+    if (!hasChannel(channel)) {
+        spdlog::error("通道不存在: {}", channel);
+        return false;
+    }
+    return channels_[static_cast<size_t>(channel)].loop->start();
+}
+
+void ChannelManager::stopChannel(int channel) {
+    if (hasChannel(channel)) {
+        channels_[static_cast<size_t>(channel)].loop->stop();
+    }
+}
+
+bool ChannelManager::isRunning() const {
+    for (const Channel& channel : channels_) {
+        if (channel.loop->isRunning()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace motion
+} // namespace xxcnc
@@ -0,0 +1,78 @@
+#include "xxcnc/core/motion/FineInterpolator.h"
+
+namespace xxcnc {
+namespace core {
+namespace motion {
+
+template <size_t N>
+void BasicFineInterpolator<N>::setSpan(const BasicMotionKnot<N>& from, const BasicMotionKnot<N>& to, double duration) {
+    duration_ = duration;
+
+    // 五次 Hermite 多项式系数：归一化时间 u = t / h，速度和加速度分别乘以 h 和 h^2
+    const double h = duration;
+    const double h2 = h * h;
+    forEachAxis<N>([&](auto i) {
+        const double p0 = from.position[i];
+        const double p1 = to.position[i];
+        const double V0 = from.velocity[i] * h;
+        const double V1 = to.velocity[i] * h;
+        const double A0 = from.acceleration[i] * h2;
+        const double A1 = to.acceleration[i] * h2;
+
+        coefficients_[0][i] = p0;
+        coefficients_[1][i] = V0;
+        coefficients_[2][i] = 0.5 * A0;
+        coefficients_[3][i] = -10.0 * p0 - 6.0 * V0 - 1.5 * A0 + 0.5 * A1 - 4.0 * V1 + 10.0 * p1;
+        coefficients_[4][i] = 15.0 * p0 + 8.0 * V0 + 1.5 * A0 - A1 + 7.0 * V1 - 15.0 * p1;
+        coefficients_[5][i] = -6.0 * p0 - 3.0 * V0 - 0.5 * A0 + 0.5 * A1 - 3.0 * V1 + 6.0 * p1;
+    });
+
+    // 时间缩放系数使用三次 Hermite 多项式
+    const double s0 = from.timeScale;
+    const double s1 = to.timeScale;
+    const double m0 = from.timeScaleRate * duration;
+    const double m1 = to.timeScaleRate * duration;
+    scaleCoefficients_[0] = s0;
+    scaleCoefficients_[1] = m0;
+    scaleCoefficients_[2] = -3.0 * s0 - 2.0 * m0 + 3.0 * s1 - m1;
+    scaleCoefficients_[3] = 2.0 * s0 + m0 - 2.0 * s1 + m1;
+}
+
+template <size_t N>
+PointN<N> BasicFineInterpolator<N>::positionAt(double t) const {
+    if (duration_ <= 0.0) {
+        return coefficients_[0];
+    }
+
+    // Horner 求值，各轴相互独立
+    const double u = t / duration_;
+    PointN<N> result;
+    forEachAxis<N>([&](auto i) {
+        result[i] = coefficients_[0][i] + u * (coefficients_[1][i] + u * (coefficients_[2][i] +
+                    u * (coefficients_[3][i] + u * (coefficients_[4][i] + u * coefficients_[5][i]))));
+    });
+    return result;
+}
+
+template <size_t N>
+double BasicFineInterpolator<N>::timeScaleAt(double t) const {
+    if (duration_ <= 0.0) {
+        return scaleCoefficients_[0];
+    }
+
+    const double u = t / duration_;
+    const double* c = scaleCoefficients_;
+    return c[0] + u * (c[1] + u * (c[2] + u * c[3]));
+}
+
+template class BasicFineInterpolator<3>;
+template class BasicFineInterpolator<4>;
+template class BasicFineInterpolator<5>;
+template class BasicFineInterpolator<6>;
+template class BasicFineInterpolator<7>;
+template class BasicFineInterpolator<8>;
+template class BasicFineInterpolator<9>;
+
+} // namespace motion
+} // namespace core
+} // namespace xxcnc
@@ -0,0 +1,246 @@
+#include "xxcnc/motion/HeightMap.h"
+#include "spdlog/spdlog.h"
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace xxcnc {
+namespace motion {
+
+namespace {
+
+/// Catmull-Rom 样条的幂基矩阵：p(t) = [1 t t² t³] · M · [p-1 p0 p1 p2]ᵀ
+constexpr double kCatmullRom[4][4] = {
+    {0.0, 1.0, 0.0, 0.0},
+    {-0.5, 0.0, 0.5, 0.0},
+    {1.0, -2.5, 2.0, -0.5},
+    {-0.5, 1.5, -1.5, 0.5},
+};
+
+/// CSV 坐标归入同一网格线的相对容差（相对于网格间距）
+constexpr double kGridTolerance = 1e-6;
+
+/**
+ * @brief 从一组坐标中提取等间距的网格线
+ * @param values 坐标（会被排序）
+ * @param origin 输出的第一条网格线坐标
+ * @param spacing 输出的网格间距
+ * @return 网格线数，不等间距时返回0
+ */
+size_t extractGridLines(std::vector<double> values, double& origin, double& spacing)
+{
+    std::sort(values.begin(), values.end());
+    const double span = values.back() - values.front();
+    std::vector<double> lines;
+    for (double value : values) {
+        if (lines.empty() || value - lines.back() > kGridTolerance * std::max(span, 1.0)) {
+            lines.push_back(value);
+        }
+    }
+    if (lines.size() < 2) {
+        return 0;
+    }
+
+    origin = lines.front();
+    spacing = span / static_cast<double>(lines.size() - 1);
+    for (size_t i = 0; i < lines.size(); ++i) {
+        if (std::abs(lines[i] - (origin + spacing * static_cast<double>(i))) > kGridTolerance * spacing) {
+            return 0;
+        }
+    }
+    return lines.size();
+}
+
+/**
+ * @brief 将坐标映射为网格线索引
+ * @return 索引，不在网格线上时返回-1
+ */
+long gridIndex(double value, double origin, double spacing, size_t count)
+{
+    const double index = std::round((value - origin) / spacing);
+    if (index < 0.0 || index >= static_cast<double>(count) ||
+        std::abs(value - (origin + spacing * index)) > kGridTolerance * spacing) {
+        return -1;
+    }
+    return static_cast<long>(index);
+}
+
+} // namespace
+
+bool HeightMap::setGrid(double originX, double originY, double spacingX, double spacingY, size_t columns,
+                        size_t rows, const std::vector<double>& heights, HeightMapInterpolation interpolation)
+{
+    if (columns < 2 || rows < 2 || heights.size() != columns * rows || !(spacingX > 0.0) || !(spacingY > 0.0) ||
+        !std::isfinite(spacingX) || !std::isfinite(spacingY) || !std::isfinite(originX) || !std::isfinite(originY)) {
+        return false;
+    }
+    for (double height : heights) {
+        if (!std::isfinite(height)) {
+            return false;
+        }
+    }
+
+    // 网格外侧的节点按线性外推，保证平面在边界单元上也被精确重现
+    auto node = [&](long column, long row) {
+        auto at = [&](long c, long r) { return heights[static_cast<size_t>(r) * columns + static_cast<size_t>(c)]; };
+        const long lastColumn = static_cast<long>(columns) - 1;
+        const long lastRow = static_cast<long>(rows) - 1;
+        auto inRow = [&](long r) {
+            if (column < 0) {
+                return 2.0 * at(0, r) - at(1, r);
+            }
+            if (column > lastColumn) {
+                return 2.0 * at(lastColumn, r) - at(lastColumn - 1, r);
+            }
+            return at(column, r);
+        };
+        if (row < 0) {
+            return 2.0 * inRow(0) - inRow(1);
+        }
+        if (row > lastRow) {
+            return 2.0 * inRow(lastRow) - inRow(lastRow - 1);
+        }
+        return inRow(row);
+    };
+
+    const size_t cellColumns = columns - 1;
+    const size_t cellRows = rows - 1;
+    std::vector<double> coefficients(cellColumns * cellRows * kCoefficients, 0.0);
+    for (size_t cy = 0; cy < cellRows; ++cy) {
+        for (size_t cx = 0; cx < cellColumns; ++cx) {
+            // g[i][j]：X 方向第 i 个、Y 方向第 j 个邻近节点，i/j = 1 为单元左下角
+            double g[4][4];
+            for (long i = 0; i < 4; ++i) {
+                for (long j = 0; j < 4; ++j) {
+                    g[i][j] = node(static_cast<long>(cx) - 1 + i, static_cast<long>(cy) - 1 + j);
+                }
+            }
+
+            double* a = &coefficients[(cy * cellColumns + cx) * kCoefficients];
+            if (interpolation == HeightMapInterpolation::Bilinear) {
+                a[0] = g[1][1];
+                a[1] = g[1][2] - g[1][1];
+                a[4] = g[2][1] - g[1][1];
+                a[5] = g[2][2] - g[2][1] - g[1][2] + g[1][1];
+                continue;
+            }
+
+            // A = M · G · Mᵀ
+            for (size_t p = 0; p < 4; ++p) {
+                for (size_t q = 0; q < 4; ++q) {
+                    double sum = 0.0;
+                    for (size_t i = 0; i < 4; ++i) {
+                        for (size_t j = 0; j < 4; ++j) {
+                            sum += kCatmullRom[p][i] * g[i][j] * kCatmullRom[q][j];
+                        }
+                    }
+                    a[p * 4 + q] = sum;
+                }
+            }
+        }
+    }
+
+    originX_ = originX;
+    originY_ = originY;
+    inverseSpacingX_ = 1.0 / spacingX;
+    inverseSpacingY_ = 1.0 / spacingY;
+    maxCellX_ = static_cast<double>(cellColumns);
+    maxCellY_ = static_cast<double>(cellRows);
+    columns_ = columns;
+    rows_ = rows;
+    cellColumns_ = cellColumns;
+    cellRows_ = cellRows;
+    interpolation_ = interpolation;
+    coefficients_ = std::move(coefficients);
+    return true;
+}
+
+bool HeightMap::loadFromCsv(const std::string& filename, HeightMapInterpolation interpolation)
+{
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        spdlog::error("无法打开高度图文件: {}", filename);
+        return false;
+    }
+
+    std::vector<double> xs;
+    std::vector<double> ys;
+    std::vector<double> zs;
+    std::string line;
+    int lineNumber = 0;
+    bool firstRow = true;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        const size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        std::replace(line.begin(), line.end(), ',', ' ');
+
+        std::istringstream stream(line);
+        std::string rest;
+        double x = 0.0;
+        double y = 0.0;
+        double z = 0.0;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        if (!(stream >> x >> y >> z) || (stream >> rest)) {
+            // 第一行允许是表头
+            if (firstRow) {
+                firstRow = false;
+                continue;
+            }
+            spdlog::error("高度图 {} 第 {} 行格式错误", filename, lineNumber);
+            return false;
+        }
+        firstRow = false;
+        xs.push_back(x);
+        ys.push_back(y);
+        zs.push_back(z);
+    }
+
+    if (xs.size() < 4) {
+        spdlog::error("高度图 {} 至少需要 2x2 个探测点", filename);
+        return false;
+    }
+
+    double originX = 0.0;
+    double originY = 0.0;
+    double spacingX = 0.0;
+    double spacingY = 0.0;
+    const size_t columns = extractGridLines(xs, originX, spacingX);
+    const size_t rows = extractGridLines(ys, originY, spacingY);
+    if (columns == 0 || rows == 0 || columns * rows != xs.size()) {
+        spdlog::error("高度图 {} 的探测点不构成等间距的完整网格", filename);
+        return false;
+    }
+
+    std::vector<double> heights(columns * rows, 0.0);
+    std::vector<bool> filled(columns * rows, false);
+    for (size_t i = 0; i < xs.size(); ++i) {
+        const long column = gridIndex(xs[i], originX, spacingX, columns);
+        const long row = gridIndex(ys[i], originY, spacingY, rows);
+        if (column < 0 || row < 0) {
+            spdlog::error("高度图 {} 的探测点不构成等间距的完整网格", filename);
+            return false;
+        }
+        const size_t index = static_cast<size_t>(row) * columns + static_cast<size_t>(column);
+        if (filled[index]) {
+            spdlog::error("高度图 {} 存在重复的探测点", filename);
+            return false;
+        }
+        heights[index] = zs[i];
+        filled[index] = true;
+    }
+
+    if (!setGrid(originX, originY, spacingX, spacingY, columns, rows, heights, interpolation)) {
+        spdlog::error("高度图 {} 的数据无效", filename);
+        return false;
+    }
+    spdlog::info("已加载高度图 {}: {}x{} 个点", filename, columns, rows);
+    return true;
+}
+
+} // namespace motion
+} // namespace xxcnc
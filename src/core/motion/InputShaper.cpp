@@ -0,0 +1,123 @@
+#include "xxcnc/motion/InputShaper.h"
+#include <algorithm>
+#include <cmath>
+
+namespace xxcnc {
+namespace motion {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+/// EI 整形器容许的残余振动比例
+constexpr double kEiVibrationTolerance = 0.05;
+constexpr size_t kHistoryMask = InputShaper::kHistorySize - 1;
+
+static_assert((InputShaper::kHistorySize & kHistoryMask) == 0, "历史缓冲区长度必须为2的幂");
+
+} // namespace
+
+InputShaper::InputShaper()
+{
+    amplitudes_[0] = 1.0;
+    reset(0.0);
+}
+
+bool InputShaper::configure(InputShaperType type, double frequency, double damping, double samplePeriod)
+{
+    if (!(samplePeriod > 0.0) || !std::isfinite(samplePeriod)) {
+        return false;
+    }
+
+    double amplitudes[kMaxImpulses] = {1.0, 0.0, 0.0};
+    double times[kMaxImpulses] = {0.0, 0.0, 0.0};
+    size_t count = 1;
+
+    if (type != InputShaperType::None) {
+        if (!(frequency > 0.0) || !std::isfinite(frequency) || !(damping >= 0.0) || !(damping < 1.0)) {
+            return false;
+        }
+
+        // 有阻尼振动周期 Td 与相邻半周期的幅值衰减比 K
+        const double dampedFactor = std::sqrt(1.0 - damping * damping);
+        const double k = std::exp(-damping * kPi / dampedFactor);
+        const double period = 1.0 / (frequency * dampedFactor);
+
+        switch (type) {
+        case InputShaperType::ZV:
+            amplitudes[0] = 1.0;
+            amplitudes[1] = k;
+            times[1] = 0.5 * period;
+            count = 2;
+            break;
+        case InputShaperType::ZVD:
+            amplitudes[0] = 1.0;
+            amplitudes[1] = 2.0 * k;
+            amplitudes[2] = k * k;
+            times[1] = 0.5 * period;
+            times[2] = period;
+            count = 3;
+            break;
+        case InputShaperType::EI:
+            amplitudes[0] = 0.25 * (1.0 + kEiVibrationTolerance);
+            amplitudes[1] = 0.5 * (1.0 - kEiVibrationTolerance) * k;
+            amplitudes[2] = amplitudes[0] * k * k;
+            times[1] = 0.5 * period;
+            times[2] = period;
+            count = 3;
+            break;
+        case InputShaperType::None:
+            break;
+        }
+
+        // 线性插值需要延迟点之后的一个历史点
+        if (times[count - 1] / samplePeriod + 1.0 >= static_cast<double>(kHistorySize)) {
+            return false;
+        }
+    }
+
+    double sum = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        sum += amplitudes[i];
+    }
+
+    for (size_t i = 0; i < kMaxImpulses; ++i) {
+        const double delay = times[i] / samplePeriod;
+        const double whole = std::floor(delay);
+        amplitudes_[i] = i < count ? amplitudes[i] / sum : 0.0;
+        delays_[i] = static_cast<size_t>(whole);
+        fractions_[i] = delay - whole;
+    }
+    impulseCount_ = count;
+    settleSamples_ = static_cast<size_t>(std::ceil(times[count - 1] / samplePeriod));
+    type_ = type;
+    frequency_ = type == InputShaperType::None ? 0.0 : frequency;
+    damping_ = type == InputShaperType::None ? 0.0 : damping;
+    duration_ = times[count - 1];
+    return true;
+}
+
+void InputShaper::reset(double value)
+{
+    std::fill(history_, history_ + kHistorySize, value);
+    head_ = 0;
+    stableCount_ = kHistorySize;
+}
+
+double InputShaper::process(double input)
+{
+    const double previous = history_[head_];
+    head_ = (head_ + 1) & kHistoryMask;
+    history_[head_] = input;
+    stableCount_ = input == previous ? std::min(stableCount_ + 1, kHistorySize) : 0;
+
+    double output = 0.0;
+    for (size_t i = 0; i < impulseCount_; ++i) {
+        const double newer = history_[(head_ - delays_[i]) & kHistoryMask];
+        const double older = history_[(head_ - delays_[i] - 1) & kHistoryMask];
+        output += amplitudes_[i] * (newer + fractions_[i] * (older - newer));
+    }
+    return output;
+}
+
+} // namespace motion
+} // namespace xxcnc
@@ -0,0 +1,174 @@
+#include "xxcnc/motion/JerkLimitedTrajectory.h"
+#include <array>
+
+namespace xxcnc {
+namespace motion {
+
+namespace {
+
+/// 终点位置的求解容差 (mm)
+constexpr double kPositionTolerance = 1e-10;
+/// 峰值速度二分法的最大迭代次数
+constexpr int kMaxIterations = 100;
+
+bool isValidLimit(double value)
+{
+    return value > 0.0 && std::isfinite(value);
+}
+
+} // namespace
+
+bool JerkLimitedTrajectory::plan(const KinematicState& start, double target, const KinematicLimits& limits)
+{
+    if (!isValidLimit(limits.maxVelocity) || !isValidLimit(limits.maxAcceleration) ||
+        !isValidLimit(limits.maxJerk)) {
+        return false;
+    }
+
+    start_ = start;
+    target_ = target;
+    limits_ = limits;
+    const double vmax = limits.maxVelocity;
+
+    // 以最大速度仍不能到达时加入匀速段
+    const double highEnd = build(vmax, 0.0);
+    if (highEnd <= target) {
+        build(vmax, (target - highEnd) / vmax);
+        return true;
+    }
+    const double lowEnd = build(-vmax, 0.0);
+    if (lowEnd >= target) {
+        build(-vmax, (lowEnd - target) / vmax);
+        return true;
+    }
+
+    // 立即将加速度降到零时到达的速度；峰值速度在 0 与该速度之间时终点位置不一定单调，
+    // 按区间端点选择包含目标的区间再二分
+    const double a0 = start.acceleration;
+    const double vStop = std::clamp(start.velocity + a0 * std::abs(a0) / (2.0 * limits.maxJerk), -vmax, vmax);
+    const std::array<double, 4> knots = {-vmax, std::min(0.0, vStop), std::max(0.0, vStop), vmax};
+    std::array<double, 4> ends = {lowEnd, 0.0, 0.0, highEnd};
+    ends[1] = build(knots[1], 0.0);
+    ends[2] = build(knots[2], 0.0);
+
+    double lo = knots[2];
+    double hi = knots[3];
+    double loEnd = ends[2];
+    if (target < std::min(ends[1], ends[2])) {
+        lo = knots[0];
+        hi = knots[1];
+        loEnd = ends[0];
+    } else if (target <= std::max(ends[1], ends[2])) {
+        lo = knots[1];
+        hi = knots[2];
+        loEnd = ends[1];
+    }
+
+    double vp = hi;
+    for (int i = 0; i < kMaxIterations; ++i) {
+        vp = 0.5 * (lo + hi);
+        const double end = build(vp, 0.0);
+        if (std::abs(end - target) <= kPositionTolerance) {
+            return true;
+        }
+        if ((end < target) == (loEnd < target)) {
+            lo = vp;
+            loEnd = end;
+        } else {
+            hi = vp;
+        }
+    }
+    build(vp, 0.0);
+    return true;
+}
+
+KinematicState JerkLimitedTrajectory::sample(double time) const
+{
+    if (time >= duration_) {
+        KinematicState end;
+        end.position = target_;
+        return end;
+    }
+
+    KinematicState state = start_;
+    double remaining = std::max(time, 0.0);
+    for (size_t i = 0; i < pieceCount_; ++i) {
+        if (remaining <= pieces_[i].duration) {
+            return advance(state, pieces_[i].jerk, remaining);
+        }
+        state = advance(state, pieces_[i].jerk, pieces_[i].duration);
+        remaining -= pieces_[i].duration;
+    }
+    return state;
+}
+
+size_t JerkLimitedTrajectory::velocityChange(double v0, double a0, double v1,
+                                             const KinematicLimits& limits, Piece* pieces)
+{
+    const double amax = limits.maxAcceleration;
+    const double jmax = limits.maxJerk;
+
+    // 在速度变化方向上求解：先将加速度调至峰值，再以最大加加速度降到零
+    const double vStop = v0 + a0 * std::abs(a0) / (2.0 * jmax);
+    const double direction = (v1 >= vStop) ? 1.0 : -1.0;
+    const double a = direction * a0;
+    const double dv = direction * (v1 - v0);
+
+    size_t count = 0;
+    auto addPiece = [&](double duration, double jerk) {
+        if (duration > 0.0) {
+            pieces[count].duration = duration;
+            pieces[count].jerk = jerk;
+            ++count;
+        }
+    };
+
+    double peak = std::sqrt(std::max(0.0, (2.0 * jmax * dv + a * a) * 0.5));
+    if (peak <= amax) {
+        peak = std::max(peak, a);
+        addPiece((peak - a) / jmax, direction * jmax);
+        addPiece(peak / jmax, -direction * jmax);
+        return count;
+    }
+
+    // 峰值受最大加速度限制，中间插入恒加速段
+    const double rampUp = std::abs(amax - a) / jmax;
+    const double rampUpVelocity = 0.5 * (a + amax) * rampUp;
+    const double rampDownVelocity = amax * amax / (2.0 * jmax);
+    addPiece(rampUp, (amax >= a ? 1.0 : -1.0) * direction * jmax);
+    addPiece(std::max(0.0, (dv - rampUpVelocity - rampDownVelocity) / amax), 0.0);
+    addPiece(amax / jmax, -direction * jmax);
+    return count;
+}
+
+KinematicState JerkLimitedTrajectory::advance(const KinematicState& state, double jerk, double time)
+{
+    const double t2 = time * time;
+    KinematicState next;
+    next.position = state.position + state.velocity * time + state.acceleration * t2 * 0.5 + jerk * t2 * time / 6.0;
+    next.velocity = state.velocity + state.acceleration * time + jerk * t2 * 0.5;
+    next.acceleration = state.acceleration + jerk * time;
+    return next;
+}
+
+double JerkLimitedTrajectory::build(double vp, double cruise)
+{
+    pieceCount_ = velocityChange(start_.velocity, start_.acceleration, vp, limits_, pieces_);
+    if (cruise > 0.0) {
+        pieces_[pieceCount_].duration = cruise;
+        pieces_[pieceCount_].jerk = 0.0;
+        ++pieceCount_;
+    }
+    pieceCount_ += velocityChange(vp, 0.0, 0.0, limits_, pieces_ + pieceCount_);
+
+    KinematicState state = start_;
+    duration_ = 0.0;
+    for (size_t i = 0; i < pieceCount_; ++i) {
+        state = advance(state, pieces_[i].jerk, pieces_[i].duration);
+        duration_ += pieces_[i].duration;
+    }
+    return state.position;
+}
+
+} // namespace motion
+} // namespace xxcnc
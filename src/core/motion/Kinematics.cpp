@@ -0,0 +1,233 @@
+#include "xxcnc/motion/Kinematics.h"
+#include <algorithm>
+#include <cmath>
+
+namespace xxcnc {
+namespace motion {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kDegreesToRadians = kPi / 180.0;
+
+const char* const kXYZNames[] = {"X", "Y", "Z"};
+const char* const kTableTableNames[] = {"X", "Y", "Z", "A", "C"};
+
+} // namespace
+
+const char* CoreXYKinematics::getCoordinateName(size_t index) const
+{
+    return index < 3 ? kXYZNames[index] : "";
+}
+
+bool CoreXYKinematics::inverse(const double* const* coordinates, double* const* joints, size_t count) const
+{
+    const double* x = coordinates[0];
+    const double* y = coordinates[1];
+    const double* z = coordinates[2];
+    double* a = joints[0];
+    double* b = joints[1];
+    double* jz = joints[2];
+    for (size_t i = 0; i < count; ++i) {
+        a[i] = x[i] + y[i];
+        b[i] = x[i] - y[i];
+        jz[i] = z[i];
+    }
+    return true;
+}
+
+bool CoreXYKinematics::forward(const double* const* joints, double* const* coordinates, size_t count) const
+{
+    const double* a = joints[0];
+    const double* b = joints[1];
+    const double* jz = joints[2];
+    double* x = coordinates[0];
+    double* y = coordinates[1];
+    double* z = coordinates[2];
+    for (size_t i = 0; i < count; ++i) {
+        x[i] = 0.5 * (a[i] + b[i]);
+        y[i] = 0.5 * (a[i] - b[i]);
+        z[i] = jz[i];
+    }
+    return true;
+}
+
+DeltaKinematics::DeltaKinematics(double armLength, double radius)
+    : armLength_(armLength)
+    , radius_(radius)
+{
+    const double angles[3] = {210.0, 330.0, 90.0};
+    for (size_t i = 0; i < 3; ++i) {
+        towerX_[i] = radius * std::cos(angles[i] * kDegreesToRadians);
+        towerY_[i] = radius * std::sin(angles[i] * kDegreesToRadians);
+    }
+}
+
+const char* DeltaKinematics::getCoordinateName(size_t index) const
+{
+    return index < 3 ? kXYZNames[index] : "";
+}
+
+bool DeltaKinematics::inverse(const double* const* coordinates, double* const* joints, size_t count) const
+{
+    const double* x = coordinates[0];
+    const double* y = coordinates[1];
+    const double* z = coordinates[2];
+    const double arm2 = armLength_ * armLength_;
+
+    // 滑块高度 = 末端高度 + 连杆的竖直投影；投影为负时末端超出连杆可达范围
+    int unreachable = 0;
+    for (size_t tower = 0; tower < 3; ++tower) {
+        const double tx = towerX_[tower];
+        const double ty = towerY_[tower];
+        double* carriage = joints[tower];
+        for (size_t i = 0; i < count; ++i) {
+            const double dx = x[i] - tx;
+            const double dy = y[i] - ty;
+            const double height2 = arm2 - dx * dx - dy * dy;
+            unreachable |= height2 < 0.0;
+            carriage[i] = z[i] + std::sqrt(std::max(height2, 0.0));
+        }
+    }
+    return unreachable == 0;
+}
+
+bool DeltaKinematics::forward(const double* const* joints, double* const* coordinates, size_t count) const
+{
+    const double* c1 = joints[0];
+    const double* c2 = joints[1];
+    const double* c3 = joints[2];
+    double* x = coordinates[0];
+    double* y = coordinates[1];
+    double* z = coordinates[2];
+    const double arm2 = armLength_ * armLength_;
+
+    // 三个等半径球面求交（三边测量），取位于滑块下方的解
+    int invalid = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const double e12x = towerX_[1] - towerX_[0];
+        const double e12y = towerY_[1] - towerY_[0];
+        const double e12z = c2[i] - c1[i];
+        const double d = std::sqrt(e12x * e12x + e12y * e12y + e12z * e12z);
+        const double exX = e12x / d;
+        const double exY = e12y / d;
+        const double exZ = e12z / d;
+
+        const double p13x = towerX_[2] - towerX_[0];
+        const double p13y = towerY_[2] - towerY_[0];
+        const double p13z = c3[i] - c1[i];
+        const double along = exX * p13x + exY * p13y + exZ * p13z;
+        const double eyX0 = p13x - along * exX;
+        const double eyY0 = p13y - along * exY;
+        const double eyZ0 = p13z - along * exZ;
+        const double j = std::sqrt(eyX0 * eyX0 + eyY0 * eyY0 + eyZ0 * eyZ0);
+        const double eyX = eyX0 / j;
+        const double eyY = eyY0 / j;
+        const double eyZ = eyZ0 / j;
+
+        const double ezX = exY * eyZ - exZ * eyY;
+        const double ezY = exZ * eyX - exX * eyZ;
+        const double ezZ = exX * eyY - exY * eyX;
+
+        const double u = 0.5 * d;
+        const double v = (along * along + j * j - 2.0 * along * u) / (2.0 * j);
+        const double w2 = arm2 - u * u - v * v;
+        invalid |= w2 < 0.0;
+        const double w = -std::sqrt(std::max(w2, 0.0));
+
+        x[i] = towerX_[0] + u * exX + v * eyX + w * ezX;
+        y[i] = towerY_[0] + u * exY + v * eyY + w * ezY;
+        z[i] = c1[i] + u * exZ + v * eyZ + w * ezZ;
+    }
+    return invalid == 0;
+}
+
+TableTableKinematics::TableTableKinematics(double pivotX, double pivotY, double pivotZ, double cOffsetY,
+                                           double cOffsetZ)
+    : pivotX_(pivotX)
+    , pivotY_(pivotY)
+    , pivotZ_(pivotZ)
+    , cOffsetY_(cOffsetY)
+    , cOffsetZ_(cOffsetZ)
+{
+}
+
+const char* TableTableKinematics::getCoordinateName(size_t index) const
+{
+    return index < 5 ? kTableTableNames[index] : "";
+}
+
+bool TableTableKinematics::inverse(const double* const* coordinates, double* const* joints, size_t count) const
+{
+    const double* x = coordinates[0];
+    const double* y = coordinates[1];
+    const double* z = coordinates[2];
+    const double* a = coordinates[3];
+    const double* c = coordinates[4];
+    double* mx = joints[0];
+    double* my = joints[1];
+    double* mz = joints[2];
+    double* ma = joints[3];
+    double* mc = joints[4];
+
+    // 机床位置 = pivot + Rx(A) · (cOffset + Rz(C) · (工件点 - pivot - cOffset))
+    for (size_t i = 0; i < count; ++i) {
+        const double sinA = std::sin(a[i] * kDegreesToRadians);
+        const double cosA = std::cos(a[i] * kDegreesToRadians);
+        const double sinC = std::sin(c[i] * kDegreesToRadians);
+        const double cosC = std::cos(c[i] * kDegreesToRadians);
+
+        const double qx = x[i] - pivotX_;
+        const double qy = y[i] - pivotY_ - cOffsetY_;
+        const double qz = z[i] - pivotZ_ - cOffsetZ_;
+        const double rx = cosC * qx - sinC * qy;
+        const double ry = cOffsetY_ + sinC * qx + cosC * qy;
+        const double rz = cOffsetZ_ + qz;
+
+        mx[i] = pivotX_ + rx;
+        my[i] = pivotY_ + cosA * ry - sinA * rz;
+        mz[i] = pivotZ_ + sinA * ry + cosA * rz;
+        ma[i] = a[i];
+        mc[i] = c[i];
+    }
+    return true;
+}
+
+bool TableTableKinematics::forward(const double* const* joints, double* const* coordinates, size_t count) const
+{
+    const double* mx = joints[0];
+    const double* my = joints[1];
+    const double* mz = joints[2];
+    const double* ma = joints[3];
+    const double* mc = joints[4];
+    double* x = coordinates[0];
+    double* y = coordinates[1];
+    double* z = coordinates[2];
+    double* a = coordinates[3];
+    double* c = coordinates[4];
+
+    // 工件点 = pivot + cOffset + Rz(-C) · (Rx(-A) · (机床位置 - pivot) - cOffset)
+    for (size_t i = 0; i < count; ++i) {
+        const double sinA = std::sin(ma[i] * kDegreesToRadians);
+        const double cosA = std::cos(ma[i] * kDegreesToRadians);
+        const double sinC = std::sin(mc[i] * kDegreesToRadians);
+        const double cosC = std::cos(mc[i] * kDegreesToRadians);
+
+        const double dx = mx[i] - pivotX_;
+        const double dy = my[i] - pivotY_;
+        const double dz = mz[i] - pivotZ_;
+        const double ux = dx;
+        const double uy = cosA * dy + sinA * dz - cOffsetY_;
+        const double uz = -sinA * dy + cosA * dz - cOffsetZ_;
+
+        x[i] = pivotX_ + cosC * ux + sinC * uy;
+        y[i] = pivotY_ + cOffsetY_ - sinC * ux + cosC * uy;
+        z[i] = pivotZ_ + cOffsetZ_ + uz;
+        a[i] = ma[i];
+        c[i] = mc[i];
+    }
+    return true;
+}
+
+} // namespace motion
+} // namespace xxcnc
@@ -6,9 +6,52 @@
 namespace xxcnc {
 namespace motion {
 
+namespace {
+
+/**
+ * @brief 插补坐标名称到坐标索引的映射
+ * @return 坐标索引，非 X/Y/Z 返回-1
+ */
+int pathAxisIndex(const std::string& name)
+{
+    if (name == "X") {
+        return 0;
+    }
+    if (name == "Y") {
+        return 1;
+    }
+    if (name == "Z") {
+        return 2;
+    }
+    return -1;
+}
+
+using PathCoordinates = std::array<double, core::motion::kMaxInterpolationAxes>;
+
+static_assert(Kinematics::kMaxCoordinates == core::motion::kMaxInterpolationAxes,
+              "关节位置与插补坐标共用同一数组类型");
+
+template <size_t N>
+core::motion::PointN<N> toPoint(const PathCoordinates& coordinates)
+{
+    core::motion::PointN<N> point;
+    core::motion::forEachAxis<N>([&](auto i) { point[i] = coordinates[i]; });
+    return point;
+}
+
+template <size_t N>
+PathCoordinates toCoordinates(const core::motion::PointN<N>& point)
+{
+    PathCoordinates coordinates{};
+    core::motion::forEachAxis<N>([&](auto i) { coordinates[i] = point[i]; });
+    return coordinates;
+}
+
+} // namespace
+
 MotionController::MotionController()
     : interpolationEngine_(std::make_unique<core::motion::InterpolationEngine>())
-    , timeBasedInterpolator_(std::make_unique<core::motion::TimeBasedInterpolator>(1)) // 默认1ms插补周期
+    , timeBasedInterpolator_(std::make_unique<core::motion::TimeBasedInterpolator>(1)) // 默认3轴，1ms插补周期
     , isMoving_(false)
     , motionState_(MotionState::Idle)
 {
@@ -19,16 +62,172 @@ bool MotionController::addAxis(const std::string& name, const AxisParameters& pa
     if (axes_.find(name) != axes_.end()) {
         return false;
     }
-    axes_[name] = std::make_shared<Axis>(name, params);
+    auto axis = std::make_shared<Axis>(name, params);
+    axes_[name] = axis;
+    axisList_.push_back(axis.get());
+    axisGroup_.addAxis(axis.get());
+
+    // 在配置时将插补坐标解析为轴指针，X/Y/Z 以外的轴追加为附加插补坐标
+    int pathIndex = pathAxisIndex(name);
+    if (pathIndex >= 0) {
+        pathAxes_[pathIndex] = axis.get();
+    } else if (directAxisCount_ < kMaxPathAxisCount) {
+        pathAxes_[directAxisCount_++] = axis.get();
+        if (!kinematics_) {
+            selectInterpolator(directAxisCount_);
+        }
+    } else {
+        spdlog::warn("轴 {} 超出最大插补轴数 {}，不参与插补", name, kMaxPathAxisCount);
+    }
+    if (axisList_.size() > Snapshot::kMaxAxes) {
+        spdlog::warn("轴 {} 超出状态快照最大轴数 {}，不出现在快照中", name, Snapshot::kMaxAxes);
+    }
+    updateInterpolatedAxes();
+    publishSnapshot();
     return true;
 }
 
+void MotionController::selectInterpolator(size_t axisCount)
+{
+    int periodMs = getInterpolationPeriod();
+    int coarsePeriodMs = getCoarseInterpolationPeriod();
+    switch (axisCount) {
+    case 3:
+        timeBasedInterpolator_ = std::make_unique<core::motion::BasicTimeBasedInterpolator<3>>(periodMs, coarsePeriodMs);
+        break;
+    case 4:
+        timeBasedInterpolator_ = std::make_unique<core::motion::BasicTimeBasedInterpolator<4>>(periodMs, coarsePeriodMs);
+        break;
+    case 5:
+        timeBasedInterpolator_ = std::make_unique<core::motion::BasicTimeBasedInterpolator<5>>(periodMs, coarsePeriodMs);
+        break;
+    case 6:
+        timeBasedInterpolator_ = std::make_unique<core::motion::BasicTimeBasedInterpolator<6>>(periodMs, coarsePeriodMs);
+        break;
+    case 7:
+        timeBasedInterpolator_ = std::make_unique<core::motion::BasicTimeBasedInterpolator<7>>(periodMs, coarsePeriodMs);
+        break;
+    case 8:
+        timeBasedInterpolator_ = std::make_unique<core::motion::BasicTimeBasedInterpolator<8>>(periodMs, coarsePeriodMs);
+        break;
+    case 9:
+        timeBasedInterpolator_ = std::make_unique<core::motion::BasicTimeBasedInterpolator<9>>(periodMs, coarsePeriodMs);
+        break;
+    default:
+        throw std::invalid_argument("插补轴数超出范围");
+    }
+    pathAxisCount_ = axisCount;
+}
+
+void MotionController::updateInterpolatedAxes()
+{
+    interpolatedAxes_.assign(axisList_.size(), false);
+    for (size_t i = 0; i < axisList_.size(); ++i) {
+        const Axis* axis = axisList_[i];
+        if (kinematics_) {
+            interpolatedAxes_[i] = std::find(jointAxes_.begin(), jointAxes_.begin() + jointCount_, axis) !=
+                                   jointAxes_.begin() + jointCount_;
+        } else {
+            interpolatedAxes_[i] = std::find(pathAxes_.begin(), pathAxes_.begin() + pathAxisCount_, axis) !=
+                                   pathAxes_.begin() + pathAxisCount_;
+        }
+    }
+}
+
 std::shared_ptr<Axis> MotionController::getAxis(const std::string& name)
 {
     auto it = axes_.find(name);
     return (it != axes_.end()) ? it->second : nullptr;
 }
 
+int MotionController::getAxisIndex(const std::string& name) const
+{
+    for (size_t i = 0; i < axisList_.size(); ++i) {
+        if (axisList_[i]->getName() == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+Axis* MotionController::getAxisAt(size_t index) const
+{
+    return (index < axisList_.size()) ? axisList_[index] : nullptr;
+}
+
+size_t MotionController::getAxisCount() const
+{
+    return axisList_.size();
+}
+
+size_t MotionController::getPathAxisCount() const
+{
+    return pathAxisCount_;
+}
+
+bool MotionController::setKinematics(std::shared_ptr<const Kinematics> kinematics,
+                                     const std::vector<std::string>& jointAxes)
+{
+    if (isMoving_ || getInterpolationQueueSize() > 0) {
+        return false;
+    }
+
+    if (!kinematics) {
+        kinematics_.reset();
+        jointCount_ = 0;
+        selectInterpolator(directAxisCount_);
+        updateInterpolatedAxes();
+        return true;
+    }
+
+    const size_t coordinateCount = kinematics->getCoordinateCount();
+    if (coordinateCount < kPathAxisCount || coordinateCount > kMaxPathAxisCount ||
+        kinematics->getJointCount() > Kinematics::kMaxCoordinates ||
+        jointAxes.size() != kinematics->getJointCount()) {
+        spdlog::warn("运动学 {} 的坐标数或关节数与配置不符", kinematics->getName());
+        return false;
+    }
+
+    // 在配置时将关节解析为轴指针
+    std::array<Axis*, Kinematics::kMaxCoordinates> axes{};
+    for (size_t j = 0; j < jointAxes.size(); ++j) {
+        auto it = axes_.find(jointAxes[j]);
+        if (it == axes_.end()) {
+            spdlog::warn("运动学 {} 的关节轴 {} 不存在", kinematics->getName(), jointAxes[j]);
+            return false;
+        }
+        axes[j] = it->second.get();
+    }
+
+    kinematics_ = std::move(kinematics);
+    jointAxes_ = axes;
+    jointCount_ = jointAxes.size();
+    selectInterpolator(coordinateCount);
+    updateInterpolatedAxes();
+    spdlog::info("运动学设置为 {}，插补坐标数 {}", kinematics_->getName(), coordinateCount);
+    return true;
+}
+
+const Kinematics* MotionController::getKinematics() const
+{
+    return kinematics_.get();
+}
+
+bool MotionController::setHeightMap(std::shared_ptr<const HeightMap> heightMap)
+{
+    if (isMoving_ || getInterpolationQueueSize() > 0) {
+        return false;
+    }
+
+    heightMap_ = std::move(heightMap);
+    return true;
+}
+
+const HeightMap* MotionController::getHeightMap() const
+{
+    return heightMap_.get();
+}
+
 bool MotionController::enableAllAxes()
 {
     bool success = true;
@@ -49,71 +248,159 @@ bool MotionController::disableAllAxes()
         }
     }
     isMoving_ = false;
+    motionState_ = MotionState::Idle;
     return success;
 }
 
 bool MotionController::moveLinear(const std::map<std::string, double>& targetPositions, double feedRate)
 {
-    if (isMoving_ || targetPositions.empty()) {
+    if (targetPositions.empty()) {
         return false;
     }
 
-    // 检查所有目标轴是否存在且处于空闲状态
+    // 检查所有目标轴是否存在且可运动；设置运动学后目标为运动学坐标，关节状态在追加时检查
     for (const auto& [name, position] : targetPositions) {
+        if (kinematics_) {
+            if (findPathAxis(name) < 0) {
+                return false;
+            }
+            continue;
+        }
         auto axis = getAxis(name);
-        if (!axis || axis->getState() != AxisState::IDLE) {
+        if (!axis || axis->getState() == AxisState::DISABLED || axis->getState() == AxisState::ERROR) {
             return false;
         }
     }
 
-    // 创建起点和终点
-    core::motion::Point start, end;
-    auto xAxis = axes_.find("X");
-    auto yAxis = axes_.find("Y");
-    auto zAxis = axes_.find("Z");
-
-    if (xAxis != axes_.end()) {
-        start.x = xAxis->second->getCurrentPosition();
-        end.x = targetPositions.count("X") ? targetPositions.at("X") : start.x;
-    }
-    if (yAxis != axes_.end()) {
-        start.y = yAxis->second->getCurrentPosition();
-        end.y = targetPositions.count("Y") ? targetPositions.at("Y") : start.y;
+    // 未指定的轴保持起点坐标
+    PathPosition target = getPathStart();
+    for (const auto& [name, position] : targetPositions) {
+        int index = findPathAxis(name);
+        if (index >= 0) {
+            target[index] = position;
+        }
     }
-    if (zAxis != axes_.end()) {
-        start.z = zAxis->second->getCurrentPosition();
-        end.z = targetPositions.count("Z") ? targetPositions.at("Z") : start.z;
+
+    return appendPathLinear(target, feedRate);
+}
+
+bool MotionController::moveLinear(const core::motion::Point& target, double feedRate, int lineNumber)
+{
+    PathPosition end = getPathStart();
+    for (size_t i = 0; i < kPathAxisCount; ++i) {
+        end[i] = target[i];
     }
+    return appendPathLinear(end, feedRate, lineNumber);
+}
+
+bool MotionController::appendPathLinear(const PathPosition& target, double feedRate, int lineNumber)
+{
+    serviceFault();
+    PathPosition start = getPathStart();
+    PathPosition end = start;
 
-    // 设置插补参数
+    // 设置插补参数，取参与插补各轴的最小限制
     core::motion::InterpolationEngine::InterpolationParams params;
     params.feedRate = feedRate;
-    params.maxVelocity = std::min({1e6,
-        (xAxis != axes_.end()) ? xAxis->second->getMaxVelocity() : 1e6,
-        (yAxis != axes_.end()) ? yAxis->second->getMaxVelocity() : 1e6,
-        (zAxis != axes_.end()) ? zAxis->second->getMaxVelocity() : 1e6});
-    params.acceleration = std::min({1e6,
-        (xAxis != axes_.end()) ? xAxis->second->getMaxAcceleration() : 1e6,
-        (yAxis != axes_.end()) ? yAxis->second->getMaxAcceleration() : 1e6,
-        (zAxis != axes_.end()) ? zAxis->second->getMaxAcceleration() : 1e6});
+    params.maxVelocity = 1e6;
+    params.acceleration = 1e6;
+    params.jerk = 1e9;
+    auto applyAxisLimits = [&params](const Axis* axis, bool moving) {
+        // 只有需要移动的轴必须处于可运动状态
+        if (moving && (axis->getState() == AxisState::DISABLED || axis->getState() == AxisState::ERROR)) {
+            return false;
+        }
+        params.maxVelocity = std::min(params.maxVelocity, axis->getMaxVelocity());
+        params.acceleration = std::min(params.acceleration, axis->getMaxAcceleration());
+        params.jerk = std::min(params.jerk, axis->getMaxJerk());
+        return true;
+    };
+
+    if (kinematics_) {
+        // 关节与坐标耦合，任一坐标移动时所有关节都可能移动
+        bool moving = false;
+        for (size_t i = 0; i < pathAxisCount_; ++i) {
+            moving = moving || target[i] != start[i];
+            end[i] = target[i];
+        }
+        for (size_t j = 0; j < jointCount_; ++j) {
+            if (!applyAxisLimits(jointAxes_[j], moving)) {
+                return false;
+            }
+        }
+        PathPosition joints{};
+        if (!toJoints(end, joints)) {
+            spdlog::warn("目标位置超出运动学 {} 的可达范围", kinematics_->getName());
+            return false;
+        }
+    } else {
+        for (size_t i = 0; i < pathAxisCount_; ++i) {
+            Axis* axis = pathAxes_[i];
+            if (!axis) {
+                continue;
+            }
+            if (!applyAxisLimits(axis, target[i] != start[i])) {
+                return false;
+            }
+            end[i] = target[i];
+        }
+    }
     params.deceleration = params.acceleration;
 
-    // 使用基于时间的插补器规划路径
-    if (!timeBasedInterpolator_->planLinearPath(start, end, params)) {
-        return false;
+    // 追加到插补器队尾，运动中追加的段将连续执行
+    return withInterpolator([&](auto& interpolator) {
+        using PointType = typename std::decay_t<decltype(interpolator)>::PointType;
+        constexpr size_t N = PointType::kAxes;
+        return interpolator.planLinearPath(toPoint<N>(start), toPoint<N>(end), params, lineNumber);
+    });
+}
+
+MotionController::PathPosition MotionController::getPathStart() const
+{
+    // 起点为队尾位置：运动中或已有待执行段时接续上一段终点，否则取各轴当前位置。
+    // 运动中清除轨迹后队尾仍是被清除程序的终点，此时也取各轴当前位置
+    if (isMoving_ || getInterpolationQueueSize() > 0) {
+        bool hasTail = false;
+        PathPosition tail = withInterpolator([&](const auto& interpolator) {
+            hasTail = interpolator.hasTailPosition();
+            return toCoordinates(interpolator.getTailPosition());
+        });
+        if (hasTail) {
+            return tail;
+        }
     }
 
-    // 启动各轴运动
-    for (const auto& [name, position] : targetPositions) {
-        auto axis = getAxis(name);
-        if (!axis->moveTo(position, params.maxVelocity)) {
-            emergencyStop();
-            return false;
+    return currentPathPosition();
+}
+
+MotionController::PathPosition MotionController::currentPathPosition() const
+{
+    PathPosition position{};
+    if (kinematics_) {
+        PathPosition joints{};
+        const double* jointColumns[Kinematics::kMaxCoordinates];
+        double* coordinateColumns[Kinematics::kMaxCoordinates];
+        for (size_t j = 0; j < jointCount_; ++j) {
+            joints[j] = jointAxes_[j]->getCurrentPosition();
+            jointColumns[j] = &joints[j];
+        }
+        for (size_t i = 0; i < pathAxisCount_; ++i) {
+            coordinateColumns[i] = &position[i];
+        }
+        kinematics_->forward(jointColumns, coordinateColumns, 1);
+    } else {
+        for (size_t i = 0; i < pathAxisCount_; ++i) {
+            if (pathAxes_[i]) {
+                position[i] = pathAxes_[i]->getCurrentPosition();
+            }
         }
     }
 
-    isMoving_ = true;
-    return true;
+    // 轴位置包含表面高度补偿，编程坐标不包含
+    if (heightMap_) {
+        position[2] -= heightMap_->heightAt(position[0], position[1]);
+    }
+    return position;
 }
 
 bool MotionController::emergencyStop()
@@ -121,10 +408,11 @@ bool MotionController::emergencyStop()
     bool success = true;
     
     spdlog::info("执行紧急停止");
+    serviceFault();
     
     // 停止时基插补器
     spdlog::info("清空插补器队列");
-    timeBasedInterpolator_->clearQueue();
+    withInterpolator([](auto& interpolator) { interpolator.clearQueue(); });
     
     // 停止所有轴的运动
     for (auto& [name, axis] : axes_) {
@@ -136,53 +424,32 @@ bool MotionController::emergencyStop()
     }
     
     isMoving_ = false;
+    feedHoldRequested_.store(false);
+    resumeRequested_.store(false);
+    motionState_ = MotionState::Idle;
     spdlog::info("紧急停止完成，结果: {}", success ? "成功" : "失败");
     return success;
 }
 
 bool MotionController::startMotion()
 {
-    if (isMoving_ || timeBasedInterpolator_->getQueueSize() == 0) {
+    // 控制循环因故障停止时丢弃剩余的段，不从故障点继续执行
+    serviceFault();
+    if (isMoving_ || getInterpolationQueueSize() == 0) {
         return false;
     }
 
-    // 获取第一个插补点并启动运动
-    core::motion::Point nextPoint;
-    if (!timeBasedInterpolator_->getNextPoint(nextPoint)) {
-        return false;
+    // 以各轴当前位置填满整形历史，整形器在控制循环开始运行前只由命令线程访问
+    const PathPosition position = currentPathPosition();
+    for (size_t i = 0; i < pathAxisCount_; ++i) {
+        shapers_[i].reset(position[i]);
+        lastPathCommand_[i] = position[i];
     }
 
-    // 更新各轴目标位置
-    std::map<std::string, double> targetPositions;
-    
-    auto xAxis = axes_.find("X");
-    if (xAxis != axes_.end()) {
-        targetPositions["X"] = nextPoint.x;
-    }
-    
-    auto yAxis = axes_.find("Y");
-    if (yAxis != axes_.end()) {
-        targetPositions["Y"] = nextPoint.y;
-    }
-    
-    auto zAxis = axes_.find("Z");
-    if (zAxis != axes_.end()) {
-        targetPositions["Z"] = nextPoint.z;
-    }
-    
-    // 启动各轴运动
-    for (const auto& [name, position] : targetPositions) {
-        auto axis = getAxis(name);
-        double maxVelocity = axis->getMaxVelocity();
-        if (!axis->moveTo(position, maxVelocity)) {
-            emergencyStop();
-            return false;
-        }
-    }
-
-    // 发送轨迹点更新事件
-    emit_trajectory_point(nextPoint);
-
+    // 插补点只在 update() 中读取，保证插补器只有一个消费者（实时控制循环）
+    feedHoldRequested_.store(false);
+    resumeRequested_.store(false);
+    motionState_ = MotionState::Moving;
     isMoving_ = true;
     return true;
 }
@@ -196,16 +463,13 @@ void MotionController::clearTrajectory() {
         spdlog::info("当前运动状态: {}", static_cast<int>(currentState));
         
         // 清除插补器中的轨迹
-        if (timeBasedInterpolator_) {
-            spdlog::info("清除插补器中的轨迹");
-            timeBasedInterpolator_->clearQueue();
-            spdlog::info("插补器轨迹已清除");
-        } else {
-            spdlog::warn("插补器未初始化，无法清除轨迹");
-        }
+        spdlog::info("清除插补器中的轨迹");
+        withInterpolator([](auto& interpolator) { interpolator.clearQueue(); });
+        spdlog::info("插补器轨迹已清除");
         
         // 更新运动状态
-        if (currentState == MotionState::Moving || currentState == MotionState::Interpolating) {
+        if (currentState == MotionState::Moving || currentState == MotionState::Interpolating ||
+            currentState == MotionState::Holding || currentState == MotionState::Held) {
             spdlog::info("将运动状态从 {} 更新为 Idle", static_cast<int>(currentState));
             setMotionState(MotionState::Idle);
         }
@@ -228,87 +492,305 @@ void MotionController::clearTrajectory() {
 
 void MotionController::update(double deltaTime)
 {
-    if (!isMoving_) {
+    updateMotion(deltaTime);
+
+    // 每个周期末发布一次完整快照，读取方不再逐轴读取原子变量
+    publishSnapshot();
+}
+
+MotionController::Snapshot MotionController::getSnapshot() const
+{
+    return snapshot_.read();
+}
+
+void MotionController::publishSnapshot()
+{
+    Snapshot snapshot;
+    snapshot.tick = ++snapshotTick_;
+    snapshot.axisCount = std::min(axisList_.size(), Snapshot::kMaxAxes);
+    for (size_t i = 0; i < snapshot.axisCount; ++i) {
+        snapshot.positions[i] = axisList_[i]->getCurrentPosition();
+        snapshot.velocities[i] = axisList_[i]->getCurrentVelocity();
+        snapshot.axisStates[i] = axisList_[i]->getState();
+    }
+    snapshot.motionState = motionState_;
+    snapshot.moving = isMoving_;
+    withInterpolator([&](const auto& interpolator) {
+        snapshot.progress = interpolator.getProgress();
+        snapshot.lineNumber = interpolator.getCurrentLineNumber();
+        snapshot.interpolationFinished = interpolator.isFinished();
+    });
+    snapshot_.publish(snapshot);
+}
+
+void MotionController::updateMotion(double deltaTime)
+{
+    const bool moving = isMoving_;
+    if (moving) {
+        updatePath(deltaTime);
+    }
+
+    // 不由插补器下发指令的轴（不参与插补的轴，以及未执行轨迹时的所有轴）
+    // 按各自的点到点、速度或回零指令运行，速度运动的轴批量积分
+    axisGroup_.update(deltaTime, moving ? &interpolatedAxes_ : nullptr);
+}
+
+void MotionController::updatePath(double deltaTime)
+{
+    // 在周期开始时处理进给保持请求，保证响应延迟不超过一个周期
+    processFeedHoldRequests();
+
+    // 每个周期取一个插补点作为各轴位置指令
+    bool commanded = withInterpolator([&](auto& interpolator) {
+        using PointType = typename std::decay_t<decltype(interpolator)>::PointType;
+        PointType nextPoint;
+        if (!interpolator.getNextPoint(nextPoint)) {
+            // 插补已结束，保持终点继续输入，直到整形输出到达终点
+            return shapersSettled() ||
+                   commandAxes(toPoint<PointType::kAxes>(lastPathCommand_), deltaTime);
+        }
+        if (!commandAxes(nextPoint, deltaTime)) {
+            return false;
+        }
+
+        // 发送轨迹点更新事件
+        emit_trajectory_point(core::motion::Point(nextPoint[0], nextPoint[1], nextPoint[2]));
+        return true;
+    });
+    if (!commanded) {
+        stopOnFault();
         return;
     }
 
-    // 检查各轴状态
-    bool allIdle = true;
-    for (auto& [name, axis] : axes_) {
-        axis->update(deltaTime);
-        if (axis->getState() == AxisState::MOVING) {
-            allIdle = false;
+    if (motionState_ == MotionState::Holding &&
+        withInterpolator([](const auto& interpolator) { return interpolator.getFeedHoldState(); }) ==
+            core::motion::FeedHoldState::Held) {
+        motionState_ = MotionState::Held;
+    }
+
+    if (isInterpolationFinished() && shapersSettled()) {
+        for (Axis* axis : axisList_) {
+            axis->stop(true);
         }
+        // 进给保持减速未完成时队列也可能已经执行完，运动结束时一并结束保持状态
+        motionState_ = MotionState::Idle;
+        isMoving_ = false;
+    }
+}
+
+void MotionController::stopOnFault()
+{
+    // 控制循环线程中只停止各轴并上报故障，日志和清空插补队列由非实时线程在 serviceFault() 中完成
+    for (Axis* axis : axisList_) {
+        axis->stop(true);
     }
+    feedHoldRequested_.store(false);
+    resumeRequested_.store(false);
+    motionState_ = MotionState::Error;
+    faultPending_.store(true);
+    isMoving_ = false;
+}
 
-    // 如果所有轴都空闲，但插补还未完成，则获取下一个插补点并移动
-    if (allIdle && !timeBasedInterpolator_->isFinished()) {
-        core::motion::Point nextPoint;
-        if (timeBasedInterpolator_->getNextPoint(nextPoint)) {
-            // 更新各轴目标位置
-            std::map<std::string, double> targetPositions;
-            
-            auto xAxis = axes_.find("X");
-            if (xAxis != axes_.end()) {
-                targetPositions["X"] = nextPoint.x;
-            }
-            
-            auto yAxis = axes_.find("Y");
-            if (yAxis != axes_.end()) {
-                targetPositions["Y"] = nextPoint.y;
-            }
-            
-            auto zAxis = axes_.find("Z");
-            if (zAxis != axes_.end()) {
-                targetPositions["Z"] = nextPoint.z;
-            }
-            
-            // 启动各轴运动
-            for (const auto& [name, position] : targetPositions) {
-                auto axis = getAxis(name);
-                // 使用较高的速度，因为这是1ms周期内的短距离移动
-                double maxVelocity = axis->getMaxVelocity();
-                if (!axis->moveTo(position, maxVelocity)) {
-                    emergencyStop();
-                    return;
-                }
-            }
-            
-            // 发送轨迹点更新事件
-            emit_trajectory_point(nextPoint);
-            
-            allIdle = false;
+bool MotionController::serviceFault()
+{
+    if (!faultPending_.exchange(false)) {
+        return false;
+    }
+
+    spdlog::error("插补点下发失败（轴被禁用、超出软限位、超出最大速度或超出运动学可达范围），已停止运动");
+    withInterpolator([](auto& interpolator) { interpolator.clearQueue(); });
+    return true;
+}
+
+bool MotionController::feedHold()
+{
+    if (!isMoving_ || motionState_ == MotionState::Holding || motionState_ == MotionState::Held) {
+        return false;
+    }
+    spdlog::info("请求进给保持");
+
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    feedHoldRequestTimeNs_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+    resumeRequested_.store(false);
+    feedHoldRequested_.store(true);
+    return true;
+}
+
+bool MotionController::resume()
+{
+    if (!isMoving_ || (motionState_ != MotionState::Holding && motionState_ != MotionState::Held)) {
+        return false;
+    }
+
+    spdlog::info("请求从进给保持点恢复运行");
+    feedHoldRequested_.store(false);
+    resumeRequested_.store(true);
+    return true;
+}
+
+std::chrono::microseconds MotionController::getLastFeedHoldLatency() const
+{
+    return std::chrono::microseconds(lastFeedHoldLatencyUs_.load());
+}
+
+void MotionController::processFeedHoldRequests()
+{
+    if (feedHoldRequested_.exchange(false)) {
+        withInterpolator([](auto& interpolator) { interpolator.beginFeedHold(); });
+        motionState_ = MotionState::Holding;
+
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        int64_t latencyNs = std::chrono::duration_cast<std::chrono::nanoseconds>(now).count() -
+                            feedHoldRequestTimeNs_.load();
+        lastFeedHoldLatencyUs_.store(latencyNs / 1000);
+    }
+
+    if (resumeRequested_.exchange(false)) {
+        withInterpolator([](auto& interpolator) { interpolator.resumeFromHold(); });
+        motionState_ = MotionState::Moving;
+    }
+}
+
+template <size_t N>
+bool MotionController::commandAxes(const core::motion::PointN<N>& point, double deltaTime)
+{
+    PathPosition shaped{};
+    core::motion::forEachAxis<N>([&](auto i) {
+        lastPathCommand_[i] = point[i];
+        shaped[i] = shapers_[i].process(point[i]);
+    });
+    if (heightMap_) {
+        shaped[2] += heightMap_->heightAt(shaped[0], shaped[1]);
+    }
+    if (kinematics_) {
+        return commandJoints(shaped, deltaTime);
+    }
+
+    bool success = true;
+    core::motion::forEachAxis<N>([&](auto i) {
+        Axis* axis = pathAxes_[i];
+        if (success && axis && !axis->followPosition(shaped[i], deltaTime)) {
+            success = false;
         }
+    });
+
+    return success;
+}
+
+bool MotionController::commandJoints(const PathPosition& coordinates, double deltaTime)
+{
+    PathPosition joints{};
+    if (!toJoints(coordinates, joints)) {
+        return false;
     }
 
-    if (allIdle && timeBasedInterpolator_->isFinished()) {
-        isMoving_ = false;
+    for (size_t j = 0; j < jointCount_; ++j) {
+        if (!jointAxes_[j]->followPosition(joints[j], deltaTime)) {
+            return false;
+        }
     }
+    return true;
+}
+
+bool MotionController::toJoints(const PathPosition& coordinates, PathPosition& joints) const
+{
+    const double* coordinateColumns[Kinematics::kMaxCoordinates];
+    double* jointColumns[Kinematics::kMaxCoordinates];
+    for (size_t i = 0; i < pathAxisCount_; ++i) {
+        coordinateColumns[i] = &coordinates[i];
+    }
+    for (size_t j = 0; j < jointCount_; ++j) {
+        jointColumns[j] = &joints[j];
+    }
+    return kinematics_->inverse(coordinateColumns, jointColumns, 1);
+}
+
+bool MotionController::shapersSettled() const
+{
+    for (size_t i = 0; i < pathAxisCount_; ++i) {
+        if (!shapers_[i].isSettled()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int MotionController::findPathAxis(const std::string& axisName) const
+{
+    for (size_t i = 0; i < pathAxisCount_; ++i) {
+        const bool match = kinematics_ ? axisName == kinematics_->getCoordinateName(i)
+                                       : pathAxes_[i] && pathAxes_[i]->getName() == axisName;
+        if (match) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+bool MotionController::setInputShaper(const std::string& axisName, InputShaperType type, double frequency,
+                                      double damping)
+{
+    int index = findPathAxis(axisName);
+    if (index < 0 || isMoving_) {
+        return false;
+    }
+
+    const double samplePeriod = getInterpolationPeriod() / 1000.0;
+    if (!shapers_[index].configure(type, frequency, damping, samplePeriod)) {
+        spdlog::warn("轴 {} 的输入整形参数无效: 频率 {} Hz, 阻尼比 {}", axisName, frequency, damping);
+        return false;
+    }
+    return true;
+}
+
+const InputShaper* MotionController::getInputShaper(const std::string& axisName) const
+{
+    int index = findPathAxis(axisName);
+    return index >= 0 ? &shapers_[index] : nullptr;
 }
 
 void MotionController::setInterpolationPeriod(int periodMs)
 {
-    timeBasedInterpolator_->setInterpolationPeriod(periodMs);
+    withInterpolator([&](auto& interpolator) { interpolator.setInterpolationPeriod(periodMs); });
+
+    // 整形脉冲的延迟以插补周期计，按新周期重新计算
+    const double samplePeriod = getInterpolationPeriod() / 1000.0;
+    for (InputShaper& shaper : shapers_) {
+        if (!shaper.configure(shaper.getType(), shaper.getFrequency(), shaper.getDamping(), samplePeriod)) {
+            spdlog::warn("插补周期 {} ms 下整形时长超出历史缓冲区，关闭输入整形", periodMs);
+            shaper.configure(InputShaperType::None, 0.0, 0.0, samplePeriod);
+        }
+    }
 }
 
 int MotionController::getInterpolationPeriod() const
 {
-    return timeBasedInterpolator_->getInterpolationPeriod();
+    return withInterpolator([](const auto& interpolator) { return interpolator.getInterpolationPeriod(); });
+}
+
+void MotionController::setCoarseInterpolationPeriod(int periodMs)
+{
+    withInterpolator([&](auto& interpolator) { interpolator.setCoarsePeriod(periodMs); });
+}
+
+int MotionController::getCoarseInterpolationPeriod() const
+{
+    return withInterpolator([](const auto& interpolator) { return interpolator.getCoarsePeriod(); });
 }
 
 double MotionController::getInterpolationProgress() const
 {
-    return timeBasedInterpolator_->getProgress();
+    return withInterpolator([](const auto& interpolator) { return interpolator.getProgress(); });
 }
 
 bool MotionController::isInterpolationFinished() const
 {
-    return timeBasedInterpolator_->isFinished();
+    return withInterpolator([](const auto& interpolator) { return interpolator.isFinished(); });
 }
 
 size_t MotionController::getInterpolationQueueSize() const
 {
-    return timeBasedInterpolator_->getQueueSize();
+    return withInterpolator([](const auto& interpolator) { return interpolator.getQueueSize(); });
 }
 
 MotionController::MotionState MotionController::getMotionState() const {
@@ -0,0 +1,194 @@
+#include "xxcnc/motion/RealTimeLoop.h"
+#include "spdlog/spdlog.h"
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#ifdef _WIN32
+#include <Windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <time.h>
+#endif
+
+namespace xxcnc {
+namespace motion {
+
+namespace {
+
+/**
+ * @brief 睡眠到绝对截止时间
+ * @details Linux 下 steady_clock 基于 CLOCK_MONOTONIC，直接使用 clock_nanosleep 的绝对时间模式
+ */
+void sleepUntil(std::chrono::steady_clock::time_point deadline) {
+#if defined(__linux__)
+    auto sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(sinceEpoch / 1000000000);
+    ts.tv_nsec = static_cast<long>(sinceEpoch % 1000000000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+    }
+#else
+    std::this_thread::sleep_until(deadline);
+#endif
+}
+
+} // namespace
+
+RealTimeLoop::RealTimeLoop(std::shared_ptr<MotionController> controller, const RealTimeLoopOptions& options)
+    : controller_(std::move(controller))
+    , options_(options)
+{
+}
+
+RealTimeLoop::~RealTimeLoop() {
+    stop();
+}
+
+bool RealTimeLoop::start() {
+    if (!controller_ || running_.exchange(true)) {
+        return false;
+    }
+
+    thread_ = std::thread(&RealTimeLoop::run, this);
+    spdlog::info("实时控制循环已启动，周期: {}ms", controller_->getInterpolationPeriod());
+    return true;
+}
+
+void RealTimeLoop::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    spdlog::info("实时控制循环已停止，周期数: {}，超限次数: {}，最大抖动: {} us",
+                 cycles_.load(), overruns_.load(), maxJitterNs_.load() / 1000);
+}
+
+bool RealTimeLoop::isRunning() const {
+    return running_.load();
+}
+
+RealTimeLoop::Statistics RealTimeLoop::getStatistics() const {
+    Statistics stats;
+    stats.cycles = cycles_.load(std::memory_order_relaxed);
+    stats.overruns = overruns_.load(std::memory_order_relaxed);
+    stats.skippedCycles = skippedCycles_.load(std::memory_order_relaxed);
+    stats.maxJitterNs = maxJitterNs_.load(std::memory_order_relaxed);
+    stats.totalJitterNs = totalJitterNs_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < kJitterBuckets; ++i) {
+        stats.jitterHistogram[i] = jitterHistogram_[i].load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+void RealTimeLoop::resetStatistics() {
+    cycles_.store(0);
+    overruns_.store(0);
+    skippedCycles_.store(0);
+    maxJitterNs_.store(0);
+    totalJitterNs_.store(0);
+    for (auto& bucket : jitterHistogram_) {
+        bucket.store(0);
+    }
+}
+
+int64_t RealTimeLoop::bucketUpperBoundUs(size_t bucket) {
+    if (bucket + 1 >= kJitterBuckets) {
+        return -1;
+    }
+    return int64_t(1) << bucket;
+}
+
+void RealTimeLoop::run() {
+    configureCurrentThread();
+
+    // 周期在启动时确定，修改插补周期后需重新启动循环
+    const auto period = std::chrono::milliseconds(controller_->getInterpolationPeriod());
+    const double deltaTime = controller_->getInterpolationPeriod() / 1000.0;
+
+    auto deadline = std::chrono::steady_clock::now() + period;
+    while (running_.load(std::memory_order_acquire)) {
+        sleepUntil(deadline);
+
+        auto wake = std::chrono::steady_clock::now();
+        int64_t jitterNs = std::chrono::duration_cast<std::chrono::nanoseconds>(wake - deadline).count();
+        recordJitter(jitterNs > 0 ? jitterNs : 0);
+
+        controller_->update(deltaTime);
+        cycles_.fetch_add(1, std::memory_order_relaxed);
+
+        // 超限时跳过已错过的截止时间，保持周期相位不变
+        deadline += period;
+        auto end = std::chrono::steady_clock::now();
+        if (end >= deadline) {
+            auto missed = (end - deadline) / period + 1;
+            overruns_.fetch_add(1, std::memory_order_relaxed);
+            skippedCycles_.fetch_add(static_cast<uint64_t>(missed), std::memory_order_relaxed);
+            deadline += period * missed;
+        }
+    }
+}
+
+void RealTimeLoop::configureCurrentThread() {
+#ifdef _WIN32
+    if (options_.priority > 0 && !SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL)) {
+        spdlog::warn("设置实时线程优先级失败: {}", GetLastError());
+    }
+    if (options_.cpu >= 0 && options_.cpu < 64 &&
+        SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << options_.cpu) == 0) {
+        spdlog::warn("绑定 CPU {} 失败: {}", options_.cpu, GetLastError());
+    }
+    if (options_.lockMemory) {
+        spdlog::warn("Windows 平台不支持 mlockall，忽略内存锁定");
+    }
+#elif defined(__linux__)
+    if (options_.lockMemory && mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        spdlog::warn("mlockall 失败: {}", std::strerror(errno));
+    }
+    if (options_.cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(options_.cpu, &cpus);
+        int result = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if (result != 0) {
+            spdlog::warn("绑定 CPU {} 失败: {}", options_.cpu, std::strerror(result));
+        }
+    }
+    if (options_.priority > 0) {
+        sched_param param;
+        std::memset(&param, 0, sizeof(param));
+        param.sched_priority = options_.priority;
+        int result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (result != 0) {
+            spdlog::warn("设置 SCHED_FIFO 优先级 {} 失败: {}", options_.priority, std::strerror(result));
+        }
+    }
+#else
+    if (options_.priority > 0 || options_.cpu >= 0 || options_.lockMemory) {
+        spdlog::warn("当前平台不支持实时线程配置，按普通线程运行");
+    }
+#endif
+}
+
+void RealTimeLoop::recordJitter(int64_t jitterNs) {
+    totalJitterNs_.fetch_add(jitterNs, std::memory_order_relaxed);
+    if (jitterNs > maxJitterNs_.load(std::memory_order_relaxed)) {
+        maxJitterNs_.store(jitterNs, std::memory_order_relaxed);
+    }
+
+    // 按微秒数的二进制位数分桶
+    size_t bucket = 0;
+    for (int64_t us = jitterNs / 1000; us > 0 && bucket + 1 < kJitterBuckets; us >>= 1) {
+        ++bucket;
+    }
+    jitterHistogram_[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace motion
+} // namespace xxcnc
@@ -4,241 +4,724 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 #include <algorithm>
+#include <limits>
 #include "spdlog/spdlog.h"
 
 namespace xxcnc {
 namespace core {
 namespace motion {
 
-TimeBasedInterpolator::TimeBasedInterpolator(int interpolationPeriodMs)
-    : interpolationPeriodMs_(interpolationPeriodMs)
+template <size_t N>
+BasicTimeBasedInterpolator<N>::BasicTimeBasedInterpolator(int interpolationPeriodMs, int coarsePeriodMs)
+    : tailValid_(false)
+    , epoch_(0)
+    , appendedCount_(0)
+    , clearedCount_(0)
     , totalDistance_(0.0)
+    , lastExitVelocity_(0.0)
+    , completedSegmentsLength_(0.0)
+    , pendingRetired_(0)
+    , coarseRemaining_(coarsePeriodMs / 1000.0)
+    , coarseScale_(1.0)
+    , rampState_(FeedHoldState::Running)
+    , rampStartScale_(1.0)
+    , rampTargetScale_(1.0)
+    , rampDuration_(0.0)
+    , rampElapsed_(0.0)
+    , consumerEpoch_(0)
+    , spanValid_(false)
+    , fineElapsed_(0.0)
+    , spanRetired_(0)
+    , spanCompletedDistance_(0.0)
+    , spanRampState_(FeedHoldState::Running)
+    , retiredCount_(0)
     , completedDistance_(0.0)
-    , isPlanning_(false)
+    , completedEpoch_(0)
+    , timeScale_(1.0)
+    , feedHoldState_(FeedHoldState::Running)
+    , currentLineNumber_(0)
+    , interpolationPeriodMs_(interpolationPeriodMs)
+    , coarsePeriodMs_(coarsePeriodMs)
+    , junctionDeviation_(0.01)
 {
     if (interpolationPeriodMs <= 0) {
         throw std::invalid_argument("插补周期必须为正数");
     }
+    if (coarsePeriodMs <= 0) {
+        throw std::invalid_argument("粗插补周期必须为正数");
+    }
+}
+
+template <size_t N>
+BasicTimeBasedInterpolator<N>::~BasicTimeBasedInterpolator() = default;
+
+template <size_t N>
+void BasicTimeBasedInterpolator<N>::setInterpolationPeriod(int periodMs) {
+    if (periodMs <= 0) {
+        throw std::invalid_argument("插补周期必须为正数");
+    }
     
-    interpolationEngine_ = std::make_unique<InterpolationEngine>();
+    interpolationPeriodMs_.store(periodMs);
 }
 
-TimeBasedInterpolator::~TimeBasedInterpolator() {
-    clearQueue();
+template <size_t N>
+int BasicTimeBasedInterpolator<N>::getInterpolationPeriod() const {
+    return interpolationPeriodMs_.load();
 }
 
-void TimeBasedInterpolator::setInterpolationPeriod(int periodMs) {
+template <size_t N>
+void BasicTimeBasedInterpolator<N>::setCoarsePeriod(int periodMs) {
     if (periodMs <= 0) {
-        throw std::invalid_argument("插补周期必须为正数");
+        throw std::invalid_argument("粗插补周期必须为正数");
     }
     
-    std::lock_guard<std::mutex> lock(queueMutex_);
-    interpolationPeriodMs_ = periodMs;
+    coarsePeriodMs_.store(periodMs);
 }
 
-int TimeBasedInterpolator::getInterpolationPeriod() const {
-    return interpolationPeriodMs_;
+template <size_t N>
+int BasicTimeBasedInterpolator<N>::getCoarsePeriod() const {
+    return coarsePeriodMs_.load();
 }
 
-bool TimeBasedInterpolator::planLinearPath(
-    const Point& start,
-    const Point& end,
-    const InterpolationEngine::InterpolationParams& params
-) {
+template <size_t N>
+bool BasicTimeBasedInterpolator<N>::append(const Segment& segment) {
     try {
-        std::lock_guard<std::mutex> lock(queueMutex_);
-        
-        // 清空现有队列
-        clearQueue();
-        
-        // 设置当前位置
-        currentPosition_ = start;
-        
-        // 使用插补引擎生成路径点
-        std::vector<Point> path = interpolationEngine_->linearInterpolation(start, end, params);
+        // 验证参数
+        if (segment.params.feedRate <= 0.0) {
+            throw std::invalid_argument("Feed rate must be positive");
+        }
+        if (segment.params.acceleration <= 0.0) {
+            throw std::invalid_argument("Acceleration must be positive");
+        }
+        if (segment.type == Segment::Type::Circular &&
+            (planarDistance(segment.start, segment.center) < 1e-6 ||
+             planarDistance(segment.end, segment.center) < 1e-6)) {
+            throw std::invalid_argument("Center point cannot be the same as start or end point");
+        }
         
-        // 按照时间周期拆分路径
-        segmentPathByTime(path, params);
+        Segment queued = segment;
+        queued.length = calculateSegmentLength(queued);
+        queued.epoch = epoch_.load(std::memory_order_acquire);
+        if (queued.params.deceleration <= 0.0) {
+            queued.params.deceleration = queued.params.acceleration;
+        }
         
-        // 计算总距离
-        totalDistance_ = calculateDistance(start, end);
-        completedDistance_ = 0.0;
+        totalDistance_.store(totalDistance_.load(std::memory_order_relaxed) + queued.length);
+        tailPosition_ = queued.end;
+        tailValid_ = true;
+        segmentQueue_.push(queued);
+        appendedCount_.fetch_add(1, std::memory_order_release);
         
         return true;
-    } catch (const std::exception&) {
-        // 记录错误
+    } catch (const std::exception& e) {
+        spdlog::error("TimeBasedInterpolator::append - 追加运动段失败: {}", e.what());
         return false;
     }
 }
 
-bool TimeBasedInterpolator::planCircularPath(
-    const Point& start,
-    const Point& end,
-    const Point& center,
+template <size_t N>
+bool BasicTimeBasedInterpolator<N>::appendLinear(
+    const PointType& end,
+    const InterpolationEngine::InterpolationParams& params,
+    int lineNumber
+) {
+    Segment segment;
+    segment.type = Segment::Type::Linear;
+    segment.start = tailPosition_;
+    segment.end = end;
+    segment.params = params;
+    segment.lineNumber = lineNumber;
+    return append(segment);
+}
+
+template <size_t N>
+bool BasicTimeBasedInterpolator<N>::appendCircular(
+    const PointType& end,
+    const PointType& center,
     bool isClockwise,
-    const InterpolationEngine::InterpolationParams& params
+    const InterpolationEngine::InterpolationParams& params,
+    int lineNumber
 ) {
-    try {
-        std::lock_guard<std::mutex> lock(queueMutex_);
-        
-        // 清空现有队列
-        clearQueue();
+    Segment segment;
+    segment.type = Segment::Type::Circular;
+    segment.start = tailPosition_;
+    segment.end = end;
+    segment.center = center;
+    segment.isClockwise = isClockwise;
+    segment.params = params;
+    segment.lineNumber = lineNumber;
+    return append(segment);
+}
+
+template <size_t N>
+PointN<N> BasicTimeBasedInterpolator<N>::getTailPosition() const {
+    return tailPosition_;
+}
+
+template <size_t N>
+bool BasicTimeBasedInterpolator<N>::hasTailPosition() const {
+    return tailValid_;
+}
+
+template <size_t N>
+bool BasicTimeBasedInterpolator<N>::planLinearPath(
+    const PointType& start,
+    const PointType& end,
+    const InterpolationEngine::InterpolationParams& params,
+    int lineNumber
+) {
+    Segment segment;
+    segment.type = Segment::Type::Linear;
+    segment.start = start;
+    segment.end = end;
+    segment.params = params;
+    segment.lineNumber = lineNumber;
+    return append(segment);
+}
+
+template <size_t N>
+bool BasicTimeBasedInterpolator<N>::planCircularPath(
+    const PointType& start,
+    const PointType& end,
+    const PointType& center,
+    bool isClockwise,
+    const InterpolationEngine::InterpolationParams& params,
+    int lineNumber
+) {
+    Segment segment;
+    segment.type = Segment::Type::Circular;
+    segment.start = start;
+    segment.end = end;
+    segment.center = center;
+    segment.isClockwise = isClockwise;
+    segment.params = params;
+    segment.lineNumber = lineNumber;
+    return append(segment);
+}
+
+template <size_t N>
+bool BasicTimeBasedInterpolator<N>::getNextPoint(PointType& point) {
+    discardStaleSegments();
+    
+    // 从静止状态开始时，以当前段起点作为首个节点
+    if (!spanValid_) {
+        if (!active_.valid && !activateNextSegment()) {
+            return false;
+        }
+        fineElapsed_ = 0.0;
+        if (!startNextSpan(sampleActiveSegment(false))) {
+            return false;
+        }
+    }
+    
+    // 精插补推进一个插补周期，越过区间终点时由粗插补生成下一个节点
+    fineElapsed_ += interpolationPeriodMs_.load(std::memory_order_relaxed) / 1000.0;
+    while (fineElapsed_ >= fineInterpolator_.getDuration()) {
+        fineElapsed_ -= fineInterpolator_.getDuration();
+        arriveAtSpanEnd();
+        if (!startNextSpan(nextDeparture_)) {
+            spanValid_ = false;
+            point = currentPosition_;
+            return true;
+        }
+    }
+    
+    point = fineInterpolator_.positionAt(fineElapsed_);
+    currentPosition_ = point;
+    timeScale_.store(fineInterpolator_.timeScaleAt(fineElapsed_), std::memory_order_relaxed);
+    
+    return true;
+}
+
+template <size_t N>
+bool BasicTimeBasedInterpolator<N>::startNextSpan(const Knot& from) {
+    Knot start = from;
+    if (!active_.valid) {
+        if (!activateNextSegment()) {
+            return false;
+        }
+        start = sampleActiveSegment(false);
+    }
+    
+    // 精插补区间总在一个运动段内，区间开始执行时发布该段的行号
+    currentLineNumber_.store(active_.segment.lineNumber, std::memory_order_relaxed);
+    
+    // 步长取到下一个粗插补周期节点，并在过渡结束、速度曲线阶段切换和运动段结束处截断
+    double step = coarseRemaining_;
+    if (isRamping()) {
+        step = std::min(step, rampDuration_ - rampElapsed_);
+    }
+    const double phaseChange = active_.profile.nextPhaseChange(active_.elapsed);
+    const double toPhaseChange = phaseChange - active_.elapsed;
+    double pathStep = pathTimeAdvance(step);
+    bool atPhaseChange = false;
+    if (pathStep >= toPhaseChange) {
+        atPhaseChange = true;
+        if (!isRamping()) {
+            step = toPhaseChange / coarseScale_;
+        } else {
+            // 过渡期间时间映射非线性，二分求解到达段终点的时刻
+            double low = 0.0;
+            double high = step;
+            for (int i = 0; i < 40; ++i) {
+                double mid = 0.5 * (low + high);
+                if (pathTimeAdvance(mid) < toPhaseChange) {
+                    low = mid;
+                } else {
+                    high = mid;
+                }
+            }
+            step = high;
+        }
+    }
+    
+    advanceTimeScale(step);
+    active_.elapsed = atPhaseChange ? phaseChange : active_.elapsed + pathStep;
+    coarseRemaining_ -= step;
+    if (coarseRemaining_ <= 1e-12) {
+        coarseRemaining_ = coarsePeriodMs_.load(std::memory_order_relaxed) / 1000.0;
+    }
+    
+    // 阶段切换处加速度不连续，区间终点取左极限，下一区间起点取右极限
+    Knot end = sampleActiveSegment(true);
+    nextDeparture_ = atPhaseChange ? sampleActiveSegment(false) : end;
+    if (atPhaseChange && phaseChange >= active_.profile.duration()) {
+        // 下一区间从新运动段起点出发，使用新段的速度方向
+        retireActiveSegment();
+        if (activateNextSegment()) {
+            nextDeparture_ = sampleActiveSegment(false);
+        }
+    }
+    
+    spanRetired_ = pendingRetired_;
+    pendingRetired_ = 0;
+    spanCompletedDistance_ = completedSegmentsLength_ +
+                             (active_.valid ? active_.profile.distanceAt(active_.elapsed) : 0.0);
+    spanRampState_ = rampState_;
+    
+    fineInterpolator_.setSpan(start, end, step);
+    spanValid_ = true;
+    return true;
+}
+
+template <size_t N>
+void BasicTimeBasedInterpolator<N>::arriveAtSpanEnd() {
+    if (spanRetired_ > 0) {
+        retiredCount_.fetch_add(spanRetired_, std::memory_order_release);
+        spanRetired_ = 0;
+    }
+    completedDistance_.store(spanCompletedDistance_, std::memory_order_relaxed);
+    currentPosition_ = fineInterpolator_.positionAt(fineInterpolator_.getDuration());
+    timeScale_.store(fineInterpolator_.timeScaleAt(fineInterpolator_.getDuration()), std::memory_order_relaxed);
+    
+    // 减速或加速过渡在精插补到达对应节点时才算完成
+    FeedHoldState published = feedHoldState_.load();
+    if (spanRampState_ == FeedHoldState::Held && published == FeedHoldState::Decelerating) {
+        feedHoldState_.store(FeedHoldState::Held);
+    } else if (spanRampState_ == FeedHoldState::Running && published == FeedHoldState::Resuming) {
+        feedHoldState_.store(FeedHoldState::Running);
+    }
+}
+
+template <size_t N>
+bool BasicTimeBasedInterpolator<N>::activateNextSegment() {
+    Segment segment;
+    while (segmentQueue_.pop(segment)) {
+        // 丢弃已清空或长度为零的运动段
+        if (segment.epoch != consumerEpoch_ || segment.length < 1e-9) {
+            ++pendingRetired_;
+            continue;
+        }
         
-        // 设置当前位置
-        currentPosition_ = start;
+        // 结束速度受拐角速度限制，并保证下一段能够在其长度内停止
+        const double cruise = cruiseVelocity(segment);
+        double exitVelocity = 0.0;
+        const Segment* next = segmentQueue_.front();
+        if (next != nullptr && next->epoch == consumerEpoch_ && next->length >= 1e-9) {
+            exitVelocity = std::min({
+                cruise,
+                cruiseVelocity(*next),
+                calculateJunctionVelocity(segment, *next),
+                std::sqrt(2.0 * next->params.deceleration * next->length)
+            });
+        }
         
-        // 使用插补引擎生成路径点
-        std::vector<Point> path = interpolationEngine_->circularInterpolation(
-            start, end, center, isClockwise, params
+        active_.segment = segment;
+        active_.profile = VelocityProfile::plan(
+            segment.length,
+            lastExitVelocity_,
+            cruise,
+            exitVelocity,
+            segment.params.acceleration,
+            segment.params.deceleration
         );
+        active_.elapsed = 0.0;
         
-        // 按照时间周期拆分路径
-        segmentPathByTime(path, params);
-        
-        // 计算总距离（圆弧长度）
-        double radius = calculateDistance(start, center);
-        double startAngle = atan2(start.y - center.y, start.x - center.x);
-        double endAngle = atan2(end.y - center.y, end.x - center.x);
-        
-        // 确保角度在正确的方向上
-        if (isClockwise) {
-            if (endAngle > startAngle) {
-                endAngle -= 2 * M_PI;
-            }
-        } else {
-            if (startAngle > endAngle) {
-                endAngle += 2 * M_PI;
+        if (segment.type == Segment::Type::Circular) {
+            active_.radius = planarDistance(segment.start, segment.center);
+            active_.startAngle = std::atan2(segment.start[1] - segment.center[1], segment.start[0] - segment.center[0]);
+            double endAngle = std::atan2(segment.end[1] - segment.center[1], segment.end[0] - segment.center[0]);
+            if (segment.isClockwise) {
+                if (endAngle > active_.startAngle) {
+                    endAngle -= 2 * M_PI;
+                }
+            } else {
+                if (active_.startAngle > endAngle) {
+                    endAngle += 2 * M_PI;
+                }
             }
+            active_.sweep = endAngle - active_.startAngle;
         }
         
-        double angle = isClockwise ? (startAngle - endAngle) : (endAngle - startAngle);
-        totalDistance_ = radius * angle;
-        completedDistance_ = 0.0;
-        
+        active_.valid = true;
+        params_ = segment.params;
         return true;
-    } catch (const std::exception&) {
-        // 记录错误
-        return false;
     }
+    
+    return false;
 }
 
-bool TimeBasedInterpolator::getNextPoint(Point& point) {
-    std::lock_guard<std::mutex> lock(queueMutex_);
-    
-    if (interpolationQueue_.empty()) {
-        return false;
+template <size_t N>
+void BasicTimeBasedInterpolator<N>::retireActiveSegment() {
+    lastExitVelocity_ = active_.profile.exitVelocity;
+    completedSegmentsLength_ += active_.segment.length;
+    active_.valid = false;
+    ++pendingRetired_;
+}
+
+template <size_t N>
+void BasicTimeBasedInterpolator<N>::discardStaleSegments() {
+    uint64_t epoch = epoch_.load(std::memory_order_acquire);
+    if (epoch == consumerEpoch_) {
+        return;
     }
     
-    point = interpolationQueue_.front();
-    interpolationQueue_.pop();
+    consumerEpoch_ = epoch;
     
-    // 更新已完成距离
-    completedDistance_ += calculateDistance(currentPosition_, point);
-    currentPosition_ = point;
+    // 丢弃当前段、未发布的已完成段及队列中属于旧代数的段
+    uint64_t discarded = pendingRetired_ + (spanValid_ ? spanRetired_ : 0);
+    if (active_.valid) {
+        active_.valid = false;
+        ++discarded;
+    }
+    const Segment* front = segmentQueue_.front();
+    while (front != nullptr && front->epoch != epoch) {
+        Segment stale;
+        segmentQueue_.pop(stale);
+        ++discarded;
+        front = segmentQueue_.front();
+    }
+    retiredCount_.fetch_add(discarded, std::memory_order_release);
     
-    return true;
+    // 重置粗、精插补状态、速度、进度和进给保持状态
+    pendingRetired_ = 0;
+    spanRetired_ = 0;
+    spanValid_ = false;
+    fineElapsed_ = 0.0;
+    coarseRemaining_ = coarsePeriodMs_.load(std::memory_order_relaxed) / 1000.0;
+    lastExitVelocity_ = 0.0;
+    completedSegmentsLength_ = 0.0;
+    completedDistance_.store(0.0, std::memory_order_relaxed);
+    completedEpoch_.store(epoch, std::memory_order_release);
+    currentLineNumber_.store(0, std::memory_order_relaxed);
+    timeScale_.store(1.0, std::memory_order_relaxed);
+    coarseScale_ = 1.0;
+    rampState_ = FeedHoldState::Running;
+    rampStartScale_ = 1.0;
+    rampTargetScale_ = 1.0;
+    rampDuration_ = 0.0;
+    rampElapsed_ = 0.0;
+    feedHoldState_.store(FeedHoldState::Running);
 }
 
-void TimeBasedInterpolator::clearQueue() {
-    std::lock_guard<std::mutex> lock(queueMutex_);
+template <size_t N>
+BasicMotionKnot<N> BasicTimeBasedInterpolator<N>::sampleActiveSegment(bool arriving) const {
+    const Segment& segment = active_.segment;
+    const VelocityProfile& profile = active_.profile;
+    const double distance = profile.distanceAt(active_.elapsed);
+    const double ratio = (segment.length > 0.0) ? std::min(1.0, distance / segment.length) : 1.0;
     
-    // 记录清除前的队列大小
-    size_t queueSize = interpolationQueue_.size();
+    // 路径位置及其对路径长度的一阶、二阶导数；圆弧段 XY 以外的轴线性插补
+    PointType position = lerp(segment.start, segment.end, ratio);
+    PointType tangent;
+    PointType curvature;
+    if (segment.length > 0.0) {
+        forEachAxis<N>([&](auto i) { tangent[i] = (segment.end[i] - segment.start[i]) / segment.length; });
+    }
+    if (segment.type == Segment::Type::Circular) {
+        const double angle = active_.startAngle + active_.sweep * ratio;
+        const double angleRate = (segment.length > 0.0) ? active_.sweep / segment.length : 0.0;
+        const double c = std::cos(angle);
+        const double s = std::sin(angle);
+        position[0] = segment.center[0] + active_.radius * c;
+        position[1] = segment.center[1] + active_.radius * s;
+        tangent[0] = -active_.radius * angleRate * s;
+        tangent[1] = active_.radius * angleRate * c;
+        curvature[0] = -active_.radius * angleRate * angleRate * c;
+        curvature[1] = -active_.radius * angleRate * angleRate * s;
+    }
     
-    // 清空队列
-    while (!interpolationQueue_.empty()) {
-        interpolationQueue_.pop();
+    // 计入时间缩放：ds/dt = v * k，d2s/dt2 = a * k^2 + v * dk/dt
+    double scaleRate = 0.0;
+    if (isRamping()) {
+        const double u = std::min(1.0, rampElapsed_ / rampDuration_);
+        scaleRate = (rampTargetScale_ - rampStartScale_) * 6.0 * u * (1.0 - u) / rampDuration_;
     }
+    const double pathVelocity = profile.velocityAt(active_.elapsed);
+    const double speed = pathVelocity * coarseScale_;
+    const double pathAcceleration = arriving ? profile.accelerationBefore(active_.elapsed)
+                                             : profile.accelerationAt(active_.elapsed);
+    const double acceleration = pathAcceleration * coarseScale_ * coarseScale_ + pathVelocity * scaleRate;
+    
+    Knot knot;
+    knot.position = position;
+    forEachAxis<N>([&](auto i) {
+        knot.velocity[i] = tangent[i] * speed;
+        knot.acceleration[i] = curvature[i] * speed * speed + tangent[i] * acceleration;
+    });
+    knot.timeScale = coarseScale_;
+    knot.timeScaleRate = scaleRate;
+    return knot;
+}
+
+template <size_t N>
+void BasicTimeBasedInterpolator<N>::clearQueue() {
+    uint64_t appended = appendedCount_.load(std::memory_order_acquire);
+    size_t queueSize = getQueueSize();
     
-    // 重置距离计数
-    totalDistance_ = 0.0;
-    completedDistance_ = 0.0;
+    clearedCount_.store(appended, std::memory_order_release);
+    epoch_.fetch_add(1, std::memory_order_acq_rel);
+    totalDistance_.store(0.0);
+    tailValid_ = false;
     
     // 记录清除结果
-    spdlog::info("TimeBasedInterpolator::clearQueue - 已清除插补队列，原队列大小: {}", queueSize);
+    spdlog::info("TimeBasedInterpolator::clearQueue - 已清除插补队列，原运动段数: {}", queueSize);
 }
 
-size_t TimeBasedInterpolator::getQueueSize() const {
-    std::lock_guard<std::mutex> lock(queueMutex_);
-    return interpolationQueue_.size();
+template <size_t N>
+size_t BasicTimeBasedInterpolator<N>::getQueueSize() const {
+    uint64_t appended = appendedCount_.load(std::memory_order_acquire);
+    uint64_t done = std::max(retiredCount_.load(std::memory_order_acquire),
+                             clearedCount_.load(std::memory_order_acquire));
+    return appended > done ? static_cast<size_t>(appended - done) : 0;
 }
 
-bool TimeBasedInterpolator::isFinished() const {
-    std::lock_guard<std::mutex> lock(queueMutex_);
-    return interpolationQueue_.empty() && !isPlanning_;
+template <size_t N>
+bool BasicTimeBasedInterpolator<N>::isFinished() const {
+    return getQueueSize() == 0;
 }
 
-double TimeBasedInterpolator::getProgress() const {
-    std::lock_guard<std::mutex> lock(queueMutex_);
-    
-    if (totalDistance_ < 1e-6) {
+template <size_t N>
+double BasicTimeBasedInterpolator<N>::getProgress() const {
+    double total = totalDistance_.load();
+    if (total < 1e-6 || isFinished()) {
         return 1.0;
     }
     
-    return std::min(1.0, completedDistance_ / totalDistance_);
+    if (completedEpoch_.load(std::memory_order_acquire) != epoch_.load(std::memory_order_acquire)) {
+        return 0.0;
+    }
+    
+    return std::min(1.0, completedDistance_.load(std::memory_order_relaxed) / total);
 }
 
-void TimeBasedInterpolator::segmentPathByTime(
-    const std::vector<Point>& path,
-    const InterpolationEngine::InterpolationParams& params
-) {
-    if (path.size() < 2) {
+template <size_t N>
+void BasicTimeBasedInterpolator<N>::beginFeedHold() {
+    FeedHoldState state = feedHoldState_.load();
+    if (state == FeedHoldState::Decelerating || state == FeedHoldState::Held) {
         return;
     }
     
-    // 计算每个时间周期的距离增量
-    double feedRatePerMs = params.feedRate / (60.0 * 1000.0); // 转换为mm/ms
-    double distancePerPeriod = feedRatePerMs * interpolationPeriodMs_;
+    startTimeScaleRamp(0.0, params_.deceleration);
+    rampState_ = FeedHoldState::Decelerating;
+    feedHoldState_.store(FeedHoldState::Decelerating);
+}
+
+template <size_t N>
+void BasicTimeBasedInterpolator<N>::resumeFromHold() {
+    FeedHoldState state = feedHoldState_.load();
+    if (state == FeedHoldState::Running || state == FeedHoldState::Resuming) {
+        return;
+    }
     
-    // 标记正在规划
-    isPlanning_ = true;
+    startTimeScaleRamp(1.0, params_.acceleration);
+    rampState_ = FeedHoldState::Resuming;
+    feedHoldState_.store(FeedHoldState::Resuming);
+}
+
+template <size_t N>
+FeedHoldState BasicTimeBasedInterpolator<N>::getFeedHoldState() const {
+    return feedHoldState_.load();
+}
+
+template <size_t N>
+double BasicTimeBasedInterpolator<N>::getTimeScale() const {
+    return timeScale_.load();
+}
+
+template <size_t N>
+int BasicTimeBasedInterpolator<N>::getCurrentLineNumber() const {
+    return currentLineNumber_.load(std::memory_order_relaxed);
+}
+
+template <size_t N>
+void BasicTimeBasedInterpolator<N>::startTimeScaleRamp(double targetScale, double limit) {
+    const double period = coarsePeriodMs_.load(std::memory_order_relaxed) / 1000.0;
+    const double speed = active_.valid ? active_.profile.peakVelocity : 0.0;
+    const double speedChange = speed * std::abs(targetScale - coarseScale_);
     
-    // 遍历原始路径点，按照时间周期拆分
-    for (size_t i = 0; i < path.size() - 1; ++i) {
-        const Point& p1 = path[i];
-        const Point& p2 = path[i + 1];
-        
-        double segmentDistance = calculateDistance(p1, p2);
-        if (segmentDistance < 1e-6) {
-            continue;
-        }
-        
-        // 计算方向向量
-        double dx = (p2.x - p1.x) / segmentDistance;
-        double dy = (p2.y - p1.y) / segmentDistance;
-        double dz = (p2.z - p1.z) / segmentDistance;
-        
-        // 计算需要拆分的点数
-        int numPoints = static_cast<int>(std::ceil(segmentDistance / distancePerPeriod));
-        
-        // 生成拆分点
-        for (int j = 1; j <= numPoints; ++j) {
-            double t = std::min(1.0, j * distancePerPeriod / segmentDistance);
-            
-            Point interpolatedPoint(
-                p1.x + dx * t * segmentDistance,
-                p1.y + dy * t * segmentDistance,
-                p1.z + dz * t * segmentDistance
-            );
-            
-            interpolationQueue_.push(interpolatedPoint);
+    // 采用 3u^2 - 2u^3 过渡曲线：最大斜率为 1.5/T，最大二阶导数为 6/T^2，
+    // 据此选取满足加速度和加加速度限制的最短过渡时间
+    double duration = period;
+    if (limit > 0.0) {
+        duration = std::max(duration, 1.5 * speedChange / limit);
+    }
+    if (params_.jerk > 0.0) {
+        duration = std::max(duration, std::sqrt(6.0 * speedChange / params_.jerk));
+    }
+    
+    // 过渡从下一个粗插补节点开始
+    rampStartScale_ = coarseScale_;
+    rampTargetScale_ = targetScale;
+    rampDuration_ = duration;
+    rampElapsed_ = 0.0;
+}
+
+template <size_t N>
+bool BasicTimeBasedInterpolator<N>::isRamping() const {
+    return rampState_ == FeedHoldState::Decelerating || rampState_ == FeedHoldState::Resuming;
+}
+
+template <size_t N>
+double BasicTimeBasedInterpolator<N>::pathTimeAdvance(double step) const {
+    if (!isRamping()) {
+        return coarseScale_ * step;
+    }
+    
+    // 对过渡曲线积分：∫(3u^2 - 2u^3)du = u^3 - u^4/2
+    auto integral = [](double u) { return u * u * u - 0.5 * u * u * u * u; };
+    const double ua = rampElapsed_ / rampDuration_;
+    const double ub = std::min(1.0, (rampElapsed_ + step) / rampDuration_);
+    double advance = rampDuration_ * (rampStartScale_ * (ub - ua) +
+                     (rampTargetScale_ - rampStartScale_) * (integral(ub) - integral(ua)));
+    const double overrun = rampElapsed_ + step - rampDuration_;
+    if (overrun > 0.0) {
+        advance += overrun * rampTargetScale_;
+    }
+    return advance;
+}
+
+template <size_t N>
+void BasicTimeBasedInterpolator<N>::advanceTimeScale(double step) {
+    if (!isRamping()) {
+        return;
+    }
+    
+    rampElapsed_ += step;
+    if (rampDuration_ - rampElapsed_ <= 1e-12) {
+        coarseScale_ = rampTargetScale_;
+        rampState_ = (rampTargetScale_ > 0.0) ? FeedHoldState::Running : FeedHoldState::Held;
+        return;
+    }
+    
+    const double u = rampElapsed_ / rampDuration_;
+    coarseScale_ = rampStartScale_ + (rampTargetScale_ - rampStartScale_) * u * u * (3.0 - 2.0 * u);
+}
+
+template <size_t N>
+double BasicTimeBasedInterpolator<N>::cruiseVelocity(const Segment& segment) const {
+    double velocity = segment.params.feedRate / 60.0;
+    if (segment.params.maxVelocity > 0.0) {
+        velocity = std::min(velocity, segment.params.maxVelocity);
+    }
+    return velocity;
+}
+
+template <size_t N>
+PointN<N> BasicTimeBasedInterpolator<N>::calculateTangent(const Segment& segment, bool atEnd) const {
+    PointType tangent;
+    if (segment.type == Segment::Type::Linear) {
+        double length = distance(segment.start, segment.end);
+        if (length >= 1e-12) {
+            forEachAxis<N>([&](auto i) { tangent[i] = (segment.end[i] - segment.start[i]) / length; });
         }
+        return tangent;
+    }
+    
+    // 圆弧切向量垂直于半径方向
+    const PointType& p = atEnd ? segment.end : segment.start;
+    double rx = p[0] - segment.center[0];
+    double ry = p[1] - segment.center[1];
+    double r = std::sqrt(rx * rx + ry * ry);
+    if (r >= 1e-12) {
+        tangent[0] = segment.isClockwise ? ry / r : -ry / r;
+        tangent[1] = segment.isClockwise ? -rx / r : rx / r;
     }
+    return tangent;
+}
+
+template <size_t N>
+double BasicTimeBasedInterpolator<N>::calculateJunctionVelocity(const Segment& current, const Segment& next) const {
+    PointType t1 = calculateTangent(current, true);
+    PointType t2 = calculateTangent(next, false);
     
-    // 确保最后一个点是精确的终点
-    interpolationQueue_.push(path.back());
+    // 拐角偏差法：cosTheta 为两段方向的反向夹角余弦
+    double cosTheta = 0.0;
+    forEachAxis<N>([&](auto i) { cosTheta -= t1[i] * t2[i]; });
+    if (cosTheta > 0.999999) {
+        return 0.0;
+    }
+    if (cosTheta < -0.999999) {
+        return std::numeric_limits<double>::max();
+    }
     
-    // 标记规划完成
-    isPlanning_ = false;
+    double sinHalfTheta = std::sqrt(0.5 * (1.0 - cosTheta));
+    double acceleration = std::min(current.params.acceleration, next.params.acceleration);
+    return std::sqrt(acceleration * junctionDeviation_ * sinHalfTheta / (1.0 - sinHalfTheta));
 }
 
-double TimeBasedInterpolator::calculateDistance(const Point& p1, const Point& p2) const {
-    double dx = p2.x - p1.x;
-    double dy = p2.y - p1.y;
-    double dz = p2.z - p1.z;
-    return std::sqrt(dx * dx + dy * dy + dz * dz);
+template <size_t N>
+double BasicTimeBasedInterpolator<N>::calculateSegmentLength(const Segment& segment) const {
+    if (segment.type == Segment::Type::Linear) {
+        return distance(segment.start, segment.end);
+    }
+    
+    // 圆弧长度
+    double radius = planarDistance(segment.start, segment.center);
+    double startAngle = atan2(segment.start[1] - segment.center[1], segment.start[0] - segment.center[0]);
+    double endAngle = atan2(segment.end[1] - segment.center[1], segment.end[0] - segment.center[0]);
+    
+    // 确保角度在正确的方向上
+    if (segment.isClockwise) {
+        if (endAngle > startAngle) {
+            endAngle -= 2 * M_PI;
+        }
+    } else {
+        if (startAngle > endAngle) {
+            endAngle += 2 * M_PI;
+        }
+    }
+    
+    double angle = segment.isClockwise ? (startAngle - endAngle) : (endAngle - startAngle);
+    double arcLength = radius * angle;
+    double sum = arcLength * arcLength;
+    forEachAxis<N>([&](auto i) {
+        if (i >= 2) {
+            const double d = segment.end[i] - segment.start[i];
+            sum += d * d;
+        }
+    });
+    return std::sqrt(sum);
 }
 
+template class BasicTimeBasedInterpolator<3>;
+template class BasicTimeBasedInterpolator<4>;
+template class BasicTimeBasedInterpolator<5>;
+template class BasicTimeBasedInterpolator<6>;
+template class BasicTimeBasedInterpolator<7>;
+template class BasicTimeBasedInterpolator<8>;
+template class BasicTimeBasedInterpolator<9>;
+
 } // namespace motion
 } // namespace core
 } // namespace xxcnc
@@ -0,0 +1,131 @@
+#include "xxcnc/core/motion/VelocityProfile.h"
+#include <algorithm>
+#include <cmath>
+
+namespace xxcnc {
+namespace core {
+namespace motion {
+
+VelocityProfile VelocityProfile::plan(
+    double length,
+    double entry,
+    double cruise,
+    double exit,
+    double acceleration,
+    double deceleration
+) {
+    VelocityProfile profile;
+    profile.length = std::max(length, 0.0);
+    profile.acceleration = std::max(acceleration, 1e-6);
+    profile.deceleration = std::max(deceleration, 1e-6);
+
+    const double a = profile.acceleration;
+    const double d = profile.deceleration;
+
+    // 起止速度必须在当前长度内可达
+    double v0 = std::max(entry, 0.0);
+    double v1 = std::max(exit, 0.0);
+    v1 = std::min(v1, std::sqrt(v0 * v0 + 2.0 * a * profile.length));
+    v0 = std::min(v0, std::sqrt(v1 * v1 + 2.0 * d * profile.length));
+
+    double vp = std::max({cruise, v0, v1});
+    double accelDist = (vp * vp - v0 * v0) / (2.0 * a);
+    double decelDist = (vp * vp - v1 * v1) / (2.0 * d);
+
+    // 距离不足以加速到匀速速度时，计算三角形曲线的峰值速度
+    if (accelDist + decelDist > profile.length) {
+        vp = std::sqrt((2.0 * a * d * profile.length + d * v0 * v0 + a * v1 * v1) / (a + d));
+        vp = std::max({vp, v0, v1});
+        accelDist = (vp * vp - v0 * v0) / (2.0 * a);
+        decelDist = (vp * vp - v1 * v1) / (2.0 * d);
+    }
+
+    profile.entryVelocity = v0;
+    profile.peakVelocity = vp;
+    profile.exitVelocity = v1;
+    profile.accelTime = (vp - v0) / a;
+    profile.decelTime = (vp - v1) / d;
+    profile.cruiseTime = (vp > 1e-9) ? std::max(0.0, profile.length - accelDist - decelDist) / vp : 0.0;
+    return profile;
+}
+
+double VelocityProfile::distanceAt(double t) const {
+    if (t <= 0.0) {
+        return 0.0;
+    }
+    if (t >= duration()) {
+        return length;
+    }
+
+    if (t < accelTime) {
+        return entryVelocity * t + 0.5 * acceleration * t * t;
+    }
+
+    const double accelDist = entryVelocity * accelTime + 0.5 * acceleration * accelTime * accelTime;
+    t -= accelTime;
+    if (t < cruiseTime) {
+        return accelDist + peakVelocity * t;
+    }
+
+    const double cruiseDist = peakVelocity * cruiseTime;
+    t -= cruiseTime;
+    return std::min(length, accelDist + cruiseDist + peakVelocity * t - 0.5 * deceleration * t * t);
+}
+
+double VelocityProfile::velocityAt(double t) const {
+    if (t <= 0.0) {
+        return entryVelocity;
+    }
+    if (t >= duration()) {
+        return exitVelocity;
+    }
+    if (t < accelTime) {
+        return entryVelocity + acceleration * t;
+    }
+    t -= accelTime;
+    if (t < cruiseTime) {
+        return peakVelocity;
+    }
+    t -= cruiseTime;
+    return peakVelocity - deceleration * t;
+}
+
+double VelocityProfile::accelerationAt(double t) const {
+    if (t < 0.0 || t >= duration()) {
+        return 0.0;
+    }
+    if (t < accelTime) {
+        return acceleration;
+    }
+    if (t < accelTime + cruiseTime) {
+        return 0.0;
+    }
+    return -deceleration;
+}
+
+double VelocityProfile::accelerationBefore(double t) const {
+    if (t <= 0.0 || t > duration()) {
+        return 0.0;
+    }
+    if (t <= accelTime) {
+        return acceleration;
+    }
+    if (t <= accelTime + cruiseTime) {
+        return 0.0;
+    }
+    return -deceleration;
+}
+
+double VelocityProfile::nextPhaseChange(double t) const {
+    if (t < accelTime) {
+        return accelTime;
+    }
+    if (t < accelTime + cruiseTime) {
+        return accelTime + cruiseTime;
+    }
+    return duration();
+}
+
+} // namespace motion
+} // namespace core
+} // namespace xxcnc
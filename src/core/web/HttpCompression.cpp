@@ -0,0 +1,136 @@
+#include "xxcnc/core/web/HttpCompression.h"
+#include <brotli/encode.h>
+#include <zlib.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+
+namespace xxcnc {
+namespace web {
+
+namespace {
+
+std::string trim(const std::string& text, size_t begin, size_t end) {
+    while (begin < end && std::isspace(static_cast<unsigned char>(text[begin]))) {
+        ++begin;
+    }
+    while (end > begin && std::isspace(static_cast<unsigned char>(text[end - 1]))) {
+        --end;
+    }
+    return text.substr(begin, end - begin);
+}
+
+bool gzipCompress(const std::string& input, std::string& output, int level) {
+    if (input.size() > std::numeric_limits<uInt>::max()) {
+        return false;
+    }
+
+    z_stream stream{};
+    // windowBits 加 16 输出 gzip 格式
+    if (deflateInit2(&stream, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+    output.resize(deflateBound(&stream, static_cast<uLong>(input.size())));
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream.avail_in = static_cast<uInt>(input.size());
+    stream.next_out = reinterpret_cast<Bytef*>(&output[0]);
+    stream.avail_out = static_cast<uInt>(output.size());
+    const int result = deflate(&stream, Z_FINISH);
+    output.resize(stream.total_out);
+    deflateEnd(&stream);
+    return result == Z_STREAM_END;
+}
+
+bool brotliCompress(const std::string& input, std::string& output, int quality) {
+    size_t size = BrotliEncoderMaxCompressedSize(input.size());
+    if (size == 0) {
+        return false;
+    }
+    output.resize(size);
+    if (!BrotliEncoderCompress(quality, BROTLI_DEFAULT_WINDOW, BROTLI_MODE_TEXT, input.size(),
+                               reinterpret_cast<const uint8_t*>(input.data()), &size,
+                               reinterpret_cast<uint8_t*>(&output[0]))) {
+        return false;
+    }
+    output.resize(size);
+    return true;
+}
+
+} // namespace
+
+ContentEncoding negotiateEncoding(const std::string& acceptEncoding, bool brotli, bool gzip) {
+    double brQuality = -1.0;
+    double gzipQuality = -1.0;
+    double anyQuality = -1.0;
+
+    size_t begin = 0;
+    while (begin <= acceptEncoding.size()) {
+        size_t end = acceptEncoding.find(',', begin);
+        if (end == std::string::npos) {
+            end = acceptEncoding.size();
+        }
+        const std::string item = trim(acceptEncoding, begin, end);
+        begin = end + 1;
+
+        const size_t semicolon = item.find(';');
+        std::string name = trim(item, 0, std::min(semicolon, item.size()));
+        std::transform(name.begin(), name.end(), name.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        double quality = 1.0;
+        if (semicolon != std::string::npos) {
+            const size_t q = item.find("q=", semicolon);
+            if (q != std::string::npos) {
+                quality = std::clamp(std::strtod(item.c_str() + q + 2, nullptr), 0.0, 1.0);
+            }
+        }
+
+        if (name == "br") {
+            brQuality = quality;
+        } else if (name == "gzip" || name == "x-gzip") {
+            gzipQuality = quality;
+        } else if (name == "*") {
+            anyQuality = quality;
+        }
+    }
+
+    // 未列出的编码按通配符的 q 值处理
+    const double br = brotli ? (brQuality >= 0.0 ? brQuality : std::max(anyQuality, 0.0)) : 0.0;
+    const double gz = gzip ? (gzipQuality >= 0.0 ? gzipQuality : std::max(anyQuality, 0.0)) : 0.0;
+    if (br > 0.0 && br >= gz) {
+        return ContentEncoding::Brotli;
+    }
+    if (gz > 0.0) {
+        return ContentEncoding::Gzip;
+    }
+    return ContentEncoding::Identity;
+}
+
+const char* encodingName(ContentEncoding encoding) {
+    switch (encoding) {
+        case ContentEncoding::Gzip:
+            return "gzip";
+        case ContentEncoding::Brotli:
+            return "br";
+        default:
+            return "";
+    }
+}
+
+bool compressContent(ContentEncoding encoding, const std::string& input, std::string& output,
+                     CompressionEffort effort) {
+    const bool best = effort == CompressionEffort::Best;
+    switch (encoding) {
+        case ContentEncoding::Gzip:
+            return gzipCompress(input, output, best ? Z_BEST_COMPRESSION : 5);
+        case ContentEncoding::Brotli:
+            return brotliCompress(input, output, best ? BROTLI_MAX_QUALITY : 5);
+        default:
+            output = input;
+            return true;
+    }
+}
+
+} // namespace web
+} // namespace xxcnc
@@ -0,0 +1,150 @@
+#include "xxcnc/core/web/ParseCache.h"
+#include <iterator>
+#include <utility>
+
+namespace xxcnc {
+namespace web {
+
+ParseCache::ParseCache(size_t budgetBytes)
+    : budget_(budgetBytes)
+{
+}
+
+std::shared_ptr<const FileParseResponse> ParseCache::get(const std::filesystem::path& path, const Loader& loader) {
+    std::error_code ec;
+    const auto mtime = std::filesystem::last_write_time(path, ec);
+    const uintmax_t fileSize = ec ? 0 : std::filesystem::file_size(path, ec);
+    if (ec) {
+        auto response = std::make_shared<FileParseResponse>();
+        loader(*response);
+        return response;
+    }
+
+    const std::string key = path.string();
+    std::promise<Result> promise;
+    uint64_t id = 0;
+    while (id == 0) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            if (it->second->mtime == mtime && it->second->fileSize == fileSize) {
+                entries_.splice(entries_.begin(), entries_, it->second);
+                ++hits_;
+                return it->second->result;
+            }
+            eraseLocked(it->second);
+        }
+
+        // 相同版本的文件正在解析时等待其结果，解析被中止时重新发起
+        auto flight = flights_.find(key);
+        if (flight != flights_.end() && flight->second.mtime == mtime && flight->second.fileSize == fileSize) {
+            ++hits_;
+            std::shared_future<Result> pending = flight->second.result;
+            lock.unlock();
+            if (Result result = pending.get()) {
+                return result;
+            }
+            continue;
+        }
+
+        // 文件在上一次解析期间被修改时，新的解析替代旧的，旧的结果不再写入缓存
+        id = ++loads_;
+        flights_[key] = Flight{id, mtime, fileSize, promise.get_future().share()};
+    }
+
+    auto response = std::make_shared<FileParseResponse>();
+    bool completed = true;
+    try {
+        completed = loader(*response);
+    } catch (const std::exception& e) {
+        response = std::make_shared<FileParseResponse>();
+        response->error = e.what();
+    }
+    const Result result = std::move(response);
+
+    // 先移除进行中的解析再交出结果，被中止时等待的请求重新发起解析，不会再等到这一次
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto flight = flights_.find(key);
+    const bool current = flight != flights_.end() && flight->second.id == id;
+    if (current) {
+        flights_.erase(flight);
+    }
+    const size_t bytes = estimateSize(*result);
+    if (current && completed && result->success && bytes <= budget_) {
+        auto existing = index_.find(key);
+        if (existing != index_.end()) {
+            eraseLocked(existing->second);
+        }
+        entries_.push_front(Entry{key, mtime, fileSize, bytes, result});
+        index_[key] = entries_.begin();
+        bytes_ += bytes;
+
+        // 超出预算时淘汰最久未使用的结果
+        while (bytes_ > budget_) {
+            eraseLocked(std::prev(entries_.end()));
+        }
+    }
+    lock.unlock();
+
+    promise.set_value(completed ? result : nullptr);
+    return result;
+}
+
+void ParseCache::erase(const std::filesystem::path& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(path.string());
+    if (it != index_.end()) {
+        eraseLocked(it->second);
+    }
+    // 进行中的解析不再写入缓存
+    flights_.erase(path.string());
+}
+
+void ParseCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    index_.clear();
+    flights_.clear();
+    bytes_ = 0;
+}
+size_t ParseCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+size_t ParseCache::getMemoryUsage() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_;
+}
+
+uint64_t ParseCache::getLoadCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return loads_;
+}
+
+uint64_t ParseCache::getHitCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+size_t ParseCache::estimateSize(const FileParseResponse& response) {
+    size_t bytes = sizeof(FileParseResponse) + response.error.capacity();
+    bytes += response.toolPathDetails.capacity() * sizeof(std::string);
+    for (const std::string& line : response.toolPathDetails) {
+        bytes += line.capacity();
+    }
+    bytes += response.trajectoryPoints.capacity() * sizeof(TrajectoryPoint);
+    for (const TrajectoryPoint& point : response.trajectoryPoints) {
+        bytes += point.command.capacity();
+    }
+    return bytes;
+}
+
+void ParseCache::eraseLocked(std::list<Entry>::iterator it) {
+    bytes_ -= it->bytes;
+    index_.erase(it->path);
+    entries_.erase(it);
+}
+
+} // namespace web
+} // namespace xxcnc
@@ -0,0 +1,161 @@
+#include "xxcnc/core/web/StaticAssets.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+
+namespace xxcnc {
+namespace web {
+
+namespace {
+
+// 64位 FNV-1a 哈希，十六进制表示
+std::string contentHash(const std::string& content) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : content) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    static const char digits[] = "0123456789abcdef";
+    std::string text(16, '0');
+    for (size_t i = text.size(); i-- > 0; hash >>= 4) {
+        text[i] = digits[hash & 0xF];
+    }
+    return text;
+}
+
+// 文本类内容压缩效果好，图片、字体等已压缩的格式不再压缩
+bool isCompressible(const std::string& contentType) {
+    return contentType.rfind("text/", 0) == 0 ||
+           contentType.find("javascript") != std::string::npos ||
+           contentType.find("json") != std::string::npos ||
+           contentType.find("xml") != std::string::npos ||
+           contentType == "application/wasm";
+}
+
+// 压缩后不比原始内容小时不保留压缩版本
+std::string precompress(ContentEncoding encoding, const std::string& content) {
+    std::string compressed;
+    if (!compressContent(encoding, content, compressed, CompressionEffort::Best) ||
+        compressed.size() >= content.size()) {
+        return std::string();
+    }
+    return compressed;
+}
+
+} // namespace
+
+const std::string& StaticAsset::body(ContentEncoding encoding) const {
+    if (encoding == ContentEncoding::Gzip && !gzip.empty()) {
+        return gzip;
+    }
+    if (encoding == ContentEncoding::Brotli && !brotli.empty()) {
+        return brotli;
+    }
+    return identity;
+}
+
+std::string StaticAsset::etagFor(ContentEncoding encoding) const {
+    if (encoding == ContentEncoding::Identity) {
+        return etag;
+    }
+    // 在引号内追加编码名
+    return etag.substr(0, etag.size() - 1) + "-" + encodingName(encoding) + "\"";
+}
+
+bool StaticAssets::load(const std::filesystem::path& root) {
+    std::error_code ec;
+    if (!std::filesystem::is_directory(root, ec)) {
+        spdlog::error("静态资源目录不存在: {}", root.string());
+        return false;
+    }
+
+    std::unordered_map<std::string, std::shared_ptr<const StaticAsset>> assets;
+    size_t bytes = 0;
+    for (std::filesystem::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+        if (!it->is_regular_file(ec)) {
+            continue;
+        }
+
+        std::ifstream file(it->path(), std::ios::binary);
+        if (!file) {
+            spdlog::error("读取静态资源失败: {}", it->path().string());
+            return false;
+        }
+        std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        auto asset = std::make_shared<StaticAsset>();
+        asset->contentType = contentType(it->path());
+        asset->cacheControl = asset->contentType.rfind("text/html", 0) == 0
+            ? "no-cache"
+            : "public, max-age=" + std::to_string(kMaxAge);
+        asset->etag = "\"" + contentHash(content) + "\"";
+        if (isCompressible(asset->contentType)) {
+            asset->gzip = precompress(ContentEncoding::Gzip, content);
+            asset->brotli = precompress(ContentEncoding::Brotli, content);
+        }
+        asset->identity = std::move(content);
+        bytes += asset->identity.size() + asset->gzip.size() + asset->brotli.size();
+
+        const std::string path = "/" + std::filesystem::relative(it->path(), root, ec).generic_string();
+        assets[path] = std::move(asset);
+    }
+    if (ec) {
+        spdlog::error("遍历静态资源目录失败: {}: {}", root.string(), ec.message());
+        return false;
+    }
+
+    assets_ = std::move(assets);
+    bytes_ = bytes;
+    spdlog::info("已加载静态资源: {} 个文件, {} 字节", assets_.size(), bytes_);
+    return true;
+}
+
+std::shared_ptr<const StaticAsset> StaticAssets::find(const std::string& path) const {
+    auto it = assets_.find(path);
+    if (it != assets_.end()) {
+        return it->second;
+    }
+    it = assets_.find(path + (!path.empty() && path.back() == '/' ? "" : "/") + "index.html");
+    return it != assets_.end() ? it->second : nullptr;
+}
+
+size_t StaticAssets::size() const {
+    return assets_.size();
+}
+
+size_t StaticAssets::getMemoryUsage() const {
+    return bytes_;
+}
+
+std::string StaticAssets::contentType(const std::filesystem::path& path) {
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    static const std::unordered_map<std::string, std::string> types = {
+        {".html", "text/html; charset=utf-8"},
+        {".htm", "text/html; charset=utf-8"},
+        {".js", "text/javascript; charset=utf-8"},
+        {".mjs", "text/javascript; charset=utf-8"},
+        {".css", "text/css; charset=utf-8"},
+        {".json", "application/json"},
+        {".map", "application/json"},
+        {".txt", "text/plain; charset=utf-8"},
+        {".svg", "image/svg+xml"},
+        {".png", "image/png"},
+        {".jpg", "image/jpeg"},
+        {".jpeg", "image/jpeg"},
+        {".gif", "image/gif"},
+        {".ico", "image/x-icon"},
+        {".woff", "font/woff"},
+        {".woff2", "font/woff2"},
+        {".wasm", "application/wasm"}
+    };
+    auto it = types.find(extension);
+    return it != types.end() ? it->second : "application/octet-stream";
+}
+
+} // namespace web
+} // namespace xxcnc
@@ -0,0 +1,61 @@
+#include "xxcnc/core/web/StatusPublisher.h"
+#include <utility>
+
+namespace xxcnc {
+namespace web {
+
+StatusPublisher::StatusPublisher(Sampler sampler, Serializer serializer)
+    : sampler_(std::move(sampler))
+    , serializer_(std::move(serializer))
+    , instance_(std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::system_clock::now().time_since_epoch()).count()))
+{
+}
+
+std::shared_ptr<const PublishedStatus> StatusPublisher::acquire(int channel, std::chrono::steady_clock::duration maxAge) {
+    if (channel < 0) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const size_t index = static_cast<size_t>(channel);
+    const auto now = std::chrono::steady_clock::now();
+    if (index < slots_.size() && slots_[index].document && now - slots_[index].sampledAt < maxAge) {
+        return slots_[index].document;
+    }
+
+    // 先采样确认通道有效，再为其分配位置
+    StatusResponse status;
+    if (!sampler_(channel, status)) {
+        return nullptr;
+    }
+    ++samples_;
+    status.trajectoryPoints.clear();
+    if (slots_.size() <= index) {
+        slots_.resize(index + 1);
+    }
+    Slot& slot = slots_[index];
+    slot.sampledAt = now;
+
+    std::string json = serializer_(status);
+    if (slot.document && slot.document->json == json) {
+        return slot.document;
+    }
+
+    auto document = std::make_shared<PublishedStatus>();
+    document->channel = channel;
+    document->status = std::move(status);
+    document->json = std::move(json);
+    document->version = ++version_;
+    document->etag = "\"" + instance_ + "-" + std::to_string(channel) + "-" + std::to_string(document->version) + "\"";
+    slot.document = std::move(document);
+    return slot.document;
+}
+
+uint64_t StatusPublisher::getSampleCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return samples_;
+}
+
+} // namespace web
+} // namespace xxcnc
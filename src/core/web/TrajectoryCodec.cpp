@@ -0,0 +1,177 @@
+#include "xxcnc/core/web/TrajectoryCodec.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace xxcnc {
+namespace web {
+
+namespace {
+
+/// 点标志数组补齐到 4 字节对齐后的字节数
+size_t paddedFlagBytes(size_t count) {
+    return (count + 3) & ~size_t(3);
+}
+
+void appendLE(std::string& out, uint64_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+void appendFloat(std::string& out, double value) {
+    const float f = static_cast<float>(value);
+    uint32_t bits = 0;
+    std::memcpy(&bits, &f, sizeof(bits));
+    appendLE(out, bits, 4);
+}
+
+uint64_t readLE(const std::string& data, size_t offset, size_t bytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(data[offset + i])) << (8 * i);
+    }
+    return value;
+}
+
+float readFloat(const std::string& data, size_t offset) {
+    const uint32_t bits = static_cast<uint32_t>(readLE(data, offset, 4));
+    float f = 0.0f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+} // namespace
+
+BinaryTrajectoryEncoder::BinaryTrajectoryEncoder(std::vector<TrajectoryPoint> points, const BinaryTrajectoryHeader& header)
+    : points_(std::make_shared<const std::vector<TrajectoryPoint>>(std::move(points)))
+    , header_(header)
+{
+}
+
+BinaryTrajectoryEncoder::BinaryTrajectoryEncoder(std::shared_ptr<const std::vector<TrajectoryPoint>> points,
+                                                 const BinaryTrajectoryHeader& header)
+    : points_(std::move(points))
+    , header_(header)
+{
+}
+
+size_t BinaryTrajectoryEncoder::getEncodedSize() const {
+    const size_t pointBytes = header_.firstSequence != 0 ? 24 : 16;
+    return kHeaderSize + points_->size() * pointBytes + paddedFlagBytes(points_->size());
+}
+
+bool BinaryTrajectoryEncoder::nextChunk(std::string& chunk, size_t maxBytes) {
+    chunk.clear();
+    maxBytes = std::max(maxBytes, kHeaderSize);
+    const std::vector<TrajectoryPoint>& points = *points_;
+    const size_t count = points.size();
+
+    while (section_ != Section::Done) {
+        const size_t room = maxBytes - chunk.size();
+        if (section_ == Section::Header) {
+            appendLE(chunk, kMagic, 4);
+            appendLE(chunk, kVersion, 2);
+            appendLE(chunk, (header_.more ? kFlagMore : 0) | (header_.firstSequence != 0 ? kFlagSequences : 0), 2);
+            appendLE(chunk, static_cast<uint32_t>(count), 4);
+            appendLE(chunk, static_cast<uint32_t>(header_.channel), 4);
+            appendLE(chunk, header_.firstSequence, 8);
+            appendLE(chunk, header_.latestSequence, 8);
+            appendLE(chunk, header_.clearedSequence, 8);
+            section_ = Section::Positions;
+            index_ = 0;
+        } else if (section_ == Section::Positions) {
+            const size_t end = std::min(count, index_ + room / 12);
+            for (; index_ < end; ++index_) {
+                appendFloat(chunk, points[index_].x);
+                appendFloat(chunk, points[index_].y);
+                appendFloat(chunk, points[index_].z);
+            }
+            if (index_ < count) {
+                break;
+            }
+            section_ = Section::Flags;
+            index_ = 0;
+        } else if (section_ == Section::Flags) {
+            // 补齐字节随标志一起生成，超出点数的部分为0
+            const size_t total = paddedFlagBytes(count);
+            const size_t end = std::min(total, index_ + room);
+            for (; index_ < end; ++index_) {
+                chunk.push_back(static_cast<char>(index_ < count && points[index_].isRapid ? kPointRapid : 0));
+            }
+            if (index_ < total) {
+                break;
+            }
+            section_ = Section::LineNumbers;
+            index_ = 0;
+        } else if (section_ == Section::LineNumbers) {
+            const size_t end = std::min(count, index_ + room / 4);
+            for (; index_ < end; ++index_) {
+                appendLE(chunk, static_cast<uint32_t>(points[index_].lineNumber), 4);
+            }
+            if (index_ < count) {
+                break;
+            }
+            section_ = header_.firstSequence != 0 ? Section::Sequences : Section::Done;
+            index_ = 0;
+        } else {
+            const size_t end = std::min(count, index_ + room / 8);
+            for (; index_ < end; ++index_) {
+                appendLE(chunk, points[index_].sequence, 8);
+            }
+            if (index_ < count) {
+                break;
+            }
+            section_ = Section::Done;
+        }
+    }
+    return !chunk.empty();
+}
+
+std::string BinaryTrajectoryEncoder::encode(std::vector<TrajectoryPoint> points, const BinaryTrajectoryHeader& header) {
+    BinaryTrajectoryEncoder encoder(std::move(points), header);
+    std::string data;
+    data.reserve(encoder.getEncodedSize());
+    std::string chunk;
+    while (encoder.nextChunk(chunk)) {
+        data += chunk;
+    }
+    return data;
+}
+
+bool BinaryTrajectoryEncoder::decode(const std::string& data, BinaryTrajectoryHeader& header,
+                                     std::vector<TrajectoryPoint>& points) {
+    if (data.size() < kHeaderSize || readLE(data, 0, 4) != kMagic || readLE(data, 4, 2) != kVersion) {
+        return false;
+    }
+    const size_t count = static_cast<size_t>(readLE(data, 8, 4));
+    const size_t flagsOffset = kHeaderSize + count * 12;
+    const size_t linesOffset = flagsOffset + paddedFlagBytes(count);
+    const size_t sequencesOffset = linesOffset + count * 4;
+    const uint64_t flags = readLE(data, 6, 2);
+    const bool hasSequences = (flags & kFlagSequences) != 0;
+    if (data.size() != sequencesOffset + (hasSequences ? count * 8 : 0)) {
+        return false;
+    }
+
+    header.more = (flags & kFlagMore) != 0;
+    header.channel = static_cast<int32_t>(readLE(data, 12, 4));
+    header.firstSequence = readLE(data, 16, 8);
+    header.latestSequence = readLE(data, 24, 8);
+    header.clearedSequence = readLE(data, 32, 8);
+
+    points.assign(count, TrajectoryPoint());
+    for (size_t i = 0; i < count; ++i) {
+        TrajectoryPoint& point = points[i];
+        point.x = readFloat(data, kHeaderSize + i * 12);
+        point.y = readFloat(data, kHeaderSize + i * 12 + 4);
+        point.z = readFloat(data, kHeaderSize + i * 12 + 8);
+        point.isRapid = (static_cast<unsigned char>(data[flagsOffset + i]) & kPointRapid) != 0;
+        point.lineNumber = static_cast<int>(static_cast<int32_t>(readLE(data, linesOffset + i * 4, 4)));
+        point.sequence = hasSequences ? readLE(data, sequencesOffset + i * 8, 8) : 0;
+    }
+    return true;
+}
+
+} // namespace web
+} // namespace xxcnc
@@ -0,0 +1,212 @@
+#include "xxcnc/core/web/TrajectoryHistory.h"
+#include <algorithm>
+
+namespace xxcnc {
+namespace web {
+
+TrajectoryHistory::TrajectoryHistory(size_t capacity) {
+    capacity = std::max(capacity, kMinCapacity);
+    x_.resize(capacity);
+    y_.resize(capacity);
+    z_.resize(capacity);
+    flags_.resize(capacity);
+    lineNumbers_.resize(capacity);
+    commandIds_.resize(capacity);
+    sequences_.resize(capacity);
+    commandBudget_ = capacity * kCommandBytesPerPoint;
+}
+
+uint64_t TrajectoryHistory::append(const TrajectoryPoint& point) {
+    // 点数或命令表超过上限的八分之七时开始抽稀，抽稀在剩余容量用完前完成
+    if (!compacting_ && size_ >= 2 &&
+        (size_ >= capacity() - capacity() / 8 || commandBytes_ > commandBudget_ - commandBudget_ / 8)) {
+        beginCompaction();
+    }
+    if (compacting_) {
+        compactStep(kCompactionSteps);
+    }
+    if (size_ + (gapEnd_ - gapBegin_) == capacity()) {
+        // 容量很小时步数取整可能不足，一次完成剩余的抽稀
+        if (!compacting_) {
+            beginCompaction();
+        }
+        compactStep(capacity());
+    }
+
+    const size_t index = size_ + (gapEnd_ - gapBegin_);
+    x_[index] = static_cast<float>(point.x);
+    y_[index] = static_cast<float>(point.y);
+    z_[index] = static_cast<float>(point.z);
+    flags_[index] = point.isRapid ? kRapid : 0;
+    lineNumbers_[index] = static_cast<int32_t>(point.lineNumber);
+    commandIds_[index] = intern(point.command);
+    sequences_[index] = nextSequence_;
+    ++size_;
+    return nextSequence_++;
+}
+
+size_t TrajectoryHistory::read(uint64_t sinceSequence, size_t maxPoints, std::vector<TrajectoryPoint>& points) const {
+    points.clear();
+    if (size_ == 0) {
+        return 0;
+    }
+
+    // 连续段内由序号直接算出下标，否则在抽稀过的部分二分查找；抽稀中连续段只取空隙之后未处理的部分
+    const size_t denseIndex = std::max(denseBegin_, gapEnd_);
+    const size_t denseBegin = denseIndex - (gapEnd_ - gapBegin_);
+    size_t begin = 0;
+    const uint64_t denseFirst = sequences_[denseIndex];
+    if (sinceSequence >= denseFirst) {
+        const uint64_t offset = sinceSequence - denseFirst;
+        begin = offset < size_ - denseBegin ? denseBegin + static_cast<size_t>(offset) + 1 : size_;
+    } else if (sinceSequence + 1 == denseFirst) {
+        begin = denseBegin;
+    } else {
+        size_t high = denseBegin;
+        while (begin < high) {
+            const size_t middle = begin + (high - begin) / 2;
+            if (sequences_[physical(middle)] <= sinceSequence) {
+                begin = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+    }
+
+    const size_t count = std::min(maxPoints, size_ - begin);
+    points.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const size_t index = physical(begin + i);
+        TrajectoryPoint& point = points[i];
+        point.x = x_[index];
+        point.y = y_[index];
+        point.z = z_[index];
+        point.isRapid = (flags_[index] & kRapid) != 0;
+        point.lineNumber = lineNumbers_[index];
+        point.command = commands_[commandIds_[index]];
+        point.sequence = sequences_[index];
+    }
+    return count;
+}
+
+bool TrajectoryHistory::back(TrajectoryPoint& point) const {
+    if (size_ == 0) {
+        return false;
+    }
+    const size_t index = physical(size_ - 1);
+    point.x = x_[index];
+    point.y = y_[index];
+    point.z = z_[index];
+    point.isRapid = (flags_[index] & kRapid) != 0;
+    point.lineNumber = lineNumbers_[index];
+    point.command = commands_[commandIds_[index]];
+    point.sequence = sequences_[index];
+    return true;
+}
+
+void TrajectoryHistory::clear() {
+    size_ = 0;
+    denseBegin_ = 0;
+    compacting_ = false;
+    gapBegin_ = 0;
+    gapEnd_ = 0;
+    commands_.clear();
+    commandRefs_.clear();
+    freeCommands_.clear();
+    commandIndex_.clear();
+    commandBytes_ = 0;
+}
+
+size_t TrajectoryHistory::getMemoryUsage() const {
+    return capacity() * (3 * sizeof(float) + sizeof(uint8_t) + sizeof(int32_t) + sizeof(uint32_t) +
+                         sizeof(uint64_t)) + commandBytes_;
+}
+
+size_t TrajectoryHistory::commandCost(const std::string& command) {
+    // 命令表和索引各保存一份文本，另有下标和引用计数
+    return 2 * (sizeof(std::string) + command.size()) + 2 * sizeof(uint32_t);
+}
+
+uint32_t TrajectoryHistory::intern(const std::string& command) {
+    auto it = commandIndex_.find(command);
+    if (it != commandIndex_.end()) {
+        ++commandRefs_[it->second];
+        return it->second;
+    }
+    const size_t cost = commandCost(command);
+    if (!command.empty() && commandBytes_ + cost > commandBudget_) {
+        // 命令表已满，不保存该点的命令文本
+        return intern(std::string());
+    }
+
+    uint32_t id = 0;
+    if (freeCommands_.empty()) {
+        id = static_cast<uint32_t>(commands_.size());
+        commands_.push_back(command);
+        commandRefs_.push_back(1);
+    } else {
+        id = freeCommands_.back();
+        freeCommands_.pop_back();
+        commands_[id] = command;
+        commandRefs_[id] = 1;
+    }
+    commandIndex_.emplace(command, id);
+    commandBytes_ += cost;
+    return id;
+}
+
+void TrajectoryHistory::release(uint32_t id) {
+    if (--commandRefs_[id] != 0) {
+        return;
+    }
+    commandBytes_ -= commandCost(commands_[id]);
+    commandIndex_.erase(commands_[id]);
+    std::string().swap(commands_[id]);
+    freeCommands_.push_back(id);
+}
+
+void TrajectoryHistory::beginCompaction() {
+    // 较早的一半隔点保留（保留其中第一个点），之后的点原样前移
+    compacting_ = true;
+    gapBegin_ = 0;
+    gapEnd_ = 0;
+    compactHalf_ = size_ / 2;
+    compactDense_ = std::max(compactHalf_, denseBegin_);
+    nextDenseBegin_ = 0;
+}
+
+void TrajectoryHistory::compactStep(size_t steps) {
+    const size_t end = size_ + (gapEnd_ - gapBegin_);
+    for (; steps > 0 && gapEnd_ < end; --steps) {
+        const size_t read = gapEnd_++;
+        if (read == compactDense_) {
+            nextDenseBegin_ = gapBegin_;
+        }
+        if (read < compactHalf_ && read % 2 != 0) {
+            release(commandIds_[read]);
+            --size_;
+            continue;
+        }
+        const size_t write = gapBegin_++;
+        if (write != read) {
+            x_[write] = x_[read];
+            y_[write] = y_[read];
+            z_[write] = z_[read];
+            flags_[write] = flags_[read];
+            lineNumbers_[write] = lineNumbers_[read];
+            commandIds_[write] = commandIds_[read];
+            sequences_[write] = sequences_[read];
+        }
+    }
+
+    if (gapEnd_ == end) {
+        // 全部处理完，空隙移到末尾后消除
+        compacting_ = false;
+        gapBegin_ = 0;
+        gapEnd_ = 0;
+        denseBegin_ = nextDenseBegin_;
+    }
+}
+
+} // namespace web
+} // namespace xxcnc
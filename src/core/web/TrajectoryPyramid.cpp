@@ -0,0 +1,174 @@
+#include "xxcnc/core/web/TrajectoryPyramid.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace xxcnc {
+namespace web {
+
+namespace {
+
+/// 抽稀时相邻锚点之间的最大点数
+constexpr size_t kMaxSpan = 512;
+
+/// 点到线段距离的平方
+double segmentDistanceSquared(const TrajectoryPoint& p, const TrajectoryPoint& a, const TrajectoryPoint& b) {
+    const double dx = b.x - a.x;
+    const double dy = b.y - a.y;
+    const double dz = b.z - a.z;
+    const double lengthSquared = dx * dx + dy * dy + dz * dz;
+    double t = 0.0;
+    if (lengthSquared > 0.0) {
+        t = std::clamp(((p.x - a.x) * dx + (p.y - a.y) * dy + (p.z - a.z) * dz) / lengthSquared, 0.0, 1.0);
+    }
+    const double ex = a.x + t * dx - p.x;
+    const double ey = a.y + t * dy - p.y;
+    const double ez = a.z + t * dz - p.z;
+    return ex * ex + ey * ey + ez * ez;
+}
+
+void expandBounds(TrajectoryBounds& bounds, const TrajectoryPoint& point) {
+    bounds.minX = std::min(bounds.minX, point.x);
+    bounds.minY = std::min(bounds.minY, point.y);
+    bounds.minZ = std::min(bounds.minZ, point.z);
+    bounds.maxX = std::max(bounds.maxX, point.x);
+    bounds.maxY = std::max(bounds.maxY, point.y);
+    bounds.maxZ = std::max(bounds.maxZ, point.z);
+}
+
+TrajectoryBounds pointBounds(const TrajectoryPoint& point) {
+    TrajectoryBounds bounds;
+    bounds.minX = bounds.maxX = point.x;
+    bounds.minY = bounds.maxY = point.y;
+    bounds.minZ = bounds.maxZ = point.z;
+    return bounds;
+}
+
+} // namespace
+
+TrajectoryPyramid::TrajectoryPyramid(const std::vector<TrajectoryPoint>& points, const TrajectoryPyramidOptions& options) {
+    Level base;
+    base.points.reserve(points.size());
+    for (const TrajectoryPoint& point : points) {
+        base.points.push_back(point);
+        base.points.back().command.clear();
+    }
+    if (!base.points.empty()) {
+        bounds_ = pointBounds(base.points.front());
+        for (const TrajectoryPoint& point : base.points) {
+            expandBounds(bounds_, point);
+        }
+    }
+
+    const size_t tilePoints = std::max<size_t>(options.tilePoints, 2);
+    buildTiles(base, tilePoints);
+    levels_.push_back(std::move(base));
+
+    double tolerance = options.baseTolerance;
+    while (levels_.size() < options.maxLevels && levels_.back().points.size() > options.minPoints &&
+           tolerance > 0.0) {
+        Level level;
+        level.tolerance = tolerance;
+        level.points = decimate(levels_.back().points, tolerance);
+        buildTiles(level, tilePoints);
+        levels_.push_back(std::move(level));
+        tolerance *= options.levelFactor;
+    }
+}
+
+size_t TrajectoryPyramid::selectLevel(double tolerance) const {
+    size_t selected = 0;
+    for (size_t i = 1; i < levels_.size() && levels_[i].tolerance <= tolerance; ++i) {
+        selected = i;
+    }
+    return selected;
+}
+
+std::vector<size_t> TrajectoryPyramid::queryTiles(size_t level, const TrajectoryBounds& viewport) const {
+    std::vector<size_t> tiles;
+    if (level >= levels_.size()) {
+        return tiles;
+    }
+    const std::vector<Tile>& levelTiles = levels_[level].tiles;
+    for (size_t i = 0; i < levelTiles.size(); ++i) {
+        if (levelTiles[i].bounds.intersectsXY(viewport)) {
+            tiles.push_back(i);
+        }
+    }
+    return tiles;
+}
+
+std::vector<TrajectoryPoint> TrajectoryPyramid::decimate(const std::vector<TrajectoryPoint>& points, double tolerance) {
+    const size_t count = points.size();
+    if (count < 3) {
+        return points;
+    }
+
+    // 首尾点、快速定位/切削的分界点以及每隔 kMaxSpan 个点的点作为锚点，锚点之间分别抽稀。
+    // 限制跨度避免螺旋线等轨迹上分割极不均衡时退化为平方复杂度
+    std::vector<bool> keep(count, false);
+    keep.front() = true;
+    keep.back() = true;
+    for (size_t i = 0; i + 1 < count; ++i) {
+        if (points[i].isRapid != points[i + 1].isRapid || i % kMaxSpan == 0) {
+            keep[i] = true;
+        }
+    }
+
+    const double toleranceSquared = tolerance * tolerance;
+    std::vector<std::pair<size_t, size_t>> stack;
+    size_t anchor = 0;
+    for (size_t i = 1; i < count; ++i) {
+        if (!keep[i]) {
+            continue;
+        }
+        stack.emplace_back(anchor, i);
+        while (!stack.empty()) {
+            const auto [first, last] = stack.back();
+            stack.pop_back();
+            double maxDistance = 0.0;
+            size_t farthest = first;
+            for (size_t j = first + 1; j < last; ++j) {
+                const double distance = segmentDistanceSquared(points[j], points[first], points[last]);
+                if (distance > maxDistance) {
+                    maxDistance = distance;
+                    farthest = j;
+                }
+            }
+            if (maxDistance > toleranceSquared) {
+                keep[farthest] = true;
+                stack.emplace_back(first, farthest);
+                stack.emplace_back(farthest, last);
+            }
+        }
+        anchor = i;
+    }
+
+    std::vector<TrajectoryPoint> result;
+    for (size_t i = 0; i < count; ++i) {
+        if (keep[i]) {
+            result.push_back(points[i]);
+        }
+    }
+    return result;
+}
+
+void TrajectoryPyramid::buildTiles(Level& level, size_t tilePoints) {
+    const size_t count = level.points.size();
+    for (size_t begin = 0; begin < count; begin += tilePoints - 1) {
+        Tile tile;
+        tile.begin = begin;
+        tile.end = std::min(begin + tilePoints - 1, count - 1);
+        tile.bounds = pointBounds(level.points[begin]);
+        for (size_t i = begin + 1; i <= tile.end; ++i) {
+            expandBounds(tile.bounds, level.points[i]);
+        }
+        level.tiles.push_back(tile);
+        if (tile.end == count - 1) {
+            break;
+        }
+    }
+}
+
+} // namespace web
+} // namespace xxcnc
@@ -1,21 +1,38 @@
 #include "xxcnc/core/web/WebServer.h"
 #include "xxcnc/core/web/WebAPI.h"
+#include "xxcnc/core/web/TrajectoryCodec.h"
+#include "xxcnc/core/web/TrajectoryPyramid.h"
+#include "xxcnc/core/web/StatusPublisher.h"
+#include "xxcnc/core/web/StaticAssets.h"
+#include "xxcnc/core/web/HttpCompression.h"
 #include <httplib.h>
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <filesystem>
+#include <mutex>
+#include <thread>
 
 namespace xxcnc {
 namespace web {
 
 class WebServerImpl {
 public:
-    WebServerImpl(WebServer& server) : server_(server) {}
+    WebServerImpl(WebServer& server)
+        : server_(server)
+        , publisher_([this](int channel, StatusResponse& status) {
+                         return server_.api_ && server_.api_->getChannelStatus(channel, status);
+                     },
+                     [](const StatusResponse& status) { return statusToJson(status).dump(); })
+    {
+    }
 
     void setStaticDir(const std::string& dir) {
         static_dir_ = dir;
-        if (!static_dir_.empty()) {
-            http_server_.set_mount_point("/", static_dir_);
-        }
+        // 启动前加载到内存并预压缩，加载失败时退回按请求读取磁盘
+        static_loaded_ = !static_dir_.empty() && static_assets_.load(static_dir_);
     }
 
     void setEnableCors(bool enable) {
@@ -44,10 +61,16 @@ public:
         server_.setPort(port);
         
         try {
-            // 确保静态目录已经设置
+            // 确保静态目录已经设置，静态资源路由在所有API路由之后注册
             if (!static_dir_.empty()) {
                 spdlog::info("WebServerImpl::start - 已设置静态目录: {}", static_dir_);
-                http_server_.set_mount_point("/", static_dir_);
+                if (static_loaded_) {
+                    http_server_.Get(R"(/.*)", [this](const httplib::Request& req, httplib::Response& res) {
+                        sendAsset(req, res);
+                    });
+                } else {
+                    http_server_.set_mount_point("/", static_dir_);
+                }
             }
             
             // 配置服务器选项
@@ -73,6 +96,7 @@ public:
     }
 
     void stop() {
+        stopping_ = true;
         http_server_.stop();
     }
 
@@ -97,9 +121,406 @@ public:
     }
 
 private:
+    /// 同时打开的状态推送连接上限，每个连接占用一个服务器工作线程
+    static constexpr int kMaxEventStreams = 4;
+
+    /// 状态无变化时发送保活注释的间隔
+    static constexpr std::chrono::seconds kEventKeepAlive{15};
+
+    /// 每次推送或增量查询最多返回的轨迹点数，其余的在后续推送或查询中返回
+    static constexpr size_t kMaxTrajectoryBatch = 10000;
+
+    /// 缓存的轨迹金字塔个数上限，超出时淘汰最久未使用的
+    static constexpr size_t kMaxCachedPyramids = 4;
+
+    /// 未指定像素大小时，按轨迹范围的该分之一选择层
+    static constexpr double kDefaultLodResolution = 1000.0;
+
+    /// JSON 响应达到该大小（字节）时才压缩，更小的响应压缩收益不抵开销
+    static constexpr size_t kMinCompressedSize = 1024;
+
+    /**
+     * @brief 状态推送连接的状态
+     */
+    struct EventStream {
+        int channel = 0;                                    ///< 通道编号
+        std::chrono::steady_clock::duration period{};       ///< 推送周期
+        std::chrono::steady_clock::time_point nextTick;     ///< 下一次采样时间
+        std::chrono::steady_clock::time_point lastSent;     ///< 上一次发送时间
+        uint64_t trajectorySequence = 0;                    ///< 已推送的最新轨迹点序号
+        uint64_t trajectoryCleared = 0;                     ///< 已推送的轨迹清除序号
+        std::shared_ptr<const PublishedStatus> lastStatus;  ///< 上一次推送的状态文档
+    };
+
+    /**
+     * @brief 发布周期，与默认推送频率一致
+     */
+    std::chrono::steady_clock::duration publishPeriod() const {
+        return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / std::min(std::max(server_.getPushRate(), 1.0), 100.0)));
+    }
+
+    /**
+     * @brief 发送共享的状态文档，客户端的 If-None-Match 与实体标签相同时返回 304
+     * @details 响应体直接引用共享文档，不复制
+     */
+    static void sendPublishedStatus(const httplib::Request& req, httplib::Response& res,
+                                    std::shared_ptr<const PublishedStatus> document) {
+        res.set_header("ETag", document->etag);
+        res.set_header("Cache-Control", "no-cache");
+        if (req.has_header("If-None-Match") &&
+            req.get_header_value("If-None-Match").find(document->etag) != std::string::npos) {
+            res.status = 304;
+            return;
+        }
+        const size_t length = document->json.size();
+        res.set_content_provider(length, "application/json",
+            [document](size_t offset, size_t size, httplib::DataSink& sink) {
+                return sink.write(document->json.data() + offset, size);
+            });
+    }
+
+    /**
+     * @brief 发送内存中的静态资源，按 Accept-Encoding 选择预压缩的版本
+     * @details 响应体直接引用共享的资源，不复制；If-None-Match 与所选版本的实体标签相同时返回 304
+     */
+    void sendAsset(const httplib::Request& req, httplib::Response& res) const {
+        std::shared_ptr<const StaticAsset> asset = static_assets_.find(req.path);
+        if (!asset) {
+            res.status = 404;
+            return;
+        }
+
+        const ContentEncoding encoding = negotiateEncoding(req.get_header_value("Accept-Encoding"),
+                                                           !asset->brotli.empty(), !asset->gzip.empty());
+        const std::string etag = asset->etagFor(encoding);
+        res.set_header("ETag", etag);
+        res.set_header("Cache-Control", asset->cacheControl);
+        if (!asset->gzip.empty() || !asset->brotli.empty()) {
+            res.set_header("Vary", "Accept-Encoding");
+        }
+        if (req.has_header("If-None-Match") &&
+            req.get_header_value("If-None-Match").find(etag) != std::string::npos) {
+            res.status = 304;
+            return;
+        }
+        if (encoding != ContentEncoding::Identity) {
+            res.set_header("Content-Encoding", encodingName(encoding));
+        }
+        const std::string* body = &asset->body(encoding);
+        res.set_content_provider(body->size(), asset->contentType,
+            [asset, body](size_t offset, size_t size, httplib::DataSink& sink) {
+                return sink.write(body->data() + offset, size);
+            });
+    }
+
+    /**
+     * @brief 发送 JSON 响应，较大且客户端接受压缩时按 Accept-Encoding 压缩
+     */
+    static void sendJson(const httplib::Request& req, httplib::Response& res, std::string json) {
+        if (json.size() < kMinCompressedSize) {
+            res.set_content(std::move(json), "application/json");
+            return;
+        }
+
+        res.set_header("Vary", "Accept-Encoding");
+        const ContentEncoding encoding = negotiateEncoding(req.get_header_value("Accept-Encoding"));
+        auto compressed = std::make_shared<std::string>();
+        if (encoding == ContentEncoding::Identity || !compressContent(encoding, json, *compressed) ||
+            compressed->size() >= json.size()) {
+            res.set_content(std::move(json), "application/json");
+            return;
+        }
+        // 通过内容提供器发送，避免 httplib 启用压缩支持时再次压缩
+        res.set_header("Content-Encoding", encodingName(encoding));
+        const size_t length = compressed->size();
+        res.set_content_provider(length, "application/json",
+            [compressed](size_t offset, size_t size, httplib::DataSink& sink) {
+                return sink.write(compressed->data() + offset, size);
+            });
+    }
+
+    /**
+     * @brief 通过 WebAPI 执行命令，响应中合并命令返回的附加结果（如作业编号）
+     */
+    nlohmann::json executeCommand(const nlohmann::json& cmd) {
+        nlohmann::json result = nlohmann::json::object();
+        const bool success = server_.api_->executeCommandWithResult(cmd, result);
+        if (!result.is_object()) {
+            result = nlohmann::json::object();
+        }
+        result["success"] = success;
+        return result;
+    }
+
+    /**
+     * @brief 将轨迹点数组转换为 JSON
+     */
+    static nlohmann::json trajectoryToJson(const std::vector<TrajectoryPoint>& points) {
+        nlohmann::json trajectoryPointsJson = nlohmann::json::array();
+        for (const auto& point : points) {
+            trajectoryPointsJson.push_back({
+                {"seq", point.sequence},
+                {"x", point.x},
+                {"y", point.y},
+                {"z", point.z},
+                {"isRapid", point.isRapid},
+                {"command", point.command}
+            });
+        }
+        return trajectoryPointsJson;
+    }
+
+    /**
+     * @brief 检查客户端是否请求二进制轨迹（?format=binary 或 Accept 头）
+     */
+    static bool wantsBinaryTrajectory(const httplib::Request& req) {
+        if (req.has_param("format")) {
+            return req.get_param_value("format") == "binary";
+        }
+        return req.has_header("Accept") &&
+               req.get_header_value("Accept").find(kBinaryTrajectoryContentType) != std::string::npos;
+    }
+
+    /**
+     * @brief 以分块传输发送二进制轨迹，每块由编码器按需生成
+     */
+    static void sendBinaryTrajectory(httplib::Response& res, std::vector<TrajectoryPoint> points,
+                                     const BinaryTrajectoryHeader& header) {
+        sendBinaryTrajectory(res, std::make_shared<BinaryTrajectoryEncoder>(std::move(points), header));
+    }
+
+    /**
+     * @brief 以分块传输发送编码器生成的二进制轨迹
+     */
+    static void sendBinaryTrajectory(httplib::Response& res, std::shared_ptr<BinaryTrajectoryEncoder> encoder) {
+        res.set_chunked_content_provider(kBinaryTrajectoryContentType,
+            [encoder](size_t, httplib::DataSink& sink) {
+                std::string chunk;
+                if (encoder->nextChunk(chunk)) {
+                    return sink.write(chunk.data(), chunk.size());
+                }
+                sink.done();
+                return true;
+            });
+    }
+
+    /**
+     * @brief 将包围盒转换为 JSON 数组 [minX, minY, minZ, maxX, maxY, maxZ]
+     */
+    static nlohmann::json boundsToJson(const TrajectoryBounds& bounds) {
+        return {bounds.minX, bounds.minY, bounds.minZ, bounds.maxX, bounds.maxY, bounds.maxZ};
+    }
+
+    /**
+     * @brief 获取轨迹金字塔缓存的代数，文件每次上传时递增
+     */
+    uint64_t pyramidGeneration() {
+        std::lock_guard<std::mutex> lock(pyramidMutex_);
+        return pyramidGeneration_;
+    }
+
+    /**
+     * @brief 缓存文件的轨迹金字塔，放在最近使用的位置
+     * @param generation 构建所用的解析开始前的缓存代数，其间有文件上传时解析结果可能已过期，不缓存
+     */
+    void storePyramid(const std::string& filename, std::shared_ptr<const TrajectoryPyramid> pyramid,
+                      uint64_t generation) {
+        std::lock_guard<std::mutex> lock(pyramidMutex_);
+        if (generation != pyramidGeneration_) {
+            return;
+        }
+        erasePyramidLocked(filename);
+        pyramids_.emplace_back(filename, std::move(pyramid));
+        if (pyramids_.size() > kMaxCachedPyramids) {
+            pyramids_.erase(pyramids_.begin());
+        }
+    }
+
+    /**
+     * @brief 移除文件的轨迹金字塔，调用者持有 pyramidMutex_
+     */
+    void erasePyramidLocked(const std::string& filename) {
+        pyramids_.erase(std::remove_if(pyramids_.begin(), pyramids_.end(),
+                                       [&filename](const auto& entry) { return entry.first == filename; }),
+                        pyramids_.end());
+    }
+
+    /**
+     * @brief 获取文件的轨迹金字塔，未缓存时构建；文件重新上传时缓存失效
+     * @param filename 文件名
+     * @param error 失败时的错误信息
+     * @param parsed 调用方已有的解析结果，未缓存时用它构建，为 nullptr 时解析文件
+     * @param generation parsed 的解析开始前由 pyramidGeneration() 取得的缓存代数
+     * @return 轨迹金字塔，失败时返回 nullptr
+     */
+    std::shared_ptr<const TrajectoryPyramid> getPyramid(const std::string& filename, std::string& error,
+                                                        const FileParseResponse* parsed = nullptr,
+                                                        uint64_t generation = 0) {
+        {
+            std::lock_guard<std::mutex> lock(pyramidMutex_);
+            if (!parsed) {
+                generation = pyramidGeneration_;
+            }
+            for (auto it = pyramids_.begin(); it != pyramids_.end(); ++it) {
+                if (it->first == filename) {
+                    auto entry = std::move(*it);
+                    pyramids_.erase(it);
+                    pyramids_.push_back(std::move(entry));
+                    return pyramids_.back().second;
+                }
+            }
+        }
+
+        std::shared_ptr<const FileParseResponse> response;
+        if (!parsed) {
+            response = server_.api_->parseFileShared(filename);
+            parsed = response.get();
+        }
+        if (!parsed->success) {
+            error = parsed->error;
+            return nullptr;
+        }
+        auto pyramid = std::make_shared<const TrajectoryPyramid>(parsed->trajectoryPoints);
+        storePyramid(filename, pyramid, generation);
+        return pyramid;
+    }
+
+    /**
+     * @brief 将状态响应转换为 JSON
+     * @details 不含轨迹点，客户端根据 trajectorySequence 判断是否需要通过 /api/trajectory 增量获取
+     */
+    static nlohmann::json statusToJson(const StatusResponse& status) {
+        nlohmann::json responseJson = stateToJson(status);
+        
+        // 添加machining字段
+        if (status.status == "machining") {
+            responseJson["machining"] = {
+                {"progress", status.progress}
+            };
+        }
+        
+        return responseJson;
+    }
+
+    /**
+     * @brief 将状态响应中除轨迹外的字段转换为 JSON
+     */
+    static nlohmann::json stateToJson(const StatusResponse& status) {
+        nlohmann::json json = {
+            {"channel", status.channel},
+            {"state", status.status},
+            {"position", {
+                {"x", status.position.x},
+                {"y", status.position.y},
+                {"z", status.position.z}
+            }},
+            {"feedRate", status.feedRate},
+            {"progress", status.progress},
+            {"currentLine", status.currentLine},
+            {"currentFile", status.currentFile},
+            {"trajectorySequence", status.trajectorySequence},
+            {"trajectoryCleared", status.trajectoryCleared}
+        };
+        if (status.job.id != 0) {
+            json["job"] = WebAPI::jobToJson(status.job);
+        }
+        if (status.queuedJobs > 0) {
+            json["queuedJobs"] = status.queuedJobs;
+        }
+        return json;
+    }
+
+    /**
+     * @brief 判断状态相对上一次推送是否有变化，位置变化小于死区时视为无变化
+     */
+    static bool stateChanged(const StatusResponse& last, const StatusResponse& current, double deadband) {
+        return last.status != current.status ||
+               last.currentFile != current.currentFile ||
+               last.currentLine != current.currentLine ||
+               last.feedRate != current.feedRate ||
+               last.progress != current.progress ||
+               last.errorCode != current.errorCode ||
+               last.job != current.job ||
+               last.queuedJobs != current.queuedJobs ||
+               std::abs(last.position.x - current.position.x) > deadband ||
+               std::abs(last.position.y - current.position.y) > deadband ||
+               std::abs(last.position.z - current.position.z) > deadband;
+    }
+
+    /**
+     * @brief 按 SSE 格式追加一个事件
+     */
+    static void appendEvent(std::string& events, const char* name, const std::string& data) {
+        events += "event: ";
+        events += name;
+        events += "\ndata: ";
+        events += data;
+        events += "\n\n";
+    }
+
+    /**
+     * @brief 推送连接的一个周期：等待到采样时间，读取状态并发送变化的部分
+     * @return 是否继续推送
+     */
+    bool pushEvents(EventStream& stream, httplib::DataSink& sink) {
+        std::this_thread::sleep_until(stream.nextTick);
+        const auto now = std::chrono::steady_clock::now();
+        stream.nextTick = std::max(stream.nextTick + stream.period, now);
+        if (stopping_ || !server_.api_) {
+            return false;
+        }
+
+        // 状态取自共享的状态文档，所有推送连接和状态请求共用一次采样和序列化
+        auto published = publisher_.acquire(stream.channel, stream.period);
+        if (!published) {
+            return false;
+        }
+
+        std::string events;
+        if (!stream.lastStatus || (published->version != stream.lastStatus->version &&
+                                   stateChanged(stream.lastStatus->status, published->status, server_.getPushDeadband()))) {
+            appendEvent(events, "status", published->json);
+            stream.lastStatus = published;
+        }
+
+        // 只推送序号大于游标的轨迹点，历史被清除时也推送一次，客户端据 cleared 丢弃已清除的点；
+        // 事件 id 为已推送的最新序号，断线重连时浏览器通过 Last-Event-ID 带回。
+        // 状态文档显示轨迹没有变化时不读取轨迹历史
+        if (published->status.trajectorySequence > stream.trajectorySequence ||
+            published->status.trajectoryCleared != stream.trajectoryCleared) {
+            StatusResponse status;
+            if (!server_.api_->getChannelUpdate(stream.channel, stream.trajectorySequence, kMaxTrajectoryBatch, status)) {
+                return false;
+            }
+            if (!status.trajectoryPoints.empty() || status.trajectoryCleared != stream.trajectoryCleared) {
+                if (!status.trajectoryPoints.empty()) {
+                    stream.trajectorySequence = status.trajectoryPoints.back().sequence;
+                }
+                stream.trajectoryCleared = status.trajectoryCleared;
+                events += "id: " + std::to_string(stream.trajectorySequence) + "\n";
+                appendEvent(events, "trajectory", nlohmann::json({
+                    {"channel", status.channel},
+                    {"latest", status.trajectorySequence},
+                    {"cleared", status.trajectoryCleared},
+                    {"points", trajectoryToJson(status.trajectoryPoints)}
+                }).dump());
+            }
+        }
+
+        if (events.empty()) {
+            if (now - stream.lastSent < kEventKeepAlive) {
+                return true;
+            }
+            events = ": keepalive\n\n";
+        }
+        stream.lastSent = now;
+        return sink.write(events.data(), events.size());
+    }
+
     void setupRoutes() {
         // 状态API
-        http_server_.Get("/api/status", [this](const httplib::Request&, httplib::Response& res) {
+        http_server_.Get("/api/status", [this](const httplib::Request& req, httplib::Response& res) {
             try {
                 // 设置响应头
                 res.set_header("Content-Type", "application/json");
@@ -107,51 +528,14 @@ private:
                 if (const auto& callback = server_.getStatusCallback(); callback) {
                     res.set_content((*callback)().dump(), "application/json");
                 } else if (server_.api_) {
-                    auto status = server_.api_->getSystemStatus();
-                    
-                    // 构建轨迹点数组
-                    nlohmann::json trajectoryPointsJson = nlohmann::json::array();
-                    
-                    // 如果有轨迹点，添加到JSON数组
-                    if (!status.trajectoryPoints.empty()) {
-                        spdlog::info("发现 {} 个轨迹点", status.trajectoryPoints.size());
-                        for (const auto& point : status.trajectoryPoints) {
-                            trajectoryPointsJson.push_back({
-                                {"x", point.x},
-                                {"y", point.y},
-                                {"z", point.z},
-                                {"isRapid", point.isRapid},
-                                {"command", point.command}
-                            });
-                        }
+                    // 通道0的共享状态文档，每个发布周期只采样和序列化一次
+                    auto published = publisher_.acquire(0, publishPeriod());
+                    if (!published) {
+                        res.status = 500;
+                        res.set_content(R"({"error":"Status unavailable"})", "application/json");
+                        return;
                     }
-                    
-                    // 生成JSON响应
-                    nlohmann::json responseJson = {
-                        {"state", status.status},
-                        {"position", {
-                            {"x", status.position.x},
-                            {"y", status.position.y},
-                            {"z", status.position.z}
-                        }},
-                        {"feedRate", status.feedRate},
-                        {"progress", status.progress},
-                        {"currentFile", status.currentFile}
-                    };
-                    
-                    // 添加machining字段，包含轨迹点
-                    if (status.status == "machining" || !trajectoryPointsJson.empty()) {
-                        responseJson["machining"] = {
-                            {"progress", status.progress},
-                            {"trajectoryPoints", trajectoryPointsJson}
-                        };
-                    }
-                    
-                    // 输出调试信息
-                    spdlog::info("状态API响应: {}", responseJson.dump());
-                    
-                    // 设置响应内容
-                    res.set_content(responseJson.dump(), "application/json");
+                    sendPublishedStatus(req, res, std::move(published));
                 } else {
                     res.status = 503;
                     res.set_content(R"({"error":"Service unavailable"})", "application/json");
@@ -163,6 +547,125 @@ private:
             }
         });
 
+        // 增量轨迹API：返回序号大于 since 的轨迹点，more 为 true 时还有后续点；?format=binary 时返回二进制轨迹
+        http_server_.Get("/api/trajectory", [this](const httplib::Request& req, httplib::Response& res) {
+            if (!server_.api_) {
+                res.status = 503;
+                res.set_content(R"({"error":"Service unavailable"})", "application/json");
+                return;
+            }
+
+            int channel = 0;
+            uint64_t since = 0;
+            size_t limit = kMaxTrajectoryBatch;
+            try {
+                if (req.has_param("channel")) {
+                    channel = std::stoi(req.get_param_value("channel"));
+                }
+                if (req.has_param("since")) {
+                    since = std::stoull(req.get_param_value("since"));
+                }
+                if (req.has_param("limit")) {
+                    limit = std::min<size_t>(std::stoull(req.get_param_value("limit")), kMaxTrajectoryBatch);
+                }
+            } catch (const std::exception&) {
+                res.status = 400;
+                res.set_content(R"({"error":"Invalid channel, since or limit"})", "application/json");
+                return;
+            }
+
+            try {
+                StatusResponse status;
+                if (!server_.api_->getChannelUpdate(channel, since, limit, status)) {
+                    res.status = 404;
+                    res.set_content(R"({"error":"Channel not found"})", "application/json");
+                    return;
+                }
+                const uint64_t last = status.trajectoryPoints.empty() ? since : status.trajectoryPoints.back().sequence;
+                const bool more = last < status.trajectorySequence && !status.trajectoryPoints.empty();
+                if (wantsBinaryTrajectory(req)) {
+                    BinaryTrajectoryHeader header;
+                    header.channel = status.channel;
+                    header.firstSequence = status.trajectoryPoints.empty() ? 0 : status.trajectoryPoints.front().sequence;
+                    header.latestSequence = status.trajectorySequence;
+                    header.clearedSequence = status.trajectoryCleared;
+                    header.more = more;
+                    sendBinaryTrajectory(res, std::move(status.trajectoryPoints), header);
+                    return;
+                }
+                nlohmann::json responseJson = {
+                    {"channel", status.channel},
+                    {"since", since},
+                    {"latest", status.trajectorySequence},
+                    {"cleared", status.trajectoryCleared},
+                    {"more", more},
+                    {"points", trajectoryToJson(status.trajectoryPoints)}
+                };
+                sendJson(req, res, responseJson.dump());
+            } catch (const std::exception& e) {
+                res.status = 500;
+                res.set_content(R"({"error":"Internal server error","message":")" + std::string(e.what()) + "\"}", "application/json");
+                spdlog::error("Trajectory error: {}", e.what());
+            }
+        });
+
+        // 状态推送API（SSE）：按配置频率采样，只在状态变化时推送状态，轨迹只推送新增点
+        http_server_.Get("/api/events", [this](const httplib::Request& req, httplib::Response& res) {
+            if (!server_.api_) {
+                res.status = 503;
+                res.set_content(R"({"error":"Service unavailable"})", "application/json");
+                return;
+            }
+
+            auto stream = std::make_shared<EventStream>();
+            double rate = server_.getPushRate();
+            try {
+                if (req.has_param("channel")) {
+                    stream->channel = std::stoi(req.get_param_value("channel"));
+                }
+                if (req.has_param("rate")) {
+                    rate = std::stod(req.get_param_value("rate"));
+                }
+                if (req.has_header("Last-Event-ID")) {
+                    stream->trajectorySequence = std::stoull(req.get_header_value("Last-Event-ID"));
+                } else if (req.has_param("since")) {
+                    stream->trajectorySequence = std::stoull(req.get_param_value("since"));
+                }
+            } catch (const std::exception&) {
+                res.status = 400;
+                res.set_content(R"({"error":"Invalid channel, rate or since"})", "application/json");
+                return;
+            }
+            if (stream->channel < 0 || static_cast<size_t>(stream->channel) >= server_.api_->getChannelCount()) {
+                res.status = 404;
+                res.set_content(R"({"error":"Channel not found"})", "application/json");
+                return;
+            }
+            if (eventStreams_.fetch_add(1) >= kMaxEventStreams) {
+                eventStreams_.fetch_sub(1);
+                res.status = 503;
+                res.set_content(R"({"error":"Too many event streams"})", "application/json");
+                return;
+            }
+
+            rate = std::min(std::max(rate, 1.0), 100.0);
+            stream->period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(1.0 / rate));
+            stream->nextTick = std::chrono::steady_clock::now();
+            stream->lastSent = stream->nextTick;
+            spdlog::info("打开状态推送连接，通道: {}，频率: {} Hz", stream->channel, rate);
+
+            res.set_header("Cache-Control", "no-cache");
+            res.set_chunked_content_provider("text/event-stream",
+                [this, stream](size_t /* offset */, httplib::DataSink& sink) {
+                    return pushEvents(*stream, sink);
+                },
+                [this](bool /* success */) {
+                    eventStreams_.fetch_sub(1);
+                    spdlog::info("关闭状态推送连接");
+                });
+        });
+
         // 命令API
         http_server_.Post("/api/command", [this](const httplib::Request& req, httplib::Response& res) {
             try {
@@ -188,8 +691,7 @@ private:
                     auto response = (*callback)(cmd);
                     res.set_content(response.dump(), "application/json");
                 } else if (server_.api_) {
-                    bool success = server_.api_->executeCommand(cmd);
-                    res.set_content(nlohmann::json{{"success", success}}.dump(), "application/json");
+                    res.set_content(executeCommand(cmd).dump(), "application/json");
                 } else {
                     res.status = 503;
                     res.set_content(R"({"error":"Service unavailable"})", "application/json");
@@ -205,6 +707,71 @@ private:
             }
         });
 
+        // 通道列表API
+        http_server_.Get("/api/channels", [this](const httplib::Request&, httplib::Response& res) {
+            if (!server_.api_) {
+                res.status = 503;
+                res.set_content(R"({"error":"Service unavailable"})", "application/json");
+                return;
+            }
+            nlohmann::json channels = nlohmann::json::array();
+            for (size_t i = 0; i < server_.api_->getChannelCount(); ++i) {
+                channels.push_back(i);
+            }
+            res.set_content(nlohmann::json{{"channels", channels}}.dump(), "application/json");
+        });
+
+        // 通道状态API
+        http_server_.Get(R"(/api/channels/(\d+)/status)", [this](const httplib::Request& req, httplib::Response& res) {
+            try {
+                if (!server_.api_) {
+                    res.status = 503;
+                    res.set_content(R"({"error":"Service unavailable"})", "application/json");
+                    return;
+                }
+                auto published = publisher_.acquire(std::stoi(req.matches[1]), publishPeriod());
+                if (!published) {
+                    res.status = 404;
+                    res.set_content(R"({"error":"Channel not found"})", "application/json");
+                    return;
+                }
+                sendPublishedStatus(req, res, std::move(published));
+            } catch (const std::exception& e) {
+                res.status = 500;
+                res.set_content(R"({"error":"Internal server error","message":")" + std::string(e.what()) + "\"}", "application/json");
+                spdlog::error("Channel status error: {}", e.what());
+            }
+        });
+
+        // 通道命令API，等同于在命令中指定 channel 字段
+        http_server_.Post(R"(/api/channels/(\d+)/command)", [this](const httplib::Request& req, httplib::Response& res) {
+            try {
+                nlohmann::json cmd = nlohmann::json::parse(req.body);
+                if (!cmd.is_object() || !cmd.contains("command") || !cmd["command"].is_string()) {
+                    res.status = 400;
+                    res.set_content(R"({"error":"Invalid request format. 'command' field is required and must be a string."})", "application/json");
+                    return;
+                }
+                cmd["channel"] = std::stoi(req.matches[1]);
+
+                if (const auto& callback = server_.getCommandCallback(); callback) {
+                    res.set_content((*callback)(cmd).dump(), "application/json");
+                } else if (server_.api_) {
+                    res.set_content(executeCommand(cmd).dump(), "application/json");
+                } else {
+                    res.status = 503;
+                    res.set_content(R"({"error":"Service unavailable"})", "application/json");
+                }
+            } catch (const nlohmann::json::parse_error& e) {
+                res.status = 400;
+                res.set_content(R"({"error":"Invalid JSON format","message":")" + std::string(e.what()) + "\"}", "application/json");
+            } catch (const std::exception& e) {
+                res.status = 500;
+                res.set_content(R"({"error":"Internal server error","message":")" + std::string(e.what()) + "\"}", "application/json");
+                spdlog::error("Channel command error: {}", e.what());
+            }
+        });
+
         // 文件列表API
         http_server_.Get("/api/files", [this](const httplib::Request& req, httplib::Response& res) {
             try {
@@ -214,7 +781,7 @@ private:
                         path = "/";
                     }
                     auto response = (*callback)(path);
-                    res.set_content(response.dump(), "application/json");
+                    sendJson(req, res, response.dump());
                 } else if (server_.api_) {
                     auto path = req.get_param_value("path");
                     if (path.empty()) {
@@ -234,7 +801,7 @@ private:
                     for (const auto& error : files.errors) {
                         response["errors"].push_back(error);
                     }
-                    res.set_content(response.dump(), "application/json");
+                    sendJson(req, res, response.dump());
                 } else {
                     res.status = 503;
                     res.set_content(R"({"error":"Service unavailable"})", "application/json");
@@ -286,6 +853,11 @@ private:
                     res.set_content(response.dump(), "application/json");
                 } else if (server_.api_) {
                     auto response = server_.api_->uploadFile(filename, file.content);
+                    {
+                        std::lock_guard<std::mutex> lock(pyramidMutex_);
+                        erasePyramidLocked(filename);
+                        ++pyramidGeneration_;
+                    }
                     nlohmann::json json_response = {
                         {"success", response.success}
                     };
@@ -305,16 +877,31 @@ private:
             }
         });
 
-        // 文件解析API
+        // 文件解析API，?format=binary 时返回二进制轨迹
         http_server_.Get(R"(/api/files/([^/]+)/parse)", [this](const httplib::Request& req, httplib::Response& res) {
             try {
                 std::string filename = req.matches[1];
                 spdlog::info("解析文件: {}", filename);
                 if (const auto& callback = server_.getFileParseCallback(); callback) {
                     auto response = (*callback)(filename);
-                    res.set_content(response.dump(), "application/json");
+                    sendJson(req, res, response.dump());
                 } else if (server_.api_) {
-                    auto response = server_.api_->parseFile(filename);
+                    // 解析结果可能由缓存共享，只读使用，不复制
+                    const uint64_t generation = pyramidGeneration();
+                    const auto shared = server_.api_->parseFileShared(filename);
+                    const FileParseResponse& response = *shared;
+                    if (response.success) {
+                        // 解析时预先构建轨迹金字塔，供 /lod 按视口查询；已缓存时不重复构建
+                        std::string error;
+                        getPyramid(filename, error, &response, generation);
+                    }
+                    if (response.success && wantsBinaryTrajectory(req)) {
+                        // 二进制格式只含轨迹点，刀路详情等仍通过 JSON 格式获取
+                        std::shared_ptr<const std::vector<TrajectoryPoint>> points(shared, &response.trajectoryPoints);
+                        sendBinaryTrajectory(res, std::make_shared<BinaryTrajectoryEncoder>(std::move(points),
+                                                                                            BinaryTrajectoryHeader()));
+                        return;
+                    }
                     nlohmann::json json_response = {
                         {"success", response.success},
                         {"toolPathDetails", response.toolPathDetails}
@@ -333,7 +920,7 @@ private:
                             });
                         }
                     }
-                    res.set_content(json_response.dump(), "application/json");
+                    sendJson(req, res, json_response.dump());
                 } else {
                     res.status = 503;
                     res.set_content(R"({"error":"Service unavailable"})", "application/json");
@@ -345,6 +932,133 @@ private:
             }
         });
 
+        // 轨迹细节层次API：按视口（minX、minY、maxX、maxY）和像素大小（pixel，mm）选择层，
+        // 返回与视口相交的瓦片列表，瓦片的点通过 /lod/{level}/{tile} 获取
+        http_server_.Get(R"(/api/files/([^/]+)/lod)", [this](const httplib::Request& req, httplib::Response& res) {
+            if (!server_.api_) {
+                res.status = 503;
+                res.set_content(R"({"error":"Service unavailable"})", "application/json");
+                return;
+            }
+
+            try {
+                std::string filename = req.matches[1];
+                std::string error;
+                auto pyramid = getPyramid(filename, error);
+                if (!pyramid) {
+                    res.status = 404;
+                    res.set_content(nlohmann::json({{"error", error}}).dump(), "application/json");
+                    return;
+                }
+
+                TrajectoryBounds viewport = pyramid->getBounds();
+                double pixel = std::max(viewport.maxX - viewport.minX, viewport.maxY - viewport.minY) / kDefaultLodResolution;
+                try {
+                    if (req.has_param("minX")) {
+                        viewport.minX = std::stod(req.get_param_value("minX"));
+                    }
+                    if (req.has_param("minY")) {
+                        viewport.minY = std::stod(req.get_param_value("minY"));
+                    }
+                    if (req.has_param("maxX")) {
+                        viewport.maxX = std::stod(req.get_param_value("maxX"));
+                    }
+                    if (req.has_param("maxY")) {
+                        viewport.maxY = std::stod(req.get_param_value("maxY"));
+                    }
+                    if (req.has_param("pixel")) {
+                        pixel = std::stod(req.get_param_value("pixel"));
+                    }
+                } catch (const std::exception&) {
+                    res.status = 400;
+                    res.set_content(R"({"error":"Invalid viewport or pixel"})", "application/json");
+                    return;
+                }
+
+                const size_t level = pyramid->selectLevel(pixel);
+                const TrajectoryPyramid::Level& selected = pyramid->getLevel(level);
+                nlohmann::json levelsJson = nlohmann::json::array();
+                for (size_t i = 0; i < pyramid->getLevelCount(); ++i) {
+                    const TrajectoryPyramid::Level& info = pyramid->getLevel(i);
+                    levelsJson.push_back({
+                        {"tolerance", info.tolerance},
+                        {"points", info.points.size()},
+                        {"tiles", info.tiles.size()}
+                    });
+                }
+                nlohmann::json tilesJson = nlohmann::json::array();
+                for (size_t index : pyramid->queryTiles(level, viewport)) {
+                    const TrajectoryPyramid::Tile& tile = selected.tiles[index];
+                    tilesJson.push_back({
+                        {"index", index},
+                        {"bounds", boundsToJson(tile.bounds)},
+                        {"count", tile.end - tile.begin + 1}
+                    });
+                }
+                nlohmann::json responseJson = {
+                    {"file", filename},
+                    {"bounds", boundsToJson(pyramid->getBounds())},
+                    {"levels", levelsJson},
+                    {"level", level},
+                    {"tolerance", selected.tolerance},
+                    {"tiles", tilesJson}
+                };
+                sendJson(req, res, responseJson.dump());
+            } catch (const std::exception& e) {
+                res.status = 500;
+                res.set_content(R"({"error":"Internal server error","message":")" + std::string(e.what()) + "\"}", "application/json");
+                spdlog::error("LOD error: {}", e.what());
+            }
+        });
+
+        // 轨迹瓦片API：返回指定层和瓦片的点，内容在文件重新上传前不变；?format=binary 时返回二进制轨迹
+        http_server_.Get(R"(/api/files/([^/]+)/lod/(\d+)/(\d+))", [this](const httplib::Request& req, httplib::Response& res) {
+            if (!server_.api_) {
+                res.status = 503;
+                res.set_content(R"({"error":"Service unavailable"})", "application/json");
+                return;
+            }
+
+            try {
+                std::string filename = req.matches[1];
+                std::string error;
+                auto pyramid = getPyramid(filename, error);
+                if (!pyramid) {
+                    res.status = 404;
+                    res.set_content(nlohmann::json({{"error", error}}).dump(), "application/json");
+                    return;
+                }
+
+                const size_t level = std::stoul(req.matches[2]);
+                const size_t index = std::stoul(req.matches[3]);
+                if (level >= pyramid->getLevelCount() || index >= pyramid->getLevel(level).tiles.size()) {
+                    res.status = 404;
+                    res.set_content(R"({"error":"Tile not found"})", "application/json");
+                    return;
+                }
+
+                const TrajectoryPyramid::Level& selected = pyramid->getLevel(level);
+                const TrajectoryPyramid::Tile& tile = selected.tiles[index];
+                std::vector<TrajectoryPoint> points(selected.points.begin() + static_cast<std::ptrdiff_t>(tile.begin),
+                                                    selected.points.begin() + static_cast<std::ptrdiff_t>(tile.end) + 1);
+                if (wantsBinaryTrajectory(req)) {
+                    sendBinaryTrajectory(res, std::move(points), BinaryTrajectoryHeader());
+                    return;
+                }
+                nlohmann::json responseJson = {
+                    {"level", level},
+                    {"index", index},
+                    {"bounds", boundsToJson(tile.bounds)},
+                    {"points", trajectoryToJson(points)}
+                };
+                sendJson(req, res, responseJson.dump());
+            } catch (const std::exception& e) {
+                res.status = 500;
+                res.set_content(R"({"error":"Internal server error","message":")" + std::string(e.what()) + "\"}", "application/json");
+                spdlog::error("LOD tile error: {}", e.what());
+            }
+        });
+
         // 配置API - 没有实现
         http_server_.Get("/api/config", [this](const httplib::Request&, httplib::Response& res) {
             try {
@@ -367,7 +1081,15 @@ private:
     WebServer& server_;
     httplib::Server http_server_;
     std::string static_dir_;
+    StaticAssets static_assets_;
+    bool static_loaded_ = false;
     bool enable_cors_ = false;
+    std::atomic<bool> stopping_{false};
+    std::atomic<int> eventStreams_{0};
+    StatusPublisher publisher_;
+    std::mutex pyramidMutex_;
+    std::vector<std::pair<std::string, std::shared_ptr<const TrajectoryPyramid>>> pyramids_;  ///< 轨迹金字塔缓存，最近使用的在末尾
+    uint64_t pyramidGeneration_ = 0;  ///< 轨迹金字塔缓存代数，文件上传时递增
     std::optional<WebServer::StatusCallback> status_callback_;
     std::optional<WebServer::CommandCallback> command_callback_;
     std::optional<WebServer::FileUploadCallback> file_upload_callback_;
@@ -2,15 +2,27 @@
 // 全局变量
 let statusUpdateInterval;
 let trajectoryUpdateInterval;
+let eventSource = null;
+let lastPushedState = null;
+let lastFailedJobId = 0;
 let currentDrawingTool = null;
 let drawingPoints = [];
 let isDrawing = false;
 let cachedTrajectoryPoints = [];
 let lastTrajectoryUpdateTime = 0;
 
+// 轨迹细节层次：当前文件、已加载的瓦片（键为 "层/瓦片"）和视图变化后的延迟刷新
+let lodFile = null;
+let lodTileCache = new Map();
+let lodRefreshTimer = null;
+const LOD_REFRESH_DELAY = 200;
+const LOD_TILE_CACHE_LIMIT = 256;
+
 // API 端点
 const API = {
     STATUS: '/api/status',
+    EVENTS: '/api/events',
+    TRAJECTORY: '/api/trajectory',
     COMMAND: '/api/command',
     CONFIG: '/api/config',
     FILES: '/api/files'
@@ -311,17 +323,17 @@ async function startMachining() {
         // 发送开始加工命令到后端
         console.log(`准备发送motion.start命令，文件名: ${currentFile}`);
         const result = await sendCommand('motion.start', { filename: currentFile });
-        console.log(`motion.start命令执行结果: ${result ? '成功' : '失败'}`);
+        console.log(`motion.start命令执行结果: ${result && result.success ? '成功' : '失败'}`);
         
-        if (result) {
-            // 更新 UI 状态
-            document.getElementById('status').textContent = '加工中';
+        if (result && result.success) {
+            // 文件在后台解析和规划，完成后自动开始运动
+            document.getElementById('status').textContent = 'preparing';
             
             // 开始定时更新状态和轨迹
             console.log("开始定时更新状态和轨迹");
             startProgressUpdate();
             
-            logMessage('[加工] 加工命令已发送，开始执行', 'success');
+            logMessage(`[加工] 作业 ${result.jobId} 已提交，正在解析和规划`, 'success');
             return true;
         } else {
             console.error("开始加工命令发送失败");
@@ -411,6 +423,12 @@ function startProgressUpdate() {
         progressUpdateInterval = null;
     }
     
+    // 状态推送连接已建立时由推送事件更新进度，无需轮询
+    if (eventSource) {
+        console.log("使用状态推送更新进度");
+        return;
+    }
+    
     // 立即更新一次状态
     updateMachiningStatus();
     
@@ -567,16 +585,24 @@ async function parseFile(filename) {
     logMessage(`[文件] 开始解析：${filename}`, 'info');
     
     try {
-        // 模拟文件解析成功
-        console.log("模拟文件解析成功");
-        logMessage(`[文件] 解析成功：${filename}`, 'info');
-        
-        // 生成测试轨迹点
-        const testTrajectoryPoints = generateTestTrajectory();
-        
-        // 绘制轨迹
-        drawTrajectory(testTrajectoryPoints);
+        // 服务器在解析时构建多分辨率金字塔，这里只加载与当前视图匹配的层和瓦片
+        const lod = await loadToolpathLod(filename);
+        console.log(`文件解析成功，轨迹点数：${lod.levels[0].points}，显示第 ${lod.level} 层`);
+        logMessage(`[文件] 解析成功：${filename}，${lod.levels[0].points} 个轨迹点`, 'info');
         
+        if (window.trajectoryViewer) {
+            const b = lod.bounds;
+            window.trajectoryViewer.fitBoundingBox(new THREE.Box3(
+                new THREE.Vector3(b[0], b[1], b[2]), new THREE.Vector3(b[3], b[4], b[5])));
+            
+            // 缩放或平移后按新的视口重新选择层和瓦片
+            window.trajectoryViewer.onViewChange = viewport => {
+                clearTimeout(lodRefreshTimer);
+                lodRefreshTimer = setTimeout(() => {
+                    loadToolpathLod(filename, viewport).catch(error => console.error("加载轨迹瓦片失败：", error));
+                }, LOD_REFRESH_DELAY);
+            };
+        }
         return true;
     } catch (error) {
         console.error("文件解析失败：", error);
@@ -585,6 +611,119 @@ async function parseFile(filename) {
     }
 }
 
+// 解码二进制轨迹（格式见 TrajectoryCodec.h），返回各数组的视图而不复制数据
+function decodeBinaryTrajectory(buffer) {
+    const view = new DataView(buffer);
+    if (buffer.byteLength < 40 || view.getUint32(0, true) !== 0x4A545858 || view.getUint16(4, true) !== 2) {
+        throw new Error('无效的二进制轨迹数据');
+    }
+    
+    const count = view.getUint32(8, true);
+    const flags = view.getUint16(6, true);
+    const flagsOffset = 40 + count * 12;
+    const linesOffset = flagsOffset + ((count + 3) & ~3);
+    const sequencesOffset = linesOffset + count * 4;
+    const hasSequences = (flags & 2) !== 0;
+    if (buffer.byteLength !== sequencesOffset + (hasSequences ? count * 8 : 0)) {
+        throw new Error('二进制轨迹数据长度不正确');
+    }
+    
+    // 轨迹历史抽稀后序号不连续，逐点读取序号
+    const sequences = new Array(hasSequences ? count : 0);
+    for (let i = 0; i < sequences.length; i++) {
+        sequences[i] = Number(view.getBigUint64(sequencesOffset + i * 8, true));
+    }
+    
+    // 各数组按 4 字节对齐，数据为小端序，与浏览器所在平台的字节序一致
+    return {
+        count: count,
+        more: (flags & 1) !== 0,
+        channel: view.getInt32(12, true),
+        firstSequence: Number(view.getBigUint64(16, true)),
+        latest: Number(view.getBigUint64(24, true)),
+        cleared: Number(view.getBigUint64(32, true)),
+        positions: new Float32Array(buffer, 40, count * 3),
+        flags: new Uint8Array(buffer, flagsOffset, count),
+        lineNumbers: new Int32Array(buffer, linesOffset, count),
+        sequences: sequences
+    };
+}
+
+// 按视口加载轨迹瓦片并绘制；viewport 为空时加载整个轨迹的概览
+async function loadToolpathLod(filename, viewport) {
+    const base = `${API.FILES}/${encodeURIComponent(filename)}/lod`;
+    const query = viewport ?
+        `?minX=${viewport.minX}&minY=${viewport.minY}&maxX=${viewport.maxX}&maxY=${viewport.maxY}&pixel=${viewport.pixel}` : '';
+    const response = await fetch(base + query);
+    if (!response.ok) {
+        const error = await response.json().catch(() => ({}));
+        throw new Error(error.error || `HTTP 状态码 ${response.status}`);
+    }
+    const lod = await response.json();
+    
+    if (filename !== lodFile) {
+        lodFile = filename;
+        lodTileCache = new Map();
+    }
+    
+    // 瓦片内容在文件重新上传前不变，已加载的瓦片直接复用
+    const tiles = await Promise.all(lod.tiles.map(async tile => {
+        const id = `${lod.level}/${tile.index}`;
+        if (!lodTileCache.has(id)) {
+            const tileResponse = await fetch(`${base}/${lod.level}/${tile.index}?format=binary`);
+            if (!tileResponse.ok) {
+                throw new Error(`获取轨迹瓦片失败，HTTP 状态码 ${tileResponse.status}`);
+            }
+            lodTileCache.set(id, decodeBinaryTrajectory(await tileResponse.arrayBuffer()).positions);
+        }
+        return { id, positions: lodTileCache.get(id) };
+    }));
+    
+    // 加载期间切换了文件时丢弃结果
+    if (filename !== lodFile) {
+        return lod;
+    }
+    if (lodTileCache.size > LOD_TILE_CACHE_LIMIT) {
+        const visible = new Set(tiles.map(tile => tile.id));
+        for (const id of lodTileCache.keys()) {
+            if (!visible.has(id)) {
+                lodTileCache.delete(id);
+            }
+        }
+    }
+    
+    drawTrajectoryTiles(tiles);
+    return lod;
+}
+
+// 绘制轨迹瓦片，每个瓦片的坐标为 Float32Array（x、y、z 交错）
+function drawTrajectoryTiles(tiles) {
+    if (window.trajectoryViewer) {
+        window.trajectoryViewer.showTiles(tiles);
+    }
+    
+    const canvas = document.getElementById('trajectoryCanvas');
+    if (!canvas) {
+        return;
+    }
+    const ctx = canvas.getContext('2d');
+    ctx.clearRect(0, 0, canvas.width, canvas.height);
+    drawGrid(ctx, canvas.width, canvas.height);
+    
+    ctx.beginPath();
+    ctx.strokeStyle = '#00FFFF';
+    ctx.lineWidth = 2;
+    for (const tile of tiles) {
+        const positions = tile.positions;
+        if (positions.length < 6) continue;
+        ctx.moveTo(positions[0] * 10 + canvas.width / 2, canvas.height / 2 - positions[1] * 10);
+        for (let i = 3; i < positions.length; i += 3) {
+            ctx.lineTo(positions[i] * 10 + canvas.width / 2, canvas.height / 2 - positions[i + 1] * 10);
+        }
+    }
+    ctx.stroke();
+}
+
 // 发送命令到后端
 async function sendCommand(command, params = {}) {
     try {
@@ -621,7 +760,8 @@ async function sendCommand(command, params = {}) {
             if (response.ok) {
                 console.log(`命令 ${command} 执行成功`);
                 logMessage(`[命令] 命令执行成功：${command}`, 'success');
-                return true;
+                // 返回响应数据，异步命令的作业编号等附加结果在其中
+                return data;
             } else {
                 console.error(`命令 ${command} 执行失败:`, data.error || '未知错误');
                 throw new Error(data.error || '命令执行失败');
@@ -646,6 +786,12 @@ function startStatusUpdates() {
     // 清除可能存在的旧定时器
     stopStatusUpdates();
     
+    // 浏览器支持 SSE 时由服务器推送状态变化和新增轨迹点
+    if (window.EventSource) {
+        startEventStream();
+        return;
+    }
+    
     // 每秒更新一次状态
     statusUpdateInterval = setInterval(updateSystemStatus, 1000);
     console.log("状态更新定时器已设置");
@@ -657,8 +803,109 @@ function startStatusUpdates() {
     logMessage('[系统] 开始定时更新状态和轨迹', 'info');
 }
 
+// 打开状态推送连接
+function startEventStream() {
+    console.log("打开状态推送连接...");
+    eventSource = new EventSource(API.EVENTS);
+    
+    // 状态只在变化时推送
+    eventSource.addEventListener('status', event => {
+        const data = JSON.parse(event.data);
+        updateStatusDisplay(data);
+        
+        if (lastPushedState === 'machining' && data.state !== 'machining') {
+            logMessage('[加工] 加工已完成', 'success');
+        }
+        lastPushedState = data.state;
+    });
+    
+    // 轨迹只推送序号大于已推送游标的点
+    eventSource.addEventListener('trajectory', event => {
+        const data = JSON.parse(event.data);
+        appendTrajectoryPoints(data.points, data.cleared);
+    });
+    
+    eventSource.onopen = () => {
+        logMessage('[系统] 状态推送已连接', 'info');
+    };
+    
+    // 连接断开后浏览器会自动重连，重连后服务器从头推送轨迹
+    eventSource.onerror = () => {
+        console.warn("状态推送连接中断，等待重连");
+    };
+}
+
+// 追加新的轨迹点，只绘制新增的线段；cleared 为服务器最近一次清除轨迹时的最新序号
+function appendTrajectoryPoints(points, cleared) {
+    const lastSequence = cachedTrajectoryPoints.length > 0 ?
+        cachedTrajectoryPoints[cachedTrajectoryPoints.length - 1].seq : 0;
+    
+    // 跳过已有的点（断线重连后可能重复推送）
+    points = points.filter(point => point.seq > lastSequence);
+    
+    // 轨迹历史被清除时丢弃已清除的点并整体重绘
+    if (cachedTrajectoryPoints.length > 0 && cachedTrajectoryPoints[0].seq <= cleared) {
+        cachedTrajectoryPoints = cachedTrajectoryPoints.filter(point => point.seq > cleared).concat(points);
+        if (cachedTrajectoryPoints.length > 1) {
+            drawTrajectory(cachedTrajectoryPoints);
+        } else {
+            if (window.trajectoryViewer) {
+                window.trajectoryViewer.clear();
+            }
+            const canvas = document.getElementById('trajectoryCanvas');
+            if (canvas) {
+                const ctx = canvas.getContext('2d');
+                ctx.clearRect(0, 0, canvas.width, canvas.height);
+                drawGrid(ctx, canvas.width, canvas.height);
+            }
+        }
+        return;
+    }
+    
+    if (cachedTrajectoryPoints.length === 0) {
+        cachedTrajectoryPoints = points;
+        if (points.length > 1) {
+            drawTrajectory(cachedTrajectoryPoints);
+        }
+        return;
+    }
+    
+    if (points.length === 0) {
+        return;
+    }
+    
+    const previous = cachedTrajectoryPoints[cachedTrajectoryPoints.length - 1];
+    for (const point of points) {
+        cachedTrajectoryPoints.push(point);
+    }
+    
+    if (window.trajectoryViewer) {
+        window.trajectoryViewer.appendPoints(points);
+    }
+    
+    // 在2D画布上从上一个点接着绘制
+    const canvas = document.getElementById('trajectoryCanvas');
+    if (!canvas) {
+        return;
+    }
+    const ctx = canvas.getContext('2d');
+    ctx.beginPath();
+    ctx.strokeStyle = '#00FFFF';
+    ctx.lineWidth = 2;
+    ctx.moveTo(previous.x * 10 + canvas.width / 2, canvas.height / 2 - previous.y * 10);
+    for (const point of points) {
+        ctx.lineTo(point.x * 10 + canvas.width / 2, canvas.height / 2 - point.y * 10);
+    }
+    ctx.stroke();
+}
+
 // 停止更新状态
 function stopStatusUpdates() {
+    if (eventSource) {
+        eventSource.close();
+        eventSource = null;
+    }
+    
     if (statusUpdateInterval) {
         clearInterval(statusUpdateInterval);
         statusUpdateInterval = null;
@@ -702,56 +949,34 @@ async function updateSystemStatus() {
     }
 }
 
-// 更新轨迹
+// 更新轨迹：按序号游标增量获取新的轨迹点
 async function updateTrajectory() {
     try {
-        console.log("开始获取轨迹...");
-        const response = await fetch(API.STATUS);
-        
-        if (!response.ok) {
-            console.error("获取轨迹失败，HTTP 状态码：", response.status);
-            return;
-        }
-        
-        const text = await response.text();
-        console.log("轨迹 API 响应文本长度：", text.length);
-        
-        try {
-            const data = JSON.parse(text);
-            console.log("解析后的轨迹数据：", data);
+        let more = true;
+        while (more) {
+            const since = cachedTrajectoryPoints.length > 0 ?
+                cachedTrajectoryPoints[cachedTrajectoryPoints.length - 1].seq : 0;
+            const response = await fetch(`${API.TRAJECTORY}?since=${since}&format=binary`);
             
-            if (data) {
-                // 直接检查 trajectoryPoints 字段
-                if (data.trajectoryPoints && data.trajectoryPoints.length > 0) {
-                    console.log(`获取到 ${data.trajectoryPoints.length} 个轨迹点，准备绘制`);
-                    console.log("轨迹点示例：", data.trajectoryPoints.slice(0, Math.min(5, data.trajectoryPoints.length)));
-                    
-                    // 确保轨迹点有效
-                    const validPoints = data.trajectoryPoints.filter(point => 
-                        typeof point.x === 'number' && 
-                        typeof point.y === 'number' && 
-                        typeof point.z === 'number');
-                    
-                    if (validPoints.length > 0) {
-                        console.log(`有效轨迹点：${validPoints.length} 个，开始绘制`);
-                        drawTrajectory(validPoints);
-                    } else {
-                        console.warn("没有有效的轨迹点可以绘制");
-                        console.warn("无效轨迹点示例：", data.trajectoryPoints.slice(0, Math.min(5, data.trajectoryPoints.length)));
-                    }
-                } else {
-                    console.log("没有轨迹点数据");
-                    if (data.trajectoryPoints) {
-                        console.log("轨迹点数组为空");
-                    } else {
-                        console.log("响应中没有 trajectoryPoints 字段");
-                    }
-                }
-            } else {
-                console.error("轨迹数据为空");
+            if (!response.ok) {
+                console.error("获取轨迹失败，HTTP 状态码：", response.status);
+                return;
             }
-        } catch (jsonError) {
-            console.error("解析 JSON 失败：", jsonError, "原始文本：", text);
+            
+            const data = decodeBinaryTrajectory(await response.arrayBuffer());
+            const points = new Array(data.count);
+            for (let i = 0; i < data.count; i++) {
+                points[i] = {
+                    seq: data.sequences[i],
+                    x: data.positions[i * 3],
+                    y: data.positions[i * 3 + 1],
+                    z: data.positions[i * 3 + 2],
+                    isRapid: (data.flags[i] & 1) !== 0
+                };
+            }
+            console.log(`获取到 ${data.count} 个新轨迹点，最新序号：${data.latest}`);
+            appendTrajectoryPoints(points, data.cleared);
+            more = data.more;
         }
     } catch (error) {
         console.error('获取轨迹时出错：', error);
@@ -778,10 +1003,15 @@ async function clearTrajectory() {
         
         if (result) {
             logMessage('[轨迹] 轨迹已清除', 'success');
+            cachedTrajectoryPoints = [];
+            lodFile = null;
+            lodTileCache = new Map();
+            clearTimeout(lodRefreshTimer);
             
             // 清除3D轨迹查看器
             if (window.trajectoryViewer) {
                 console.log("清除3D轨迹");
+                window.trajectoryViewer.onViewChange = null;
                 window.trajectoryViewer.clear();
             }
             
@@ -832,10 +1062,15 @@ function updateStatusDisplay(data) {
         console.warn("数据中没有 position 字段");
     }
     
-    // 更新状态
+    // 更新状态，作业准备期间显示解析和规划进度
     if (data.state) {
         console.log("更新状态：", data.state);
-        document.getElementById('status').textContent = data.state;
+        document.getElementById('status').textContent = data.state === 'preparing' && data.job ?
+            formatJobProgress(data.job) : data.state;
+        if (data.job && data.job.error && data.job.id !== lastFailedJobId) {
+            lastFailedJobId = data.job.id;
+            logMessage(`[加工] 作业 ${data.job.id} 失败：${data.job.error}`, 'error');
+        }
     } else {
         console.warn("数据中没有 state 字段");
     }
@@ -864,8 +1099,23 @@ function updateStatusDisplay(data) {
     }
 }
 
+// 格式化作业的准备进度
+function formatJobProgress(job) {
+    if (job.phase === 'parsing') {
+        return `解析中 ${job.parsedLines} 行`;
+    }
+    if (job.phase === 'planning') {
+        return `规划中 ${job.plannedSegments}/${job.totalSegments}`;
+    }
+    return job.phase;
+}
+
 // 页面卸载时清理
 window.addEventListener('beforeunload', function() {
+    if (eventSource) {
+        eventSource.close();
+    }
+    
     if (statusUpdateInterval) {
         clearInterval(statusUpdateInterval);
     }
@@ -1006,34 +1256,15 @@ async function updateMachiningStatus() {
                         console.log("更新加工进度：", data.machining.progress);
                         document.getElementById('progress').textContent = `${Math.round(data.machining.progress * 100)}%`;
                     }
-                    
-                    // 如果有轨迹点，绘制轨迹
-                    if (data.machining.trajectoryPoints && data.machining.trajectoryPoints.length > 0) {
-                        console.log(`绘制 ${data.machining.trajectoryPoints.length} 个轨迹点`);
-                        logMessage(`[轨迹] 收到 ${data.machining.trajectoryPoints.length} 个轨迹点`, 'info');
-                        
-                        // 确保轨迹点有效
-                        const validPoints = data.machining.trajectoryPoints.filter(point => 
-                            typeof point.x === 'number' && 
-                            typeof point.y === 'number');
-                        
-                        if (validPoints.length > 0) {
-                            console.log(`有效轨迹点：${validPoints.length} 个，开始绘制`);
-                            drawTrajectory(validPoints);
-                        } else {
-                            console.warn("没有有效的轨迹点可以绘制");
-                            logMessage("[警告] 没有有效的轨迹点可以绘制", "warning");
-                        }
-                    } else {
-                        console.log("没有轨迹点数据");
-                        logMessage("[轨迹] 当前没有轨迹点数据", "warning");
-                    }
                 } else {
                     console.warn("数据中没有 machining 字段");
                 }
                 
-                // 如果加工已完成，停止更新
-                if (data.state !== "machining" && progressUpdateInterval) {
+                // 增量获取新的轨迹点
+                await updateTrajectory();
+                
+                // 如果加工已完成，停止更新；作业准备期间继续更新
+                if (data.state !== "machining" && data.state !== "preparing" && progressUpdateInterval) {
                     console.log("加工已完成，停止更新");
                     clearInterval(progressUpdateInterval);
                     progressUpdateInterval = null;
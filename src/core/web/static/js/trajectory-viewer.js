@@ -52,6 +52,12 @@ class TrajectoryViewer {
             this.controls.dampingFactor = 0.25;
             this.controls.screenSpacePanning = false;
             this.controls.maxPolarAngle = Math.PI / 2;
+            // 视图变化时通知外部按新的视口加载轨迹瓦片
+            this.controls.addEventListener('change', () => {
+                if (this.onViewChange) {
+                    this.onViewChange(this.getViewport());
+                }
+            });
             console.log("轨道控制器初始化完成");
         }
 
@@ -62,6 +68,8 @@ class TrajectoryViewer {
         // 存储轨迹数据
         this.trajectoryPoints = [];
         this.trajectoryLine = null;
+        this.tileLines = new Map();
+        this.onViewChange = null;
         
         // 添加光源
         const ambientLight = new THREE.AmbientLight(0xffffff, 0.5);
@@ -183,6 +191,83 @@ class TrajectoryViewer {
         console.log("轨迹路径添加完成");
     }
     
+    appendPoints(points) {
+        // 追加一批轨迹点，只重建一次轨迹线
+        if (!points || points.length === 0) return;
+        
+        for (const point of points) {
+            if (typeof point.x === 'number' && typeof point.y === 'number') {
+                this.trajectoryPoints.push({
+                    x: point.x,
+                    y: point.y,
+                    z: typeof point.z === 'number' ? point.z : 0
+                });
+            }
+        }
+        
+        this.updateTrajectoryLine();
+    }
+    
+    setPositions(positions) {
+        // 直接使用二进制轨迹解码得到的 Float32Array（x、y、z 交错）作为顶点缓冲，不逐点构造对象
+        this.clear();
+        if (!positions || positions.length < 6) return;
+        
+        const geometry = new THREE.BufferGeometry();
+        geometry.setAttribute('position', new THREE.BufferAttribute(positions, 3));
+        geometry.computeBoundingBox();
+        
+        const material = new THREE.LineBasicMaterial({
+            color: 0x00ffff,
+            linewidth: 2
+        });
+        
+        this.trajectoryLine = new THREE.Line(geometry, material);
+        this.scene.add(this.trajectoryLine);
+        this.fitBoundingBox(geometry.boundingBox);
+    }
+    
+    showTiles(tiles) {
+        // 显示轨迹瓦片（{ id, positions }），保留已显示的相同瓦片，移除不再需要的瓦片
+        const ids = new Set(tiles.map(tile => tile.id));
+        for (const [id, line] of this.tileLines) {
+            if (!ids.has(id)) {
+                this.scene.remove(line);
+                line.geometry.dispose();
+                this.tileLines.delete(id);
+            }
+        }
+        
+        for (const tile of tiles) {
+            if (this.tileLines.has(tile.id) || tile.positions.length < 6) continue;
+            const geometry = new THREE.BufferGeometry();
+            geometry.setAttribute('position', new THREE.BufferAttribute(tile.positions, 3));
+            const material = new THREE.LineBasicMaterial({
+                color: 0x00ffff,
+                linewidth: 2
+            });
+            const line = new THREE.Line(geometry, material);
+            this.tileLines.set(tile.id, line);
+            this.scene.add(line);
+        }
+    }
+    
+    getViewport() {
+        // 估算当前视图在 XY 平面上可见的范围和一个像素对应的长度
+        const canvas = document.getElementById(this.canvasId);
+        const target = this.controls ? this.controls.target : new THREE.Vector3(0, 0, 0);
+        const distance = this.camera.position.distanceTo(target);
+        const height = 2 * distance * Math.tan(this.camera.fov * Math.PI / 360);
+        const halfSize = height * Math.max(1, this.camera.aspect) / 2;
+        return {
+            minX: target.x - halfSize,
+            minY: target.y - halfSize,
+            maxX: target.x + halfSize,
+            maxY: target.y + halfSize,
+            pixel: height / Math.max(1, canvas ? canvas.clientHeight : 1)
+        };
+    }
+    
     addRapidMarker(position) {
         const geometry = new THREE.SphereGeometry(1, 8, 8);
         const material = new THREE.MeshBasicMaterial({ color: 0xff0000 });
@@ -237,6 +322,7 @@ class TrajectoryViewer {
     clear() {
         // 清除轨迹
         this.trajectoryPoints = [];
+        this.showTiles([]);
         
         if (this.trajectoryLine) {
             this.scene.remove(this.trajectoryLine);
@@ -253,6 +339,10 @@ class TrajectoryViewer {
 
     resetView() {
         // 重置视图，使所有轨迹点可见
+        if (this.trajectoryPoints.length === 0 && this.trajectoryLine && this.trajectoryLine.geometry.boundingBox) {
+            this.fitBoundingBox(this.trajectoryLine.geometry.boundingBox);
+            return;
+        }
         if (this.trajectoryPoints.length === 0) {
             this.camera.position.set(50, 50, 100);
             this.camera.lookAt(0, 0, 0);
@@ -265,6 +355,10 @@ class TrajectoryViewer {
             boundingBox.expandByPoint(new THREE.Vector3(point.x, point.y, point.z));
         });
         
+        this.fitBoundingBox(boundingBox);
+    }
+
+    fitBoundingBox(boundingBox) {
         // 计算包围盒中心
         const center = new THREE.Vector3();
         boundingBox.getCenter(center);
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "xxcnc/core/motion/PointN.h"
+
+namespace xxcnc {
+namespace core {
+namespace motion {
+
+/**
+ * @brief 粗插补节点，包含位置及其对时间的一阶、二阶导数
+ */
+template <size_t N>
+struct BasicMotionKnot {
+    PointN<N> position;          ///< 位置 (mm)
+    PointN<N> velocity;          ///< 速度 (mm/s)
+    PointN<N> acceleration;      ///< 加速度 (mm/s^2)
+    double timeScale = 1.0;      ///< 时间缩放系数
+    double timeScaleRate = 0.0;  ///< 时间缩放系数变化率 (1/s)
+};
+
+/**
+ * @brief 精插补器，在相邻两个粗插补节点之间按伺服周期生成 C2 连续的位置指令
+ * @details 每个区间使用五次 Hermite 多项式匹配两端的位置、速度和加速度，
+ *          区间系数在设置区间时计算一次，伺服周期内只做多项式求值
+ */
+template <size_t N>
+class BasicFineInterpolator {
+public:
+    /**
+     * @brief 设置插补区间
+     * @param from 区间起点节点
+     * @param to 区间终点节点
+     * @param duration 区间时长 (s)
+     */
+    void setSpan(const BasicMotionKnot<N>& from, const BasicMotionKnot<N>& to, double duration);
+
+    /**
+     * @brief 计算区间内给定时刻的位置
+     * @param t 区间内时刻 (s)
+     * @return 位置
+     */
+    PointN<N> positionAt(double t) const;
+
+    /**
+     * @brief 计算区间内给定时刻的时间缩放系数
+     * @param t 区间内时刻 (s)
+     * @return 时间缩放系数
+     */
+    double timeScaleAt(double t) const;
+
+    /**
+     * @brief 获取区间时长
+     * @return 时长 (s)
+     */
+    double getDuration() const { return duration_; }
+
+private:
+    double duration_ = 0.0;               ///< 区间时长 (s)
+    PointN<N> coefficients_[6];           ///< 各轴关于归一化时间的五次多项式系数，按幂次存放
+    double scaleCoefficients_[4] = {};    ///< 时间缩放系数的三次多项式系数
+};
+
+/// 三轴粗插补节点
+using MotionKnot = BasicMotionKnot<3>;
+/// 三轴精插补器
+using FineInterpolator = BasicFineInterpolator<3>;
+
+extern template class BasicFineInterpolator<3>;
+extern template class BasicFineInterpolator<4>;
+extern template class BasicFineInterpolator<5>;
+extern template class BasicFineInterpolator<6>;
+extern template class BasicFineInterpolator<7>;
+extern template class BasicFineInterpolator<8>;
+extern template class BasicFineInterpolator<9>;
+
+} // namespace motion
+} // namespace core
+} // namespace xxcnc
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "xxcnc/core/motion/PointN.h"
 #include <vector>
 #include <cmath>
 #include <memory>
@@ -9,14 +10,8 @@ namespace xxcnc {
 namespace core {
 namespace motion {
 
-struct Point {
-    double x;
-    double y;
-    double z;
-    
-    Point(double x_ = 0, double y_ = 0, double z_ = 0)
-        : x(x_), y(y_), z(z_) {}
-};
+/// 三轴坐标
+using Point = PointN<3>;
 
 class InterpolationEngine {
 public:
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace xxcnc {
+namespace core {
+namespace motion {
+
+/// 参与插补的最少轴数
+constexpr size_t kMinInterpolationAxes = 3;
+/// 参与插补的最多轴数
+constexpr size_t kMaxInterpolationAxes = 9;
+
+namespace detail {
+
+template <typename F, size_t... I>
+inline void forEachAxisImpl(F& f, std::index_sequence<I...>) {
+    (f(std::integral_constant<size_t, I>{}), ...);
+}
+
+} // namespace detail
+
+/**
+ * @brief 编译期展开的轴循环
+ * @details 依次以 std::integral_constant<size_t, I>（I = 0..N-1）调用 f，
+ *          轴数是编译期常量，循环体在编译期完全展开
+ * @param f 循环体
+ */
+template <size_t N, typename F>
+inline void forEachAxis(F&& f) {
+    detail::forEachAxisImpl(f, std::make_index_sequence<N>{});
+}
+
+/**
+ * @brief N 轴坐标
+ * @details 存储按4个 double 对齐填充，填充位恒为零，可整块按 SIMD 宽度加载
+ */
+template <size_t N>
+struct PointN {
+    static_assert(N >= 1, "PointN 至少需要1个轴");
+
+    static constexpr size_t kAxes = N;                  ///< 轴数
+    static constexpr size_t kPadded = (N + 3) / 4 * 4;  ///< 填充后的存储长度
+
+    double v[kPadded] = {};                             ///< 各轴坐标
+
+    double& operator[](size_t i) { return v[i]; }
+    double operator[](size_t i) const { return v[i]; }
+};
+
+/**
+ * @brief 3轴坐标特化，保留 x/y/z 成员以兼容现有接口
+ */
+template <>
+struct PointN<3> {
+    static constexpr size_t kAxes = 3;                  ///< 轴数
+    static constexpr size_t kPadded = 4;                ///< 填充后的存储长度
+
+    double x;
+    double y;
+    double z;
+    double padding = 0.0;                               ///< 填充位，保持4个 double 的存储宽度
+
+    PointN(double x_ = 0, double y_ = 0, double z_ = 0)
+        : x(x_), y(y_), z(z_) {}
+
+    double& operator[](size_t i) { return (i == 0) ? x : (i == 1) ? y : z; }
+    double operator[](size_t i) const { return (i == 0) ? x : (i == 1) ? y : z; }
+};
+
+/**
+ * @brief 计算两点间的欧氏距离
+ */
+template <size_t N>
+inline double distance(const PointN<N>& a, const PointN<N>& b) {
+    double sum = 0.0;
+    forEachAxis<N>([&](auto i) {
+        const double d = b[i] - a[i];
+        sum += d * d;
+    });
+    return std::sqrt(sum);
+}
+
+/**
+ * @brief 计算 XY 平面内两点间的距离
+ */
+template <size_t N>
+inline double planarDistance(const PointN<N>& a, const PointN<N>& b) {
+    return std::hypot(b[0] - a[0], b[1] - a[1]);
+}
+
+/**
+ * @brief 线性插值 a + (b - a) * t
+ */
+template <size_t N>
+inline PointN<N> lerp(const PointN<N>& a, const PointN<N>& b, double t) {
+    PointN<N> result;
+    forEachAxis<N>([&](auto i) { result[i] = a[i] + (b[i] - a[i]) * t; });
+    return result;
+}
+
+} // namespace motion
+} // namespace core
+} // namespace xxcnc
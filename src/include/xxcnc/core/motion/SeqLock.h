@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace xxcnc {
+namespace core {
+namespace motion {
+
+/**
+ * @brief 单写者顺序锁，用于从实时线程发布一致的状态快照
+ * @details 写者从不等待：递增序号为奇数、写入数据、再递增为偶数。读者在序号为偶数且读前读后
+ *          序号一致时得到完整快照，否则重试，读者不会阻塞写者。
+ *          数据以 64 位原子字逐字拷贝，避免对普通内存的数据竞争。
+ *
+ *          线程模型：publish() 只能由一个线程调用；read()/tryRead() 可在任意线程并发调用。
+ */
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock 只支持可平凡拷贝的类型");
+
+public:
+    SeqLock() {
+        publish(T{});
+    }
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    /**
+     * @brief 发布新快照（仅写者线程调用），O(sizeof(T)) 且无等待
+     * @param value 快照
+     */
+    void publish(const T& value) {
+        uint64_t words[kWords] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kWords; ++i) {
+            data_[i].store(words[i], std::memory_order_relaxed);
+        }
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief 尝试读取一次快照
+     * @param value 输出参数，读取成功时为完整快照
+     * @return 读取期间没有发生写入时返回true
+     */
+    bool tryRead(T& value) const {
+        const uint64_t before = sequence_.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+
+        uint64_t words[kWords];
+        for (size_t i = 0; i < kWords; ++i) {
+            words[i] = data_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+
+        std::memcpy(&value, words, sizeof(T));
+        return true;
+    }
+
+    /**
+     * @brief 读取快照，与写入冲突时重试
+     * @return 完整快照
+     */
+    T read() const {
+        T value;
+        while (!tryRead(value)) {
+        }
+        return value;
+    }
+
+    /**
+     * @brief 获取已发布的快照数
+     * @return 发布次数（包括构造时发布的初始快照）
+     */
+    uint64_t getVersion() const {
+        return sequence_.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    static constexpr size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint64_t> sequence_{0};         ///< 序号，奇数表示正在写入
+    std::atomic<uint64_t> data_[kWords];        ///< 快照数据
+};
+
+} // namespace motion
+} // namespace core
+} // namespace xxcnc
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace xxcnc {
+namespace core {
+namespace motion {
+
+/**
+ * @brief 无界单生产者单消费者无锁队列
+ * @details 节点由生产者分配并回收消费者已释放的节点，消费者侧只移动指针，
+ *          不分配也不释放内存，适合在实时线程中出队
+ */
+template <typename T>
+class SpscQueue {
+public:
+    SpscQueue() {
+        Node* node = new Node();
+        tail_.store(node, std::memory_order_relaxed);
+        head_ = node;
+        first_ = node;
+        tailCopy_ = node;
+    }
+
+    ~SpscQueue() {
+        Node* node = first_;
+        while (node != nullptr) {
+            Node* next = node->next.load(std::memory_order_relaxed);
+            delete node;
+            node = next;
+        }
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * @brief 入队（仅生产者线程调用）
+     * @param value 元素
+     */
+    void push(const T& value) {
+        Node* node = allocNode();
+        node->value = value;
+        node->next.store(nullptr, std::memory_order_relaxed);
+        head_->next.store(node, std::memory_order_release);
+        head_ = node;
+    }
+
+    /**
+     * @brief 出队（仅消费者线程调用）
+     * @param value 输出参数，队首元素
+     * @return 队列非空时返回true
+     */
+    bool pop(T& value) {
+        Node* tail = tail_.load(std::memory_order_relaxed);
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            return false;
+        }
+        value = next->value;
+        tail_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 查看队首元素（仅消费者线程调用）
+     * @return 队首元素指针，队列为空时返回nullptr；指针在下一次pop前有效
+     */
+    const T* front() const {
+        Node* next = tail_.load(std::memory_order_relaxed)->next.load(std::memory_order_acquire);
+        return next != nullptr ? &next->value : nullptr;
+    }
+
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        T value{};
+    };
+
+    Node* allocNode() {
+        // 优先复用消费者已经越过的节点
+        if (first_ != tailCopy_) {
+            Node* node = first_;
+            first_ = first_->next.load(std::memory_order_relaxed);
+            return node;
+        }
+        tailCopy_ = tail_.load(std::memory_order_acquire);
+        if (first_ != tailCopy_) {
+            Node* node = first_;
+            first_ = first_->next.load(std::memory_order_relaxed);
+            return node;
+        }
+        return new Node();
+    }
+
+    // 消费者侧
+    alignas(64) std::atomic<Node*> tail_;
+
+    // 生产者侧
+    alignas(64) Node* head_;
+    Node* first_;
+    Node* tailCopy_;
+};
+
+} // namespace motion
+} // namespace core
+} // namespace xxcnc
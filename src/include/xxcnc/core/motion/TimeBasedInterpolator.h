@@ -1,132 +1,419 @@
 #pragma once
 
 #include "xxcnc/core/motion/InterpolationEngine.h"
-#include <vector>
-#include <chrono>
-#include <queue>
-#include <mutex>
+#include "xxcnc/core/motion/FineInterpolator.h"
+#include "xxcnc/core/motion/SpscQueue.h"
+#include "xxcnc/core/motion/VelocityProfile.h"
+#include <atomic>
+#include <cstdint>
 
 namespace xxcnc {
 namespace core {
 namespace motion {
 
 /**
- * @brief 基于时间的插补器，按照固定周期（1ms）将规划产生的距离拆分
+ * @brief 进给保持状态枚举
  */
-class TimeBasedInterpolator {
+enum class FeedHoldState {
+    Running,        ///< 正常运行
+    Decelerating,   ///< 进给保持减速中
+    Held,           ///< 已在路径上停止
+    Resuming        ///< 恢复加速中
+};
+
+/**
+ * @brief 运动段描述符，插补器队列中的基本单元
+ * @details 直线段各轴同步线性插补；圆弧段在 XY 平面内插补，其余轴线性插补
+ */
+template <size_t N>
+struct BasicMoveSegment {
+    /**
+     * @brief 运动段类型
+     */
+    enum class Type {
+        Linear,     ///< 直线
+        Circular    ///< 圆弧
+    };
+
+    Type type = Type::Linear;                          ///< 运动段类型
+    PointN<N> start;                                   ///< 起点
+    PointN<N> end;                                     ///< 终点
+    PointN<N> center;                                  ///< 圆心（仅圆弧，只使用 XY 坐标）
+    bool isClockwise = false;                          ///< 是否顺时针（仅圆弧）
+    InterpolationEngine::InterpolationParams params;   ///< 插补参数
+    double length = 0.0;                               ///< 路径长度 (mm)
+    int lineNumber = 0;                                ///< 源程序行号，0 表示未知
+    uint64_t epoch = 0;                                ///< 追加时的队列代数，用于清空队列
+};
+
+/**
+ * @brief 基于时间的插补器，按照固定周期（1ms）生成位置指令
+ * @details 插补器维护一个连续路径的运动段队列，新运动段追加到队尾。
+ *          采用粗、精两级插补：粗插补按粗插补周期（默认4ms）由当前运动段的
+ *          梯形速度曲线解析计算节点的位置、速度和加速度；精插补按插补周期在
+ *          相邻节点之间用五次多项式生成 C2 连续的位置指令。运动段边界和速度
+ *          曲线的阶段切换处总会插入节点，保证精插补点不偏离路径、不超过编程
+ *          速度。不预先生成周期点，内存占用与运动段数量成正比。
+ *
+ *          线程模型：追加运动段、getTailPosition() 和 clearQueue() 由单一生产者线程调用；
+ *          getNextPoint()、beginFeedHold() 和 resumeFromHold() 由单一消费者（实时）线程调用，
+ *          消费者侧不加锁也不分配内存；状态查询可在任意线程调用。
+ *
+ *          轴数 N 为编译期常量（3-9），各轴循环在编译期展开，实例化在 TimeBasedInterpolator.cpp 中显式给出。
+ */
+template <size_t N>
+class BasicTimeBasedInterpolator {
 public:
+    using PointType = PointN<N>;                          ///< 坐标类型
+    using Segment = BasicMoveSegment<N>;                  ///< 运动段类型
+    using Knot = BasicMotionKnot<N>;                      ///< 粗插补节点类型
+    using FeedHoldState = ::xxcnc::core::motion::FeedHoldState;
+
+    static constexpr size_t kAxes = N;                    ///< 轴数
+
     /**
      * @brief 构造函数
      * @param interpolationPeriodMs 插补周期（毫秒），默认为1ms
+     * @param coarsePeriodMs 粗插补周期（毫秒），默认为4ms
      */
-    TimeBasedInterpolator(int interpolationPeriodMs = 1);
-    
+    BasicTimeBasedInterpolator(int interpolationPeriodMs = 1, int coarsePeriodMs = 4);
+
     /**
      * @brief 析构函数
      */
-    ~TimeBasedInterpolator();
-    
+    ~BasicTimeBasedInterpolator();
+
     /**
      * @brief 设置插补周期
      * @param periodMs 周期（毫秒）
      */
     void setInterpolationPeriod(int periodMs);
-    
+
     /**
      * @brief 获取插补周期
      * @return 插补周期（毫秒）
      */
     int getInterpolationPeriod() const;
-    
+
+    /**
+     * @brief 设置粗插补周期
+     * @param periodMs 周期（毫秒）
+     */
+    void setCoarsePeriod(int periodMs);
+
+    /**
+     * @brief 获取粗插补周期
+     * @return 粗插补周期（毫秒）
+     */
+    int getCoarsePeriod() const;
+
+    /**
+     * @brief 追加一个运动段到队尾
+     * @param segment 运动段描述符（长度由插补器计算）
+     * @return 是否成功
+     */
+    bool append(const Segment& segment);
+
+    /**
+     * @brief 从队尾位置追加一条直线
+     * @param end 终点
+     * @param params 插补参数
+     * @param lineNumber 源程序行号
+     * @return 是否成功
+     */
+    bool appendLinear(const PointType& end, const InterpolationEngine::InterpolationParams& params,
+                      int lineNumber = 0);
+
+    /**
+     * @brief 从队尾位置追加一段圆弧
+     * @param end 终点
+     * @param center 圆心
+     * @param isClockwise 是否顺时针
+     * @param params 插补参数
+     * @param lineNumber 源程序行号
+     * @return 是否成功
+     */
+    bool appendCircular(
+        const PointType& end,
+        const PointType& center,
+        bool isClockwise,
+        const InterpolationEngine::InterpolationParams& params,
+        int lineNumber = 0
+    );
+
+    /**
+     * @brief 获取队尾位置，即最后一个已追加运动段的终点
+     * @return 队尾位置
+     */
+    PointType getTailPosition() const;
+
     /**
-     * @brief 规划一条直线路径
+     * @brief 队尾位置是否有效
+     * @details 清空队列后队尾仍为被清除程序的终点，直到追加新的运动段前不能作为下一段的起点
+     * @return 是否有效
+     */
+    bool hasTailPosition() const;
+
+    /**
+     * @brief 规划一条直线路径（追加到队尾）
      * @param start 起点
      * @param end 终点
      * @param params 插补参数
+     * @param lineNumber 源程序行号
      * @return 是否成功
      */
     bool planLinearPath(
-        const Point& start,
-        const Point& end,
-        const InterpolationEngine::InterpolationParams& params
+        const PointType& start,
+        const PointType& end,
+        const InterpolationEngine::InterpolationParams& params,
+        int lineNumber = 0
     );
-    
+
     /**
-     * @brief 规划一条圆弧路径
+     * @brief 规划一条圆弧路径（追加到队尾）
      * @param start 起点
      * @param end 终点
      * @param center 圆心
      * @param isClockwise 是否顺时针
      * @param params 插补参数
+     * @param lineNumber 源程序行号
      * @return 是否成功
      */
     bool planCircularPath(
-        const Point& start,
-        const Point& end,
-        const Point& center,
+        const PointType& start,
+        const PointType& end,
+        const PointType& center,
         bool isClockwise,
-        const InterpolationEngine::InterpolationParams& params
+        const InterpolationEngine::InterpolationParams& params,
+        int lineNumber = 0
     );
-    
+
     /**
-     * @brief 获取下一个插补点
+     * @brief 获取下一个精插补点，O(1) 且无锁
      * @param point 输出参数，下一个插补点
      * @return 是否成功获取到点
      */
-    bool getNextPoint(Point& point);
-    
+    bool getNextPoint(PointType& point);
+
     /**
      * @brief 清空插补队列
+     * @details 通过递增队列代数使已追加的运动段失效，消费者在下一周期丢弃它们
      */
     void clearQueue();
-    
+
     /**
-     * @brief 获取当前队列中的点数
-     * @return 队列中的点数
+     * @brief 获取当前队列中尚未完成的运动段数
+     * @return 运动段数（包括当前正在执行的段）
      */
     size_t getQueueSize() const;
-    
+
     /**
      * @brief 检查插补是否完成
      * @return 是否完成
      */
     bool isFinished() const;
-    
+
     /**
      * @brief 获取当前插补进度
      * @return 进度（0.0-1.0）
      */
     double getProgress() const;
-    
+
+    /**
+     * @brief 开始进给保持
+     * @details 通过时间缩放沿已规划路径减速，减速过程满足加速度和加加速度限制，
+     *          停止点精确位于路径上，剩余队列保持不变
+     */
+    void beginFeedHold();
+
+    /**
+     * @brief 从保持点恢复运行，重新加速到编程速度
+     */
+    void resumeFromHold();
+
+    /**
+     * @brief 获取进给保持状态
+     * @return 进给保持状态
+     */
+    FeedHoldState getFeedHoldState() const;
+
+    /**
+     * @brief 获取当前时间缩放系数
+     * @return 实际路径速度与编程速度之比（0.0-1.0）
+     */
+    double getTimeScale() const;
+
+    /**
+     * @brief 获取精插补正在执行的运动段的源程序行号
+     * @return 行号，空闲或未知时为0
+     */
+    int getCurrentLineNumber() const;
+
 private:
     /**
-     * @brief 将路径点按照时间周期拆分
-     * @param path 原始路径点
-     * @param params 插补参数
+     * @brief 当前运动段的执行状态（仅消费者线程访问）
      */
-    void segmentPathByTime(
-        const std::vector<Point>& path,
-        const InterpolationEngine::InterpolationParams& params
-    );
-    
-    /**
-     * @brief 计算两点间的距离
-     * @param p1 点1
-     * @param p2 点2
-     * @return 距离
-     */
-    double calculateDistance(const Point& p1, const Point& p2) const;
-    
-    std::unique_ptr<InterpolationEngine> interpolationEngine_;
-    std::queue<Point> interpolationQueue_;
-    mutable std::mutex queueMutex_;
-    int interpolationPeriodMs_;
-    double totalDistance_;
-    double completedDistance_;
-    Point currentPosition_;
-    bool isPlanning_;
+    struct ActiveSegment {
+        Segment segment;            ///< 运动段描述符
+        VelocityProfile profile;    ///< 速度曲线
+        double elapsed = 0.0;       ///< 段内已执行时间 (s)
+        double radius = 0.0;        ///< 圆弧半径
+        double startAngle = 0.0;    ///< 圆弧起始角
+        double sweep = 0.0;         ///< 圆弧扫过角度（带方向）
+        bool valid = false;         ///< 是否有当前段
+    };
+
+    /**
+     * @brief 计算运动段的路径长度
+     * @param segment 运动段
+     * @return 路径长度 (mm)
+     */
+    double calculateSegmentLength(const Segment& segment) const;
+
+    /**
+     * @brief 计算运动段在起点或终点处的单位切向量
+     * @param segment 运动段
+     * @param atEnd 是否取终点处
+     * @return 单位切向量
+     */
+    PointType calculateTangent(const Segment& segment, bool atEnd) const;
+
+    /**
+     * @brief 计算两段之间的拐角速度上限（拐角偏差法）
+     * @param current 当前段
+     * @param next 下一段
+     * @return 拐角速度 (mm/s)
+     */
+    double calculateJunctionVelocity(const Segment& current, const Segment& next) const;
+
+    /**
+     * @brief 获取运动段的编程匀速速度
+     * @param segment 运动段
+     * @return 速度 (mm/s)
+     */
+    double cruiseVelocity(const Segment& segment) const;
+
+    /**
+     * @brief 激活下一个有效运动段并规划其速度曲线
+     * @return 是否有可激活的运动段
+     */
+    bool activateNextSegment();
+
+    /**
+     * @brief 结束当前运动段
+     */
+    void retireActiveSegment();
+
+    /**
+     * @brief 丢弃已被清空的运动段
+     */
+    void discardStaleSegments();
+
+    /**
+     * @brief 计算当前运动段在当前段内时间处的粗插补节点
+     * @param arriving 是否作为区间终点，此时加速度取左极限
+     * @return 节点（位置、速度、加速度均已计入时间缩放）
+     */
+    Knot sampleActiveSegment(bool arriving) const;
+
+    /**
+     * @brief 生成下一个粗插补节点并设置精插补区间
+     * @param from 区间起点节点
+     * @return 是否还有运动段
+     */
+    bool startNextSpan(const Knot& from);
+
+    /**
+     * @brief 精插补到达区间终点，发布该节点对应的完成段数、进度和进给保持状态
+     */
+    void arriveAtSpanEnd();
+
+    /**
+     * @brief 启动时间缩放系数的S形过渡
+     * @param targetScale 目标缩放系数
+     * @param limit 允许的最大路径加（减）速度 (mm/s^2)
+     */
+    void startTimeScaleRamp(double targetScale, double limit);
+
+    /**
+     * @brief 检查时间缩放系数是否处于过渡中
+     * @return 是否处于过渡中
+     */
+    bool isRamping() const;
+
+    /**
+     * @brief 计算经过给定实际时间后推进的段内时间
+     * @param step 实际时间 (s)
+     * @return 段内时间 (s)
+     */
+    double pathTimeAdvance(double step) const;
+
+    /**
+     * @brief 按实际时间推进时间缩放系数
+     * @param step 实际时间 (s)
+     */
+    void advanceTimeScale(double step);
+
+    // 生产者侧
+    SpscQueue<Segment> segmentQueue_;           ///< 待执行的运动段
+    PointType tailPosition_;                    ///< 队尾位置
+    bool tailValid_;                            ///< 队尾位置是否有效
+    std::atomic<uint64_t> epoch_;               ///< 队列代数，清空时递增
+    std::atomic<uint64_t> appendedCount_;       ///< 已追加的运动段数
+    std::atomic<uint64_t> clearedCount_;        ///< 清空时已追加的运动段数
+    std::atomic<double> totalDistance_;         ///< 当前代数的总路径长度
+
+    // 消费者侧（粗插补）
+    ActiveSegment active_;                      ///< 当前运动段
+    double lastExitVelocity_;                   ///< 上一段的结束速度 (mm/s)
+    double completedSegmentsLength_;            ///< 当前代数已完成运动段的总长度
+    uint64_t pendingRetired_;                   ///< 已完成但尚未到达对应节点的运动段数
+    double coarseRemaining_;                    ///< 距下一个粗插补周期节点的时间 (s)
+    double coarseScale_;                        ///< 粗插补时刻的时间缩放系数
+    FeedHoldState rampState_;                   ///< 粗插补时刻的进给保持状态
+    InterpolationEngine::InterpolationParams params_;  ///< 当前运动段的插补参数
+    double rampStartScale_;                     ///< 过渡起始缩放系数
+    double rampTargetScale_;                    ///< 过渡目标缩放系数
+    double rampDuration_;                       ///< 过渡时长 (s)
+    double rampElapsed_;                        ///< 过渡已用时间 (s)
+    uint64_t consumerEpoch_;                    ///< 消费者已观察到的队列代数
+
+    // 消费者侧（精插补）
+    BasicFineInterpolator<N> fineInterpolator_; ///< 当前精插补区间
+    Knot nextDeparture_;                        ///< 下一区间的起点节点
+    bool spanValid_;                            ///< 是否有精插补区间
+    double fineElapsed_;                        ///< 区间内已执行时间 (s)
+    uint64_t spanRetired_;                      ///< 到达区间终点时完成的运动段数
+    double spanCompletedDistance_;              ///< 到达区间终点时的已完成路径长度
+    FeedHoldState spanRampState_;               ///< 区间终点的进给保持状态
+    PointType currentPosition_;                 ///< 最近一次输出的插补点
+
+    // 状态发布
+    std::atomic<uint64_t> retiredCount_;        ///< 已完成或丢弃的运动段数
+    std::atomic<double> completedDistance_;     ///< 已完成的路径长度
+    std::atomic<uint64_t> completedEpoch_;      ///< completedDistance_ 所属的队列代数
+    std::atomic<double> timeScale_;             ///< 时间缩放系数
+    std::atomic<FeedHoldState> feedHoldState_;  ///< 进给保持状态
+    std::atomic<int> currentLineNumber_;        ///< 精插补正在执行的源程序行号
+
+    std::atomic<int> interpolationPeriodMs_;
+    std::atomic<int> coarsePeriodMs_;           ///< 粗插补周期（毫秒）
+    double junctionDeviation_;                  ///< 拐角偏差 (mm)
 };
 
+/// 三轴运动段
+using MoveSegment = BasicMoveSegment<3>;
+/// 三轴基于时间的插补器
+using TimeBasedInterpolator = BasicTimeBasedInterpolator<3>;
+
+extern template class BasicTimeBasedInterpolator<3>;
+extern template class BasicTimeBasedInterpolator<4>;
+extern template class BasicTimeBasedInterpolator<5>;
+extern template class BasicTimeBasedInterpolator<6>;
+extern template class BasicTimeBasedInterpolator<7>;
+extern template class BasicTimeBasedInterpolator<8>;
+extern template class BasicTimeBasedInterpolator<9>;
+
 } // namespace motion
 } // namespace core
 } // namespace xxcnc
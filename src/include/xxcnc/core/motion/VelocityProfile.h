@@ -0,0 +1,84 @@
+#pragma once
+
+namespace xxcnc {
+namespace core {
+namespace motion {
+
+/**
+ * @brief 运动段的梯形速度曲线，可按时间解析求取路径长度和速度
+ */
+struct VelocityProfile {
+    double entryVelocity = 0.0;   ///< 起始速度 (mm/s)
+    double peakVelocity = 0.0;    ///< 实际达到的最高速度 (mm/s)
+    double exitVelocity = 0.0;    ///< 结束速度 (mm/s)
+    double acceleration = 0.0;    ///< 加速度 (mm/s^2)
+    double deceleration = 0.0;    ///< 减速度 (mm/s^2)
+    double accelTime = 0.0;       ///< 加速段时长 (s)
+    double cruiseTime = 0.0;      ///< 匀速段时长 (s)
+    double decelTime = 0.0;       ///< 减速段时长 (s)
+    double length = 0.0;          ///< 路径长度 (mm)
+
+    /**
+     * @brief 规划梯形速度曲线，距离不足时退化为三角形曲线
+     * @param length 路径长度 (mm)
+     * @param entry 起始速度 (mm/s)
+     * @param cruise 期望匀速速度 (mm/s)
+     * @param exit 结束速度 (mm/s)
+     * @param acceleration 加速度 (mm/s^2)
+     * @param deceleration 减速度 (mm/s^2)
+     * @return 速度曲线
+     */
+    static VelocityProfile plan(
+        double length,
+        double entry,
+        double cruise,
+        double exit,
+        double acceleration,
+        double deceleration
+    );
+
+    /**
+     * @brief 获取曲线总时长
+     * @return 时长 (s)
+     */
+    double duration() const { return accelTime + cruiseTime + decelTime; }
+
+    /**
+     * @brief 计算给定时刻已走过的路径长度
+     * @param t 时刻 (s)，超出范围时截断
+     * @return 路径长度 (mm)
+     */
+    double distanceAt(double t) const;
+
+    /**
+     * @brief 计算给定时刻的路径速度
+     * @param t 时刻 (s)，超出范围时截断
+     * @return 速度 (mm/s)
+     */
+    double velocityAt(double t) const;
+
+    /**
+     * @brief 计算给定时刻的路径加速度（右极限）
+     * @param t 时刻 (s)
+     * @return 加速度 (mm/s^2)，减速段为负值
+     */
+    double accelerationAt(double t) const;
+
+    /**
+     * @brief 计算给定时刻的路径加速度（左极限），用于阶段切换点和终点
+     * @param t 时刻 (s)
+     * @return 加速度 (mm/s^2)，减速段为负值
+     */
+    double accelerationBefore(double t) const;
+
+    /**
+     * @brief 获取给定时刻之后的下一个阶段切换时刻（加速段结束、减速段开始或曲线结束）
+     * @param t 时刻 (s)
+     * @return 切换时刻 (s)
+     */
+    double nextPhaseChange(double t) const;
+};
+
+} // namespace motion
+} // namespace core
+} // namespace xxcnc
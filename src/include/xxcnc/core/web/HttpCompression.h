@@ -0,0 +1,54 @@
+#pragma once
+
+#include <string>
+
+namespace xxcnc {
+namespace web {
+
+/**
+ * @brief HTTP 内容编码
+ */
+enum class ContentEncoding {
+    Identity,   ///< 不压缩
+    Gzip,       ///< gzip
+    Brotli      ///< br
+};
+
+/**
+ * @brief 压缩力度
+ */
+enum class CompressionEffort {
+    Fast,       ///< 请求时压缩的动态内容，优先速度
+    Best        ///< 启动时预压缩的静态资源，优先压缩率
+};
+
+/**
+ * @brief 按请求的 Accept-Encoding 选择内容编码
+ * @details 支持 q 值和通配符 *，q 值相同时优先 br，其次 gzip；都不可接受时返回 Identity
+ * @param acceptEncoding Accept-Encoding 请求头，可以为空
+ * @param brotli 是否有 br 编码的内容可选
+ * @param gzip 是否有 gzip 编码的内容可选
+ * @return 选择的编码
+ */
+ContentEncoding negotiateEncoding(const std::string& acceptEncoding, bool brotli = true, bool gzip = true);
+
+/**
+ * @brief 获取编码在 Content-Encoding 中的名称
+ * @param encoding 编码
+ * @return 名称，Identity 返回空字符串
+ */
+const char* encodingName(ContentEncoding encoding);
+
+/**
+ * @brief 压缩内容
+ * @param encoding 编码，Identity 时原样复制
+ * @param input 原始内容
+ * @param output 压缩后的内容
+ * @param effort 压缩力度
+ * @return 是否成功
+ */
+bool compressContent(ContentEncoding encoding, const std::string& input, std::string& output,
+                     CompressionEffort effort = CompressionEffort::Fast);
+
+} // namespace web
+} // namespace xxcnc
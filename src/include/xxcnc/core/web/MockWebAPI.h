@@ -170,7 +170,7 @@ public:
                         interpolator_->planLinearPath(startPoint, endPoint, params);
                     }
                     
-                    spdlog::info("成功规划插补路径，队列中有 {} 个点", interpolator_->getQueueSize());
+                    spdlog::info("成功规划插补路径，队列中有 {} 个运动段", interpolator_->getQueueSize());
                 }
                 
                 // 开始加工流程
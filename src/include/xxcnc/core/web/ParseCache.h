@@ -0,0 +1,133 @@
+#pragma once
+
+#include "WebAPI.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace xxcnc {
+namespace web {
+
+/**
+ * @brief 文件解析结果缓存
+ * @details 以路径、修改时间和大小为键保存解析结果，文件被修改后自动失效。缓存按估算的内存占用
+ *          限制总量，超出预算时淘汰最久未使用的结果；单个结果超过预算时不缓存。
+ *
+ *          同一文件的并发请求合并为一次解析（single-flight）：第一个请求执行解析，其余请求等待
+ *          并共享它的结果。解析失败的结果只交给等待中的请求，不缓存。执行解析的请求自行中止时，
+ *          中止的结果只返回给它自己，等待中的请求重新发起解析，其中一个接替执行。
+ */
+class ParseCache {
+public:
+    /// 解析函数，在不持有缓存锁的情况下执行；将结果写入参数，被调用方中止时返回false
+    using Loader = std::function<bool(FileParseResponse&)>;
+
+    /// 默认内存预算（字节）
+    static constexpr size_t kDefaultBudget = 256 * 1024 * 1024;
+
+    /**
+     * @brief 构造函数
+     * @param budgetBytes 缓存结果的内存预算（字节），0 表示不缓存，只合并并发请求
+     */
+    explicit ParseCache(size_t budgetBytes = kDefaultBudget);
+
+    /**
+     * @brief 获取文件的解析结果，缓存未命中时调用 loader 解析
+     * @details 无法读取文件的修改时间和大小时直接调用 loader，不缓存也不合并
+     * @param path 文件路径
+     * @param loader 解析函数
+     * @return 解析结果，由缓存和所有请求共享，不可修改
+     */
+    std::shared_ptr<const FileParseResponse> get(const std::filesystem::path& path, const Loader& loader);
+
+    /**
+     * @brief 移除文件的缓存结果，文件被覆盖时调用
+     * @details 进行中的解析可能读到旧内容，其结果仍交给已在等待的请求，但不再写入缓存
+     * @param path 文件路径
+     */
+    void erase(const std::filesystem::path& path);
+
+    /**
+     * @brief 清空缓存
+     */
+    void clear();
+
+    /**
+     * @brief 获取缓存的结果数
+     * @return 结果数
+     */
+    size_t size() const;
+
+    /**
+     * @brief 获取缓存结果的估算内存占用
+     * @return 字节数
+     */
+    size_t getMemoryUsage() const;
+
+    /**
+     * @brief 获取累计执行解析的次数
+     * @return 解析次数
+     */
+    uint64_t getLoadCount() const;
+
+    /**
+     * @brief 获取累计命中缓存或合并到进行中解析的次数
+     * @return 命中次数
+     */
+    uint64_t getHitCount() const;
+
+    /**
+     * @brief 估算解析结果的内存占用
+     * @param response 解析结果
+     * @return 字节数
+     */
+    static size_t estimateSize(const FileParseResponse& response);
+
+private:
+    using Result = std::shared_ptr<const FileParseResponse>;
+
+    /**
+     * @brief 缓存的解析结果
+     */
+    struct Entry {
+        std::string path;                           ///< 文件路径
+        std::filesystem::file_time_type mtime;      ///< 解析时文件的修改时间
+        uintmax_t fileSize = 0;                     ///< 解析时文件的大小
+        size_t bytes = 0;                           ///< 估算的内存占用
+        Result result;                              ///< 解析结果
+    };
+
+    /**
+     * @brief 进行中的解析
+     */
+    struct Flight {
+        uint64_t id = 0;                            ///< 解析编号，区分同一文件先后发起的解析
+        std::filesystem::file_time_type mtime;      ///< 文件的修改时间
+        uintmax_t fileSize = 0;                     ///< 文件的大小
+        std::shared_future<Result> result;          ///< 解析结果，被中止时为 nullptr
+    };
+
+    /**
+     * @brief 移除缓存结果，调用时需持有 mutex_
+     */
+    void eraseLocked(std::list<Entry>::iterator it);
+
+    size_t budget_;                                             ///< 内存预算
+    mutable std::mutex mutex_;                                  ///< 保护以下成员
+    std::list<Entry> entries_;                                  ///< 缓存结果，最近使用的在前
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_; ///< 路径到缓存结果的索引
+    std::unordered_map<std::string, Flight> flights_;           ///< 路径到进行中解析的索引
+    size_t bytes_ = 0;                                          ///< 缓存结果的内存占用
+    uint64_t loads_ = 0;                                        ///< 累计解析次数
+    uint64_t hits_ = 0;                                         ///< 累计命中次数
+};
+
+} // namespace web
+} // namespace xxcnc
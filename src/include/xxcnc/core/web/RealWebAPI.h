@@ -1,8 +1,16 @@
 #pragma once
 
 #include "xxcnc/core/web/WebAPI.h"
-#include "xxcnc/motion/MotionController.h"
+#include "xxcnc/core/web/TrajectoryHistory.h"
+#include "xxcnc/core/web/ParseCache.h"
+#include "xxcnc/motion/ChannelManager.h"
+#include <array>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
 #include <thread>
 #include <mutex>
 #include <filesystem>
@@ -16,15 +24,41 @@ namespace web {
 
 /**
  * @brief 真实的Web API实现，使用实际的运动控制器
+ * @details 每个通道拥有独立的运动控制器和实时控制循环，控制循环依次绑定到 CPU 1、2、…，
+ *          CPU 0 留给 Web 服务和文件解析等共享的非实时线程；命令和状态按通道编号寻址。
+ *          加工作业由每个通道的作业线程解析和规划，命令立即返回作业编号；作业队列中的下一个作业
+ *          在当前作业运行时预先解析，当前作业结束后立即开始规划和运动。
  */
 class RealWebAPI : public WebAPI {
 public:
-    RealWebAPI() : 
-        motionController_(std::make_shared<motion::MotionController>()),
+    /**
+     * @brief 构造函数
+     * @param channelCount 通道数，至少1个
+     * @param historyCapacity 每个通道轨迹历史的容量（点），写满后自动抽稀较早的历史
+     * @param parseCacheBudget 解析结果缓存的内存预算（字节）
+     */
+    explicit RealWebAPI(size_t channelCount = 1, size_t historyCapacity = TrajectoryHistory::kDefaultCapacity,
+                        size_t parseCacheBudget = ParseCache::kDefaultBudget) : 
+        channelManager_(realTimeLoopOptions(), std::thread::hardware_concurrency() > 1 ? 1 : -1),
+        parseCache_(parseCacheBudget),
         lastUpdateTime_(std::chrono::steady_clock::now())
     {
-        // 初始化运动控制器
-        initializeMotionController();
+        // 初始化各通道的运动控制器
+        channels_.resize(std::max<size_t>(channelCount, 1));
+        for (ChannelState& channel : channels_) {
+            channel.controller = std::make_shared<motion::MotionController>();
+            channel.trajectoryHistory = std::make_unique<TrajectoryHistory>(historyCapacity);
+            initializeMotionController(channel);
+            channelManager_.addChannel(channel.controller);
+        }
+        
+        // 启动各通道的实时控制循环，按插补周期驱动运动控制器；无实时权限时按普通线程运行
+        channelManager_.start();
+        
+        // 启动各通道的作业线程，通道列表此后不再改变
+        for (ChannelState& channel : channels_) {
+            channel.jobWorker = std::thread(&RealWebAPI::runJobWorker, this, std::ref(channel));
+        }
         
         // 创建上传目录
         std::filesystem::path uploads_dir = std::filesystem::current_path() / "uploads";
@@ -34,133 +68,115 @@ public:
         }
     }
     
-    ~RealWebAPI() override = default;
+    ~RealWebAPI() override {
+        // 通知作业线程退出，正在解析或规划的作业在下一批之前结束；等待线程退出后再销毁运动控制器
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        jobSignal_.notify_all();
+        for (ChannelState& state : channels_) {
+            if (state.jobWorker.joinable()) {
+                state.jobWorker.join();
+            }
+        }
+    }
 
-    // 状态监控API
+    // 状态监控API，返回通道0的状态
     StatusResponse getSystemStatus() override {
+        StatusResponse response;
+        getChannelStatus(0, response);
+        return response;
+    }
+
+    size_t getChannelCount() override {
+        return channels_.size();
+    }
+
+    // 状态中不含轨迹点，轨迹历史通过 getChannelUpdate 按序号增量获取
+    bool getChannelStatus(int channel, StatusResponse& response) override {
+        return getChannelUpdate(channel, std::numeric_limits<uint64_t>::max(), 0, response);
+    }
+
+    bool getChannelUpdate(int channel, uint64_t sinceSequence, size_t maxPoints, StatusResponse& response) override {
+        if (!channelManager_.hasChannel(channel)) {
+            spdlog::error("通道不存在: {}", channel);
+            return false;
+        }
+
         std::lock_guard<std::mutex> lock(mutex_);
+        ChannelState& state = channels_[static_cast<size_t>(channel)];
+        response.channel = channel;
         
-        StatusResponse response;
+        // 读取控制循环发布的快照，位置、进度和行号来自同一周期，且不阻塞控制循环
+        const motion::MotionController::Snapshot snapshot = state.controller->getSnapshot();
+        response.currentLine = snapshot.lineNumber;
+        
+        // 作业线程和状态查询都会检查插补是否完成，先检查到的一方结束作业
+        checkJobFinished(state, snapshot);
         
-        // 更新进度
-        if (isProcessing) {
+        // 更新进度，规划与运动并行进行，开始运动后即为加工状态
+        if (state.isProcessing) {
             response.status = "machining";
             
             // 获取当前进度
-            response.progress = motionController_->getInterpolationProgress();
-            
-            // 如果插补已完成，则设置为空闲状态
-            if (motionController_->isInterpolationFinished()) {
-                isProcessing = false;
-                response.status = "idle";
-                response.progress = 1.0; // 完成
-                spdlog::info("加工完成");
-            }
-            
-            // 获取当前位置
-            auto xAxis = motionController_->getAxis("X");
-            auto yAxis = motionController_->getAxis("Y");
-            auto zAxis = motionController_->getAxis("Z");
-            
-            if (xAxis && yAxis && zAxis) {
-                response.position.x = xAxis->getCurrentPosition();
-                response.position.y = yAxis->getCurrentPosition();
-                response.position.z = zAxis->getCurrentPosition();
-                
-                // 创建当前轨迹点
-                TrajectoryPoint currentPoint = {
-                    response.position.x,
-                    response.position.y,
-                    response.position.z,
-                    false // 非快速定位
-                };
-                
-                // 添加到轨迹历史
-                trajectoryHistory_.push_back(currentPoint);
-                
-                // 记录轨迹点数量
-                spdlog::info("当前轨迹历史点数: {}", trajectoryHistory_.size());
-                spdlog::info("当前位置: ({}, {}, {})", currentPoint.x, currentPoint.y, currentPoint.z);
-            }
+            response.progress = snapshot.progress;
+        } else if (state.job && isJobPreparing(state.job->status)) {
+            response.status = "preparing";
+            response.progress = 0.0;
         } else {
             response.status = "idle";
-            response.progress = 0.0;
-            
-            // 获取当前位置
-            auto xAxis = motionController_->getAxis("X");
-            auto yAxis = motionController_->getAxis("Y");
-            auto zAxis = motionController_->getAxis("Z");
-            
-            if (xAxis && yAxis && zAxis) {
-                response.position.x = xAxis->getCurrentPosition();
-                response.position.y = yAxis->getCurrentPosition();
-                response.position.z = zAxis->getCurrentPosition();
-                
-                // 创建当前轨迹点
-                TrajectoryPoint currentPoint = {
-                    response.position.x,
-                    response.position.y,
-                    response.position.z,
-                    false // 非快速定位
-                };
-                
-                // 添加到轨迹历史（仅当位置发生变化时）
-                if (trajectoryHistory_.empty() || 
-                    std::abs(trajectoryHistory_.back().x - currentPoint.x) > 0.001 ||
-                    std::abs(trajectoryHistory_.back().y - currentPoint.y) > 0.001 ||
-                    std::abs(trajectoryHistory_.back().z - currentPoint.z) > 0.001) {
-                    
-                    trajectoryHistory_.push_back(currentPoint);
-                    spdlog::info("添加新轨迹点: ({}, {}, {})", currentPoint.x, currentPoint.y, currentPoint.z);
-                }
-                
-                // 记录轨迹点数量
-                spdlog::info("当前轨迹历史点数: {}", trajectoryHistory_.size());
-                spdlog::info("当前位置: ({}, {}, {})", currentPoint.x, currentPoint.y, currentPoint.z);
-            } else {
-                response.position = {0.0, 0.0, 0.0};
-            }
+            response.progress = state.job && state.job->status.phase == "completed" ? 1.0 : 0.0;
         }
         
-        // 无论是否处于加工状态，都返回完整的轨迹历史
-        if (!trajectoryHistory_.empty()) {
-            response.trajectoryPoints = trajectoryHistory_;
-            spdlog::info("响应中的轨迹点数: {}", response.trajectoryPoints.size());
-            
-            // 记录部分轨迹点用于调试
-            if (trajectoryHistory_.size() > 0) {
-                size_t sampleSize = std::min(size_t(5), trajectoryHistory_.size());
-                spdlog::info("轨迹点示例（前{}个）:", sampleSize);
-                for (size_t i = 0; i < sampleSize; i++) {
-                    spdlog::info("  点 {}: ({}, {}, {})", 
-                                i, 
-                                trajectoryHistory_[i].x, 
-                                trajectoryHistory_[i].y, 
-                                trajectoryHistory_[i].z);
-                }
+        // 获取当前位置，位置变化时添加到轨迹历史；状态可能被多个客户端高频读取，静止时不重复记录
+        if (readSnapshotPosition(state, snapshot, response)) {
+            TrajectoryHistory& history = *state.trajectoryHistory;
+            TrajectoryPoint lastPoint;
+            if (!history.back(lastPoint) ||
+                std::abs(lastPoint.x - response.position.x) > 0.001 ||
+                std::abs(lastPoint.y - response.position.y) > 0.001 ||
+                std::abs(lastPoint.z - response.position.z) > 0.001) {
                 
-                if (trajectoryHistory_.size() > 5) {
-                    size_t lastIndex = trajectoryHistory_.size() - 1;
-                    spdlog::info("  ... 及最后一个点 {}: ({}, {}, {})",
-                                lastIndex,
-                                trajectoryHistory_[lastIndex].x,
-                                trajectoryHistory_[lastIndex].y,
-                                trajectoryHistory_[lastIndex].z);
+                TrajectoryPoint currentPoint;
+                currentPoint.x = response.position.x;
+                currentPoint.y = response.position.y;
+                currentPoint.z = response.position.z;
+                currentPoint.lineNumber = snapshot.lineNumber;
+                if (state.program && snapshot.lineNumber > 0 &&
+                    static_cast<size_t>(snapshot.lineNumber) <= state.program->toolPathDetails.size()) {
+                    currentPoint.command = state.program->toolPathDetails[static_cast<size_t>(snapshot.lineNumber) - 1];
                 }
+                history.append(currentPoint);
+                spdlog::trace("添加新轨迹点: ({}, {}, {})", currentPoint.x, currentPoint.y, currentPoint.z);
             }
         } else {
-            spdlog::info("轨迹历史为空");
+            response.position = {0.0, 0.0, 0.0};
         }
         
+        // 只返回序号大于游标的轨迹点
+        state.trajectoryHistory->read(sinceSequence, maxPoints, response.trajectoryPoints);
+        response.trajectorySequence = state.trajectoryHistory->getLatestSequence();
+        response.trajectoryCleared = state.clearedSequence;
+        spdlog::trace("轨迹历史点数: {}，响应中的轨迹点数: {}", state.trajectoryHistory->size(),
+                      response.trajectoryPoints.size());
+        
         response.feedRate = currentFeedRate_;
-        response.currentFile = currentFile_;
+        response.currentFile = state.currentFile;
+        response.job = state.job ? state.job->status : JobStatus();
+        response.queuedJobs = state.jobQueue.size();
         response.errorCode = 0;
         
-        return response;
+        return true;
     }
 
     // 控制指令API
     bool executeCommand(const nlohmann::json& cmdJson) override {
+        nlohmann::json result;
+        return executeCommandWithResult(cmdJson, result);
+    }
+
+    bool executeCommandWithResult(const nlohmann::json& cmdJson, nlohmann::json& result) override {
         try {
             if (!cmdJson.contains("command") || !cmdJson["command"].is_string()) {
                 spdlog::error("无效的命令格式，缺少command字段或类型不正确");
@@ -168,7 +184,20 @@ public:
             }
             
             std::string command = cmdJson["command"].get<std::string>();
-            spdlog::info("执行命令: {}", command);
+            int channel = 0;
+            if (cmdJson.contains("channel")) {
+                if (!cmdJson["channel"].is_number_integer()) {
+                    spdlog::error("channel字段类型不正确");
+                    return false;
+                }
+                channel = cmdJson["channel"].get<int>();
+            }
+            if (!channelManager_.hasChannel(channel)) {
+                spdlog::error("通道不存在: {}", channel);
+                return false;
+            }
+            ChannelState& state = channels_[static_cast<size_t>(channel)];
+            spdlog::info("通道 {} 执行命令: {}", channel, command);
             
             if (command == "motion.start") {
                 // 检查是否有文件名参数
@@ -177,86 +206,134 @@ public:
                     return false;
                 }
                 
-                std::string filename = cmdJson["filename"].get<std::string>();
-                spdlog::info("开始加工文件: {}", filename);
-                
-                // 解析文件获取轨迹点
-                auto parseResponse = parseFile(filename);
-                if (!parseResponse.success) {
-                    spdlog::error("解析文件失败: {}", parseResponse.error);
+                // 立即执行的作业，不经过作业队列；解析和规划由作业线程进行，命令立即返回作业编号
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (state.job && isJobPreparing(state.job->status)) {
+                    spdlog::error("通道 {} 的作业 {} 尚未完成准备，拒绝新的作业", channel, state.job->status.id);
+                    result["jobId"] = state.job->status.id;
+                    result["error"] = "channel busy";
                     return false;
                 }
-                
-                // 使用解析的轨迹点
-                std::vector<TrajectoryPoint> trajectoryPoints = parseResponse.trajectoryPoints;
-                spdlog::info("成功加载轨迹点: {} 个", trajectoryPoints.size());
-                
-                // 使用运动控制器规划路径
-                if (!trajectoryPoints.empty()) {
-                    std::lock_guard<std::mutex> lock(mutex_);
-                    
-                    // 确保所有轴都已使能
-                    motionController_->enableAllAxes();
-                    
-                    // 清除之前的运动规划
-                    motionController_->clearTrajectory();
-                    
-                    // 执行轨迹
-                    for (size_t i = 0; i < trajectoryPoints.size(); ++i) {
-                        const auto& point = trajectoryPoints[i];
-                        
-                        // 创建目标位置映射
-                        std::map<std::string, double> targetPositions;
-                        targetPositions["X"] = point.x;
-                        targetPositions["Y"] = point.y;
-                        targetPositions["Z"] = point.z;
-                        
-                        // 设置进给速度
-                        double feedRate = point.isRapid ? 3000.0 : currentFeedRate_;
-                        
-                        // 执行直线插补运动
-                        if (!motionController_->moveLinear(targetPositions, feedRate)) {
-                            spdlog::error("运动规划失败，位置: ({}, {}, {})", point.x, point.y, point.z);
-                            return false;
-                        }
-                    }
-                    
-                    spdlog::info("成功规划运动路径");
-                    
-                    // 开始执行运动
-                    if (!motionController_->startMotion()) {
-                        spdlog::error("启动运动失败");
-                        return false;
-                    }
+                if (state.job && state.job->status.phase == "running") {
+                    // 新的作业替代运行中的作业：先停止运动并清除剩余轨迹，否则控制器仍在执行旧轨迹，新作业无法启动
+                    state.isProcessing = false;
+                    retireJob(state, *state.job, "cancelled", "被新的作业替代");
+                    state.controller->emergencyStop();
+                    state.controller->clearTrajectory();
                 }
                 
-                // 开始加工流程
-                isProcessing = true;
-                currentFile_ = filename;
-                lastUpdateTime_ = std::chrono::steady_clock::now();
+                state.job = createJob(cmdJson["filename"].get<std::string>(), "parsing");
+                result["jobId"] = state.job->status.id;
+                result["phase"] = state.job->status.phase;
+                spdlog::info("提交作业 {}，加工文件: {}", state.job->status.id, state.job->status.file);
+                jobSignal_.notify_all();
                 return true;
             } else if (command == "motion.stop") {
-                // 停止加工
+                // 停止加工，同时取消正在准备的作业并暂停作业队列
                 spdlog::info("停止加工");
                 std::lock_guard<std::mutex> lock(mutex_);
-                isProcessing = false;
-                
-                // 确保停止所有轴的运动
-                spdlog::info("调用 emergencyStop");
-                bool stopResult = motionController_->emergencyStop();
-                spdlog::info("emergencyStop 结果: {}", stopResult ? "成功" : "失败");
-                
-                // 清除运动规划
-                spdlog::info("调用 clearTrajectory");
-                motionController_->clearTrajectory();
-                
-                // 等待轴停止运动
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
-                
-                // 清除当前文件
-                currentFile_.clear();
-                
-                spdlog::info("加工已停止");
+                stopMachining(state);
+                return true;
+            } else if (command == "job.cancel") {
+                // 取消作业：准备中的作业在下一批规划前结束，运行中的作业停止加工；可用 jobId 指定作业
+                std::lock_guard<std::mutex> lock(mutex_);
+                const Job* job = state.job.get();
+                uint64_t jobId = 0;
+                if (cmdJson.contains("jobId") && (!readUnsigned(cmdJson, "jobId", jobId) || !job || jobId != job->status.id)) {
+                    spdlog::warn("作业不存在或已结束");
+                    return false;
+                }
+                if (!job || (!isJobPreparing(job->status) && job->status.phase != "running")) {
+                    spdlog::warn("当前没有可取消的作业");
+                    return false;
+                }
+                result["jobId"] = job->status.id;
+                stopMachining(state);
+                return true;
+            } else if (command == "queue.add") {
+                // 作业加入队列末尾，作业线程预先解析队首的作业
+                if (!cmdJson.contains("filename") || !cmdJson["filename"].is_string()) {
+                    spdlog::error("queue.add命令缺少filename参数");
+                    return false;
+                }
+                std::lock_guard<std::mutex> lock(mutex_);
+                state.jobQueue.push_back(createJob(cmdJson["filename"].get<std::string>(), "queued"));
+                result["jobId"] = state.jobQueue.back()->status.id;
+                result["position"] = state.jobQueue.size() - 1;
+                spdlog::info("作业 {} 加入队列，加工文件: {}", state.jobQueue.back()->status.id,
+                             state.jobQueue.back()->status.file);
+                jobSignal_.notify_all();
+                return true;
+            } else if (command == "queue.remove" || command == "queue.move") {
+                // 从队列中移除作业，或将作业移到指定位置（0 为队首）
+                uint64_t jobId = 0;
+                uint64_t position = 0;
+                if (!readUnsigned(cmdJson, "jobId", jobId)) {
+                    spdlog::error("{}命令缺少jobId参数", command);
+                    return false;
+                }
+                if (command == "queue.move" && !readUnsigned(cmdJson, "position", position)) {
+                    spdlog::error("queue.move命令缺少position参数");
+                    return false;
+                }
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto it = std::find_if(state.jobQueue.begin(), state.jobQueue.end(),
+                                       [jobId](const std::shared_ptr<Job>& job) { return job->status.id == jobId; });
+                if (it == state.jobQueue.end()) {
+                    spdlog::warn("作业 {} 不在队列中", jobId);
+                    return false;
+                }
+                std::shared_ptr<Job> job = *it;
+                state.jobQueue.erase(it);
+                if (command == "queue.remove") {
+                    // 正在预先解析的作业在下一次报告进度时中止
+                    job->cancelRequested = true;
+                    retireJob(state, *job, "cancelled", "");
+                } else {
+                    position = std::min<uint64_t>(position, state.jobQueue.size());
+                    state.jobQueue.insert(state.jobQueue.begin() + static_cast<std::ptrdiff_t>(position), job);
+                    result["position"] = position;
+                }
+                jobSignal_.notify_all();
+                return true;
+            } else if (command == "queue.start" || command == "queue.pause") {
+                // 启动后当前作业结束时自动开始队首的作业；停止加工或作业失败时自动暂停
+                std::lock_guard<std::mutex> lock(mutex_);
+                state.queueRunning = command == "queue.start";
+                spdlog::info("作业队列{}", state.queueRunning ? "已启动" : "已暂停");
+                jobSignal_.notify_all();
+                return true;
+            } else if (command == "queue.list") {
+                // 返回当前作业、排队的作业和最近结束的作业，结束的作业带有各阶段时间，用于统计产量
+                std::lock_guard<std::mutex> lock(mutex_);
+                result["running"] = state.queueRunning;
+                result["current"] = state.job ? WebAPI::jobToJson(state.job->status) : nlohmann::json();
+                result["queue"] = nlohmann::json::array();
+                for (const auto& job : state.jobQueue) {
+                    result["queue"].push_back(WebAPI::jobToJson(job->status));
+                }
+                result["history"] = nlohmann::json::array();
+                for (const JobStatus& job : state.jobHistory) {
+                    result["history"].push_back(WebAPI::jobToJson(job));
+                }
+                return true;
+            } else if (command == "motion.hold") {
+                // 进给保持：沿路径受控减速停止，保留剩余轨迹
+                spdlog::info("进给保持");
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!state.controller->feedHold()) {
+                    spdlog::warn("当前无运动，忽略进给保持请求");
+                    return false;
+                }
+                return true;
+            } else if (command == "motion.resume") {
+                // 从进给保持点恢复运行
+                spdlog::info("恢复运行");
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!state.controller->resume()) {
+                    spdlog::warn("当前不处于进给保持状态，忽略恢复请求");
+                    return false;
+                }
                 return true;
             } else if (command == "trajectory.clear") {
                 // 清除轨迹历史
@@ -264,15 +341,16 @@ public:
                 std::lock_guard<std::mutex> lock(mutex_);
                 
                 // 记录当前轨迹点数量
-                spdlog::info("当前轨迹历史点数: {}", trajectoryHistory_.size());
+                spdlog::info("当前轨迹历史点数: {}", state.trajectoryHistory->size());
                 
-                // 清除轨迹历史
-                trajectoryHistory_.clear();
-                spdlog::info("轨迹历史已清除，当前点数: {}", trajectoryHistory_.size());
+                // 清除轨迹历史，序号继续递增，客户端据 trajectoryCleared 丢弃已清除的点
+                state.trajectoryHistory->clear();
+                state.clearedSequence = state.trajectoryHistory->getLatestSequence();
+                spdlog::info("轨迹历史已清除，当前点数: {}", state.trajectoryHistory->size());
                 
                 // 通知前端清除轨迹
                 spdlog::info("通知前端清除轨迹");
-                motionController_->clearTrajectory();
+                state.controller->clearTrajectory();
                 
                 spdlog::info("轨迹清除完成");
                 return true;
@@ -331,6 +409,9 @@ public:
             file.write(content.c_str(), content.size());
             file.close();
             
+            // 修改时间的精度可能不足以区分同一秒内的两次上传，直接移除缓存的解析结果
+            parseCache_.erase(file_path);
+            
             if (std::filesystem::exists(file_path)) {
                 spdlog::info("文件已成功写入: {}, 大小: {} 字节", 
                            file_path.string(), 
@@ -351,6 +432,90 @@ public:
 
     // 文件解析API
     FileParseResponse parseFile(const std::string& filename) override {
+        return *parseCached(filename, nullptr);
+    }
+
+    std::shared_ptr<const FileParseResponse> parseFileShared(const std::string& filename) override {
+        return parseCached(filename, nullptr);
+    }
+
+    // 配置管理API
+    ConfigResponse getConfig() override {
+        ConfigResponse response;
+        response.config["feedRate"] = std::to_string(currentFeedRate_);
+        return response;
+    }
+
+    bool updateConfig(const ConfigData& config) override {
+        try {
+            auto it = config.config.find("feedRate");
+            if (it != config.config.end()) {
+                currentFeedRate_ = std::stod(it->second);
+                spdlog::info("更新进给速度: {}", currentFeedRate_);
+            }
+            return true;
+        } catch (const std::exception& e) {
+            spdlog::error("更新配置出错: {}", e.what());
+            return false;
+        }
+    }
+
+private:
+    // 实时控制循环配置；不锁定内存：mlockall 会常驻整个服务进程，包括各通道的轨迹历史和解析缓存，
+    // 控制循环访问的插补器和轴状态在配置时已分配
+    static motion::RealTimeLoopOptions realTimeLoopOptions() {
+        motion::RealTimeLoopOptions loopOptions;
+        loopOptions.priority = 80;
+        return loopOptions;
+    }
+
+    /**
+     * @brief 加工作业，保存解析结果直到规划完成
+     */
+    struct Job {
+        JobStatus status;                           ///< 作业状态
+        bool cancelRequested = false;               ///< 是否请求取消
+        std::shared_ptr<const FileParseResponse> program; ///< 解析结果，与解析缓存共享；未解析时为空
+    };
+
+    /**
+     * @brief 通道的运动控制器和加工状态
+     */
+    struct ChannelState {
+        std::shared_ptr<motion::MotionController> controller;      ///< 运动控制器
+        std::array<int, 3> positionAxisIndex{{-1, -1, -1}};         ///< 状态快照中 X/Y/Z 的轴索引
+        bool isProcessing = false;                                  ///< 是否在加工
+        std::string currentFile;                                    ///< 当前加工文件
+        std::shared_ptr<const FileParseResponse> program;           ///< 当前加工文件的解析结果，轨迹点据行号引用各行
+        std::unique_ptr<TrajectoryHistory> trajectoryHistory;       ///< 轨迹历史，序号递增
+        uint64_t clearedSequence = 0;                               ///< 最近一次清除时的最新序号
+        std::shared_ptr<Job> job;                                   ///< 当前作业：正在准备、运行或最近结束的作业
+        std::deque<std::shared_ptr<Job>> jobQueue;                  ///< 排队的作业
+        bool queueRunning = false;                                  ///< 当前作业结束后是否自动开始队首的作业
+        std::deque<JobStatus> jobHistory;                           ///< 最近结束的作业，用于统计产量
+        uint64_t motionStartTick = 0;                               ///< 开始运动时的快照序号
+        std::thread jobWorker;                                      ///< 作业线程
+    };
+
+    /// 解析时每隔多少行报告一次进度
+    static constexpr int kParseProgressLines = 4096;
+
+    /// 规划时每批的线段数，批与批之间释放锁，状态查询和其他命令不必等待整个文件规划完成
+    static constexpr size_t kPlanningBatch = 256;
+
+    /// 运行中检查插补是否完成的周期
+    static constexpr std::chrono::milliseconds kJobPollPeriod{5};
+
+    /// 保留的已结束作业个数
+    static constexpr size_t kJobHistoryLimit = 100;
+
+    /**
+     * @brief 解析加工文件
+     * @param filename 上传目录中的文件名
+     * @param progress 进度回调，参数为已读取的行数，返回false时中止解析；可为空
+     * @return 解析结果
+     */
+    FileParseResponse parseProgram(const std::string& filename, const std::function<bool(size_t)>& progress) {
         FileParseResponse response;
         try {
             std::filesystem::path file_path = std::filesystem::current_path() / "uploads" / filename;
@@ -365,8 +530,15 @@ public:
 
             spdlog::info("文件已成功打开，开始解析");
             std::string line;
+            int lineNumber = 0;
             while (std::getline(file, line)) {
+                ++lineNumber;
                 response.toolPathDetails.push_back(line);
+                if (progress && lineNumber % kParseProgressLines == 0 && !progress(response.toolPathDetails.size())) {
+                    spdlog::info("文件解析已取消，已读取{}行", lineNumber);
+                    response.error = "已取消";
+                    return response;
+                }
 
                 // 解析G代码行
                 if (line.find('G') != std::string::npos) {
@@ -377,6 +549,7 @@ public:
                     // 检查是否为快速定位（G0）
                     point.isRapid = (line.find("G0") != std::string::npos);
                     point.command = line;
+                    point.lineNumber = lineNumber;
 
                     while (iss >> word) {
                         if (word[0] == 'X') {
@@ -404,30 +577,287 @@ public:
         return response;
     }
 
-    // 配置管理API
-    ConfigResponse getConfig() override {
-        ConfigResponse response;
-        response.config["feedRate"] = std::to_string(currentFeedRate_);
-        return response;
+    /**
+     * @brief 通过解析结果缓存获取文件的解析结果
+     * @details 同一文件的并发请求只解析一次；progress 只在本次请求实际执行解析时被调用，
+     *          被它中止的解析结果只返回给本次请求，同时等待的请求重新解析
+     */
+    std::shared_ptr<const FileParseResponse> parseCached(const std::string& filename,
+                                                         const std::function<bool(size_t)>& progress) {
+        return parseCache_.get(std::filesystem::current_path() / "uploads" / filename,
+                               [this, &filename, &progress](FileParseResponse& response) {
+            bool cancelled = false;
+            std::function<bool(size_t)> tracked;
+            if (progress) {
+                tracked = [&progress, &cancelled](size_t lines) {
+                    cancelled = !progress(lines);
+                    return !cancelled;
+                };
+            }
+            response = parseProgram(filename, tracked);
+            return !cancelled;
+        });
     }
 
-    bool updateConfig(const ConfigData& config) override {
-        try {
-            auto it = config.config.find("feedRate");
-            if (it != config.config.end()) {
-                currentFeedRate_ = std::stod(it->second);
-                spdlog::info("更新进给速度: {}", currentFeedRate_);
-            }
-            return true;
-        } catch (const std::exception& e) {
-            spdlog::error("更新配置出错: {}", e.what());
+    // 读取命令中的非负整数字段
+    static bool readUnsigned(const nlohmann::json& cmdJson, const char* key, uint64_t& value) {
+        if (!cmdJson.contains(key) || !cmdJson[key].is_number_integer() ||
+            (cmdJson[key].is_number_unsigned() ? false : cmdJson[key].get<int64_t>() < 0)) {
             return false;
         }
+        value = cmdJson[key].get<uint64_t>();
+        return true;
+    }
+
+    // 作业是否处于准备阶段（解析或规划）
+    static bool isJobPreparing(const JobStatus& job) {
+        return job.phase == "parsing" || job.phase == "planning";
+    }
+
+    // 当前时间的 Unix 毫秒时间戳
+    static uint64_t nowMs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+
+    // 创建作业，调用时需持有 mutex_
+    std::shared_ptr<Job> createJob(const std::string& filename, const std::string& phase) {
+        auto job = std::make_shared<Job>();
+        job->status.id = ++lastJobId_;
+        job->status.phase = phase;
+        job->status.file = filename;
+        job->status.queuedAt = nowMs();
+        return job;
+    }
+
+    // 结束作业并记入历史，调用时需持有 mutex_；当前作业失败或被取消时暂停作业队列
+    void retireJob(ChannelState& state, Job& job, const std::string& phase, const std::string& error) {
+        job.status.phase = phase;
+        job.status.error = error;
+        job.status.finishedAt = nowMs();
+        job.program.reset();
+        state.jobHistory.push_back(job.status);
+        if (state.jobHistory.size() > kJobHistoryLimit) {
+            state.jobHistory.pop_front();
+        }
+        if (&job == state.job.get() && phase != "completed") {
+            state.queueRunning = false;
+        }
+        if (phase == "failed") {
+            spdlog::error("作业 {} 失败: {}", job.status.id, error);
+        } else {
+            spdlog::info("作业 {} 结束: {}", job.status.id, phase);
+        }
+    }
+
+    // 插补完成时结束运行中的作业，控制循环上报故障时作业失败，调用时需持有 mutex_；
+    // 启动运动前发布的快照不作为依据
+    void checkJobFinished(ChannelState& state, const motion::MotionController::Snapshot& snapshot) {
+        if (!state.isProcessing || !state.job) {
+            return;
+        }
+        if (snapshot.tick > state.motionStartTick + 1 &&
+            snapshot.motionState == motion::MotionController::MotionState::Error) {
+            // 故障后剩余的段不再执行；规划中的作业在下一批规划前结束
+            state.controller->serviceFault();
+            state.controller->clearTrajectory();
+            state.isProcessing = false;
+            retireJob(state, *state.job, "failed", "运动指令执行失败，已停止");
+            jobSignal_.notify_all();
+            return;
+        }
+        if (state.job->status.phase != "running") {
+            return;
+        }
+        if (snapshot.tick > state.motionStartTick + 1 && snapshot.interpolationFinished) {
+            state.isProcessing = false;
+            spdlog::info("加工完成");
+            retireJob(state, *state.job, "completed", "");
+            jobSignal_.notify_all();
+        }
+    }
+
+    // 作业线程：解析和规划当前作业，预先解析队首的作业，当前作业结束后开始队首的作业
+    void runJobWorker(ChannelState& state) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_) {
+            checkJobFinished(state, state.controller->getSnapshot());
+            const std::shared_ptr<Job> job = state.job;
+            const bool idle = !job || (!isJobPreparing(job->status) && job->status.phase != "running");
+            
+            if (job && job->status.phase == "parsing") {
+                parseJob(state, job, lock);
+            } else if (job && job->status.phase == "planning") {
+                planJob(state, job, lock);
+            } else if (idle && state.queueRunning && !state.jobQueue.empty()) {
+                // 当前作业已结束，开始队首的作业；已预先解析的直接规划
+                state.job = state.jobQueue.front();
+                state.jobQueue.pop_front();
+                state.job->status.phase = state.job->program ? "planning" : "parsing";
+                spdlog::info("开始队列中的作业 {}", state.job->status.id);
+            } else if (!state.jobQueue.empty() && state.jobQueue.front()->status.phase == "queued") {
+                parseJob(state, state.jobQueue.front(), lock);
+            } else if (state.isProcessing) {
+                // 运行中定期检查插补是否完成，无客户端查询状态时也能及时开始下一个作业
+                jobSignal_.wait_for(lock, kJobPollPeriod);
+            } else {
+                jobSignal_.wait(lock);
+            }
+        }
+    }
+
+    // 解析作业，解析期间释放 mutex_；当前作业解析后进入规划，排队的作业解析后等待开始
+    void parseJob(ChannelState& state, std::shared_ptr<Job> job, std::unique_lock<std::mutex>& lock) {
+        job->status.phase = "parsing";
+        const std::string filename = job->status.file;
+        lock.unlock();
+        auto program = parseCached(filename, [this, &state, &job](size_t lines) {
+            std::lock_guard<std::mutex> guard(mutex_);
+            job->status.parsedLines = lines;
+            // 预先解析期间当前作业可能结束
+            checkJobFinished(state, state.controller->getSnapshot());
+            return !job->cancelRequested && !stopping_;
+        });
+        lock.lock();
+        
+        const bool current = job == state.job;
+        if (job->cancelRequested || stopping_) {
+            // 被移出队列的作业已记入历史
+            if (current) {
+                retireJob(state, *job, "cancelled", "");
+            }
+            return;
+        }
+        if (!program->success) {
+            auto it = std::find(state.jobQueue.begin(), state.jobQueue.end(), job);
+            if (it != state.jobQueue.end()) {
+                state.jobQueue.erase(it);
+            }
+            retireJob(state, *job, "failed", "解析文件失败: " + program->error);
+            return;
+        }
+        
+        spdlog::info("成功加载轨迹点: {} 个", program->trajectoryPoints.size());
+        job->program = std::move(program);
+        job->status.parsedLines = job->program->toolPathDetails.size();
+        job->status.totalSegments = job->program->trajectoryPoints.size();
+        job->status.parsedAt = nowMs();
+        job->status.phase = current ? "planning" : "ready";
+    }
+
+    // 分批规划当前作业，第一批规划后即开始运动，其余各批在运动中追加；批与批之间释放 mutex_
+    void planJob(ChannelState& state, std::shared_ptr<Job> job, std::unique_lock<std::mutex>& lock) {
+        const std::shared_ptr<const FileParseResponse> program = job->program;
+        const std::vector<TrajectoryPoint>& trajectoryPoints = program->trajectoryPoints;
+        state.currentFile = job->status.file;
+        if (trajectoryPoints.empty()) {
+            job->status.startedAt = nowMs();
+            retireJob(state, *job, "completed", "");
+            return;
+        }
+        
+        // 确保所有轴都已使能
+        state.controller->enableAllAxes();
+        
+        // 清除之前的运动规划
+        state.controller->clearTrajectory();
+        
+        // 保留各行文本，记录轨迹历史时按行号引用
+        state.program = program;
+        
+        // 使用运动控制器规划路径
+        for (size_t begin = 0; begin < trajectoryPoints.size(); begin += kPlanningBatch) {
+            if (job->cancelRequested || stopping_) {
+                state.controller->clearTrajectory();
+                retireJob(state, *job, "cancelled", "");
+                return;
+            }
+            checkJobFinished(state, state.controller->getSnapshot());
+            if (job->status.phase != "planning") {
+                return;
+            }
+            
+            const size_t end = std::min(trajectoryPoints.size(), begin + kPlanningBatch);
+            for (size_t i = begin; i < end; ++i) {
+                const auto& point = trajectoryPoints[i];
+                
+                // 设置进给速度
+                double feedRate = point.isRapid ? 3000.0 : currentFeedRate_;
+                
+                // 执行直线插补运动
+                if (!state.controller->moveLinear(core::motion::Point(point.x, point.y, point.z), feedRate,
+                                                  point.lineNumber)) {
+                    spdlog::error("运动规划失败，位置: ({}, {}, {})", point.x, point.y, point.z);
+                    state.controller->emergencyStop();
+                    state.controller->clearTrajectory();
+                    state.isProcessing = false;
+                    retireJob(state, *job, "failed", "运动规划失败，行号: " + std::to_string(point.lineNumber));
+                    return;
+                }
+            }
+            job->status.plannedSegments = end;
+            
+            // 开始执行运动；运动中追加的段连续执行，若已执行完已规划的段则重新启动
+            if (!state.controller->getSnapshot().moving || !state.isProcessing) {
+                const bool started = state.controller->startMotion();
+                if (!state.isProcessing) {
+                    if (!started) {
+                        state.controller->clearTrajectory();
+                        retireJob(state, *job, "failed", "启动运动失败");
+                        return;
+                    }
+                    state.isProcessing = true;
+                    state.motionStartTick = state.controller->getSnapshot().tick;
+                    job->status.startedAt = nowMs();
+                    lastUpdateTime_ = std::chrono::steady_clock::now();
+                }
+            }
+            
+            lock.unlock();
+            std::this_thread::yield();
+            lock.lock();
+        }
+        
+        if (job->cancelRequested || stopping_) {
+            state.controller->clearTrajectory();
+            retireJob(state, *job, "cancelled", "");
+            return;
+        }
+        spdlog::info("成功规划运动路径");
+        job->program.reset();
+        job->status.phase = "running";
+    }
+
+    // 停止加工并暂停作业队列，调用时需持有 mutex_；准备中的作业由作业线程在下一批规划前结束
+    void stopMachining(ChannelState& state) {
+        state.queueRunning = false;
+        if (state.job && isJobPreparing(state.job->status)) {
+            spdlog::info("取消作业 {}", state.job->status.id);
+            state.job->cancelRequested = true;
+        } else if (state.job && state.job->status.phase == "running") {
+            retireJob(state, *state.job, "cancelled", "");
+        }
+        state.isProcessing = false;
+        
+        // 确保停止所有轴的运动
+        spdlog::info("调用 emergencyStop");
+        bool stopResult = state.controller->emergencyStop();
+        spdlog::info("emergencyStop 结果: {}", stopResult ? "成功" : "失败");
+        
+        // 清除运动规划
+        spdlog::info("调用 clearTrajectory");
+        state.controller->clearTrajectory();
+        
+        // emergencyStop 已立即停止各轴，不在持有 mutex_ 时等待，以免阻塞状态采样和推送
+        
+        // 清除当前文件
+        state.currentFile.clear();
+        
+        spdlog::info("加工已停止");
     }
 
-private:
     // 初始化运动控制器
-    void initializeMotionController() {
+    void initializeMotionController(ChannelState& channel) {
         // 添加X轴
         motion::AxisParameters xAxisParams;
         xAxisParams.maxVelocity = 500.0;       // mm/s
@@ -436,7 +866,7 @@ private:
         xAxisParams.homePosition = 0.0;        // mm
         xAxisParams.softLimitMin = -1000.0;    // mm
         xAxisParams.softLimitMax = 1000.0;     // mm
-        motionController_->addAxis("X", xAxisParams);
+        channel.controller->addAxis("X", xAxisParams);
         
         // 添加Y轴
         motion::AxisParameters yAxisParams;
@@ -446,7 +876,7 @@ private:
         yAxisParams.homePosition = 0.0;        // mm
         yAxisParams.softLimitMin = -1000.0;    // mm
         yAxisParams.softLimitMax = 1000.0;     // mm
-        motionController_->addAxis("Y", yAxisParams);
+        channel.controller->addAxis("Y", yAxisParams);
         
         // 添加Z轴
         motion::AxisParameters zAxisParams;
@@ -456,21 +886,44 @@ private:
         zAxisParams.homePosition = 0.0;        // mm
         zAxisParams.softLimitMin = -500.0;     // mm
         zAxisParams.softLimitMax = 500.0;      // mm
-        motionController_->addAxis("Z", zAxisParams);
+        channel.controller->addAxis("Z", zAxisParams);
         
         // 设置插补周期
-        motionController_->setInterpolationPeriod(1); // 1ms
+        channel.controller->setInterpolationPeriod(1); // 1ms
+        
+        // 在配置时解析状态快照中 X/Y/Z 的轴索引
+        channel.positionAxisIndex = {
+            channel.controller->getAxisIndex("X"),
+            channel.controller->getAxisIndex("Y"),
+            channel.controller->getAxisIndex("Z")
+        };
         
         spdlog::info("运动控制器初始化完成");
     }
 
-    std::shared_ptr<motion::MotionController> motionController_;
-    bool isProcessing = false;
+    // 从状态快照读取 X/Y/Z 位置
+    static bool readSnapshotPosition(const ChannelState& channel, const motion::MotionController::Snapshot& snapshot,
+                                     StatusResponse& response) {
+        for (int index : channel.positionAxisIndex) {
+            if (index < 0 || static_cast<size_t>(index) >= snapshot.axisCount) {
+                return false;
+            }
+        }
+        response.position.x = snapshot.positions[channel.positionAxisIndex[0]];
+        response.position.y = snapshot.positions[channel.positionAxisIndex[1]];
+        response.position.z = snapshot.positions[channel.positionAxisIndex[2]];
+        return true;
+    }
+
+    motion::ChannelManager channelManager_;   // 各通道的实时控制循环
+    ParseCache parseCache_;                   // 解析结果缓存，各通道和文件解析API共用
+    std::vector<ChannelState> channels_;      // 各通道状态，下标即通道编号
     double currentFeedRate_ = 1000.0; // mm/min
-    std::string currentFile_;
     std::chrono::time_point<std::chrono::steady_clock> lastUpdateTime_;
+    uint64_t lastJobId_ = 0;          // 最近分配的作业编号，各通道共用
+    bool stopping_ = false;           // 析构时通知作业线程退出
     std::mutex mutex_;
-    std::vector<TrajectoryPoint> trajectoryHistory_; // 存储轨迹历史
+    std::condition_variable jobSignal_; // 作业提交、取消、队列变化或作业结束时唤醒各通道的作业线程
 };
 
 } // namespace web
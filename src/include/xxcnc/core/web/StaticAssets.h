@@ -0,0 +1,90 @@
+#pragma once
+
+#include "HttpCompression.h"
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace xxcnc {
+namespace web {
+
+/**
+ * @brief 加载到内存中的静态资源，加载后不再修改，由所有请求共享
+ */
+struct StaticAsset {
+    std::string contentType;    ///< MIME 类型
+    std::string cacheControl;   ///< Cache-Control 响应头
+    std::string etag;           ///< 原始内容的强实体标签，由内容哈希生成
+    std::string identity;       ///< 原始内容
+    std::string gzip;           ///< gzip 压缩的内容，不比原始内容小时为空
+    std::string brotli;         ///< br 压缩的内容，不比原始内容小时为空
+
+    /**
+     * @brief 获取指定编码的内容
+     * @param encoding 编码，没有该编码的内容时返回原始内容
+     */
+    const std::string& body(ContentEncoding encoding) const;
+
+    /**
+     * @brief 获取指定编码内容的实体标签，各编码的内容字节不同，实体标签也不同
+     * @param encoding 编码
+     */
+    std::string etagFor(ContentEncoding encoding) const;
+};
+
+/**
+ * @brief 静态资源集合
+ * @details 启动时一次性读取目录下的所有文件，可压缩的类型预先生成 gzip 和 br 版本，请求时按
+ *          Accept-Encoding 直接返回内存中的内容，不再访问磁盘或压缩。HTML 页面每次向服务器确认
+ *          （no-cache），其他资源允许浏览器缓存一段时间；两者都可以用 If-None-Match 得到 304。
+ *
+ *          资源在 load 之后不随磁盘文件更新，修改静态文件后需重新启动服务器。
+ */
+class StaticAssets {
+public:
+    /// HTML 以外资源的浏览器缓存时间（秒）
+    static constexpr int kMaxAge = 3600;
+
+    /**
+     * @brief 递归加载目录下的所有文件，替换已加载的资源
+     * @details 需在服务器开始处理请求前调用
+     * @param root 静态资源目录
+     * @return 目录存在且所有文件读取成功时返回true
+     */
+    bool load(const std::filesystem::path& root);
+
+    /**
+     * @brief 按请求路径查找资源，目录路径返回其下的 index.html
+     * @param path 请求路径，如 "/"、"/js/main.js"
+     * @return 资源，不存在时返回 nullptr
+     */
+    std::shared_ptr<const StaticAsset> find(const std::string& path) const;
+
+    /**
+     * @brief 获取资源个数
+     * @return 资源个数
+     */
+    size_t size() const;
+
+    /**
+     * @brief 获取所有资源（含压缩版本）占用的内存
+     * @return 字节数
+     */
+    size_t getMemoryUsage() const;
+
+    /**
+     * @brief 按扩展名获取 MIME 类型
+     * @param path 文件路径
+     * @return MIME 类型，未知扩展名返回 application/octet-stream
+     */
+    static std::string contentType(const std::filesystem::path& path);
+
+private:
+    std::unordered_map<std::string, std::shared_ptr<const StaticAsset>> assets_;  ///< 请求路径到资源的索引
+    size_t bytes_ = 0;                                                           ///< 资源占用的内存
+};
+
+} // namespace web
+} // namespace xxcnc
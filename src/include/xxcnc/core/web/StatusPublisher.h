@@ -0,0 +1,80 @@
+#pragma once
+
+#include "WebTypes.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace xxcnc {
+namespace web {
+
+/**
+ * @brief 发布的状态文档，发布后不再修改，由所有请求和推送连接共享
+ */
+struct PublishedStatus {
+    int channel = 0;            ///< 通道编号
+    StatusResponse status;      ///< 状态，不含轨迹点
+    std::string json;           ///< 序列化后的状态文档
+    uint64_t version = 0;       ///< 版本，文档内容变化时递增
+    std::string etag;           ///< 实体标签，由进程标识、通道和版本组成
+};
+
+/**
+ * @brief 状态发布器：每个发布周期最多采样和序列化一次状态
+ * @details 任意数量的客户端在同一周期内读取到的是同一份文档，采样（需要获取运动控制器的锁）和序列化的
+ *          代价与客户端数量无关。文档内容与上一次相同时沿用原来的版本和实体标签，
+ *          客户端可以据此用 If-None-Match 得到 304。
+ */
+class StatusPublisher {
+public:
+    /// 采样函数：读取通道状态，通道无效时返回false
+    using Sampler = std::function<bool(int channel, StatusResponse& status)>;
+
+    /// 序列化函数
+    using Serializer = std::function<std::string(const StatusResponse& status)>;
+
+    /**
+     * @brief 构造函数
+     * @param sampler 采样函数
+     * @param serializer 序列化函数
+     */
+    StatusPublisher(Sampler sampler, Serializer serializer);
+
+    /**
+     * @brief 获取通道的状态文档，文档早于 maxAge 时重新采样
+     * @param channel 通道编号
+     * @param maxAge 文档的最大存在时间，通常为一个发布周期
+     * @return 状态文档，通道无效时返回 nullptr
+     */
+    std::shared_ptr<const PublishedStatus> acquire(int channel, std::chrono::steady_clock::duration maxAge);
+
+    /**
+     * @brief 获取累计采样次数
+     * @return 采样次数
+     */
+    uint64_t getSampleCount() const;
+
+private:
+    /**
+     * @brief 通道最近发布的文档
+     */
+    struct Slot {
+        std::shared_ptr<const PublishedStatus> document;    ///< 最近发布的文档
+        std::chrono::steady_clock::time_point sampledAt;    ///< 最近采样时间
+    };
+
+    Sampler sampler_;                   ///< 采样函数
+    Serializer serializer_;             ///< 序列化函数
+    std::string instance_;              ///< 进程标识，避免重启后实体标签与之前的重复
+    mutable std::mutex mutex_;          ///< 保护以下成员，同一时刻只有一个线程采样
+    std::vector<Slot> slots_;           ///< 各通道最近发布的文档
+    uint64_t version_ = 0;              ///< 最近分配的版本
+    uint64_t samples_ = 0;              ///< 累计采样次数
+};
+
+} // namespace web
+} // namespace xxcnc
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "WebTypes.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace xxcnc {
+namespace web {
+
+/// 二进制轨迹的 Content-Type
+constexpr const char* kBinaryTrajectoryContentType = "application/x-xxcnc-trajectory";
+
+/**
+ * @brief 二进制轨迹的头部信息
+ */
+struct BinaryTrajectoryHeader {
+    int32_t channel = 0;            ///< 通道编号
+    uint64_t firstSequence = 0;     ///< 第一个点的序号；不属于轨迹历史时为0，此时不输出序号列
+    uint64_t latestSequence = 0;    ///< 轨迹历史中最新点的序号
+    uint64_t clearedSequence = 0;   ///< 最近一次清除轨迹历史时的最新序号
+    bool more = false;              ///< 是否还有后续点未返回
+};
+
+/**
+ * @brief 二进制轨迹编码器
+ * @details 格式为小端序，各数组按 4 字节对齐，可直接作为 Float32Array / Int32Array 视图使用：
+ *
+ *          偏移  类型        内容
+ *          0     u32         魔数 "XXTJ"
+ *          4     u16         版本号
+ *          6     u16         标志，bit0 表示 more，bit1 表示带序号列
+ *          8     u32         点数 n
+ *          12    i32         通道编号
+ *          16    u64         第一个点的序号
+ *          24    u64         最新点的序号
+ *          32    u64         清除序号
+ *          40    f32[3n]     各点的 x、y、z，交错存放
+ *          ..    u8[n]       各点的标志，bit0 表示快速定位，末尾补零到 4 字节对齐
+ *          ..    i32[n]      各点的源文件行号
+ *          ..    u64[n]      各点的序号，仅在带序号列时存在
+ *
+ *          轨迹历史抽稀后序号不再连续，因此第一个点的序号不为0时逐点输出序号。
+ *          每点 17 字节（带序号列时 25 字节），不含 G 代码文本。编码按块进行，每次生成不超过指定大小的数据，
+ *          用于分块传输，不需要一次构造整个响应。
+ */
+class BinaryTrajectoryEncoder {
+public:
+    static constexpr uint32_t kMagic = 0x4A545858;     ///< "XXTJ"
+    static constexpr uint16_t kVersion = 2;            ///< 格式版本
+    static constexpr size_t kHeaderSize = 40;          ///< 头部字节数
+    static constexpr uint16_t kFlagMore = 0x1;         ///< 头部标志：还有后续点
+    static constexpr uint16_t kFlagSequences = 0x2;    ///< 头部标志：带序号列
+    static constexpr uint8_t kPointRapid = 0x1;        ///< 点标志：快速定位
+    static constexpr size_t kDefaultChunkSize = 64 * 1024;  ///< 默认块大小
+
+    /**
+     * @brief 构造函数
+     * @param points 轨迹点
+     * @param header 头部信息
+     */
+    BinaryTrajectoryEncoder(std::vector<TrajectoryPoint> points, const BinaryTrajectoryHeader& header);
+
+    /**
+     * @brief 构造函数，共享调用方的轨迹点而不复制
+     * @param points 轨迹点，编码期间不得修改
+     * @param header 头部信息
+     */
+    BinaryTrajectoryEncoder(std::shared_ptr<const std::vector<TrajectoryPoint>> points,
+                            const BinaryTrajectoryHeader& header);
+
+    /**
+     * @brief 获取编码后的总字节数
+     * @return 字节数
+     */
+    size_t getEncodedSize() const;
+
+    /**
+     * @brief 生成下一块数据
+     * @param chunk 输出缓冲区，清空后写入
+     * @param maxBytes 块的最大字节数，至少为头部大小
+     * @return 生成了数据时返回true，已全部生成时返回false
+     */
+    bool nextChunk(std::string& chunk, size_t maxBytes = kDefaultChunkSize);
+
+    /**
+     * @brief 一次编码全部数据
+     * @param points 轨迹点
+     * @param header 头部信息
+     * @return 编码结果
+     */
+    static std::string encode(std::vector<TrajectoryPoint> points, const BinaryTrajectoryHeader& header);
+
+    /**
+     * @brief 解码
+     * @param data 编码数据
+     * @param header 输出的头部信息
+     * @param points 输出的轨迹点，不含 G 代码文本
+     * @return 格式有效时返回true
+     */
+    static bool decode(const std::string& data, BinaryTrajectoryHeader& header, std::vector<TrajectoryPoint>& points);
+
+private:
+    /**
+     * @brief 编码阶段
+     */
+    enum class Section {
+        Header,
+        Positions,
+        Flags,
+        LineNumbers,
+        Sequences,
+        Done
+    };
+
+    std::shared_ptr<const std::vector<TrajectoryPoint>> points_;   ///< 轨迹点
+    BinaryTrajectoryHeader header_;         ///< 头部信息
+    Section section_ = Section::Header;     ///< 当前编码阶段
+    size_t index_ = 0;                      ///< 当前阶段已编码的点数
+};
+
+} // namespace web
+} // namespace xxcnc
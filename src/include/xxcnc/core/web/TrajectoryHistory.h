@@ -0,0 +1,175 @@
+#pragma once
+
+#include "WebTypes.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace xxcnc {
+namespace web {
+
+/**
+ * @brief 固定内存的轨迹历史
+ * @details 按列存储：坐标为 float，标志为 u8，行号为 i32，G 代码文本存入按引用计数去重的命令表，
+ *          每点只保存命令表下标，另存 u64 序号，共 29 字节/点。各列在构造时按容量一次分配，
+ *          之后不再增长；命令表的文本另有每点 kCommandBytesPerPoint 字节的上限，超出上限时新点
+ *          不保存命令文本。
+ *
+ *          点数或命令表接近上限时开始对较早的一半隔点抽稀，因此越早的历史分辨率越低，但覆盖的时间
+ *          不受限制。抽稀逐步进行：每次追加只移动固定个数的点，已处理与未处理的点之间留有空隙，
+ *          在剩余容量用完前完成，追加为严格 O(1)，不会在持锁的追加中出现一次性的 O(容量) 复制。
+ *          序号严格递增；最近一次抽稀之后的点序号连续，从这一段读取时由序号直接算出下标（O(1)），
+ *          游标落在抽稀过的部分时二分查找。
+ */
+class TrajectoryHistory {
+public:
+    /// 默认容量（点），各列约 29 MB，命令表至多约 32 MB
+    static constexpr size_t kDefaultCapacity = 1000000;
+
+    /// 最小容量（点）
+    static constexpr size_t kMinCapacity = 16;
+
+    /// 命令表每点平均可用的字节数，命令表上限为容量乘以该值
+    static constexpr size_t kCommandBytesPerPoint = 32;
+
+    /**
+     * @brief 构造函数
+     * @param capacity 最多保存的点数，小于 kMinCapacity 时按 kMinCapacity
+     */
+    explicit TrajectoryHistory(size_t capacity = kDefaultCapacity);
+
+    /**
+     * @brief 追加轨迹点，序号由历史分配
+     * @param point 轨迹点，忽略其中的 sequence
+     * @return 分配的序号
+     */
+    uint64_t append(const TrajectoryPoint& point);
+
+    /**
+     * @brief 读取序号大于游标的点
+     * @param sinceSequence 游标，返回序号大于该值的点
+     * @param maxPoints 最多返回的点数
+     * @param points 输出的轨迹点，先清空
+     * @return 返回的点数
+     */
+    size_t read(uint64_t sinceSequence, size_t maxPoints, std::vector<TrajectoryPoint>& points) const;
+
+    /**
+     * @brief 获取最后一个点
+     * @param point 输出的轨迹点
+     * @return 历史为空时返回false
+     */
+    bool back(TrajectoryPoint& point) const;
+
+    /**
+     * @brief 清除全部点，序号继续递增
+     */
+    void clear();
+
+    /**
+     * @brief 获取点数
+     * @return 点数
+     */
+    size_t size() const { return size_; }
+
+    /**
+     * @brief 检查是否为空
+     * @return 是否为空
+     */
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @brief 获取容量
+     * @return 最多保存的点数
+     */
+    size_t capacity() const { return sequences_.size(); }
+
+    /**
+     * @brief 获取最新分配的序号
+     * @return 序号，尚未追加过点时为0
+     */
+    uint64_t getLatestSequence() const { return nextSequence_ - 1; }
+
+    /**
+     * @brief 获取命令表中的命令数
+     * @return 命令数
+     */
+    size_t getCommandCount() const { return commands_.size() - freeCommands_.size(); }
+
+    /**
+     * @brief 估算占用的内存
+     * @return 字节数，其中命令表部分受 kCommandBytesPerPoint 限制
+     */
+    size_t getMemoryUsage() const;
+
+private:
+    /// 点标志：快速定位
+    static constexpr uint8_t kRapid = 0x1;
+
+    /// 每次追加推进抽稀的步数，保证抽稀在剩余的八分之一容量用完前完成
+    static constexpr size_t kCompactionSteps = 9;
+
+    /**
+     * @brief 将命令加入命令表并增加引用计数
+     * @return 命令表下标，命令表超出上限时返回空命令的下标
+     */
+    uint32_t intern(const std::string& command);
+
+    /**
+     * @brief 减少命令的引用计数，不再被引用时从命令表移除
+     * @param id 命令表下标
+     */
+    void release(uint32_t id);
+
+    /**
+     * @brief 命令在命令表中占用的字节数
+     */
+    static size_t commandCost(const std::string& command);
+
+    /**
+     * @brief 开始对较早的一半隔点抽稀
+     */
+    void beginCompaction();
+
+    /**
+     * @brief 推进抽稀：每步丢弃或前移空隙后的一个点，全部处理完时消除空隙
+     * @param steps 最多处理的点数
+     */
+    void compactStep(size_t steps);
+
+    /**
+     * @brief 跳过空隙，将点的下标转换为存储位置
+     */
+    size_t physical(size_t index) const { return index < gapBegin_ ? index : index + (gapEnd_ - gapBegin_); }
+
+    std::vector<float> x_;                                  ///< X 坐标
+    std::vector<float> y_;                                  ///< Y 坐标
+    std::vector<float> z_;                                  ///< Z 坐标
+    std::vector<uint8_t> flags_;                            ///< 点标志
+    std::vector<int32_t> lineNumbers_;                      ///< 源文件行号
+    std::vector<uint32_t> commandIds_;                      ///< 命令表下标
+    std::vector<uint64_t> sequences_;                       ///< 序号
+    size_t size_ = 0;                                       ///< 点数
+    size_t denseBegin_ = 0;                                 ///< 从该存储位置起序号连续
+    uint64_t nextSequence_ = 1;                             ///< 下一个点的序号
+
+    // 抽稀状态，空隙 [gapBegin_, gapEnd_) 之前是已处理的点，之后是未处理的点和新追加的点
+    bool compacting_ = false;                               ///< 是否正在抽稀
+    size_t gapBegin_ = 0;                                   ///< 空隙起点，即下一个保留点的写入位置
+    size_t gapEnd_ = 0;                                     ///< 空隙终点，即下一个待处理的点
+    size_t compactHalf_ = 0;                                ///< 抽稀范围的终点（较早的一半）
+    size_t compactDense_ = 0;                               ///< 抽稀后序号连续部分的原存储位置
+    size_t nextDenseBegin_ = 0;                             ///< 抽稀后序号连续部分的新存储位置
+
+    std::vector<std::string> commands_;                     ///< 命令表
+    std::vector<uint32_t> commandRefs_;                     ///< 命令的引用计数
+    std::vector<uint32_t> freeCommands_;                    ///< 命令表中空闲的下标
+    std::unordered_map<std::string, uint32_t> commandIndex_;   ///< 命令到命令表下标的索引
+    size_t commandBytes_ = 0;                               ///< 命令表占用的字节数
+    size_t commandBudget_ = 0;                              ///< 命令表的字节上限
+};
+
+} // namespace web
+} // namespace xxcnc
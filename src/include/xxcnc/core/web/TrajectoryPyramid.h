@@ -0,0 +1,129 @@
+#pragma once
+
+#include "WebTypes.h"
+#include <cstddef>
+#include <vector>
+
+namespace xxcnc {
+namespace web {
+
+/**
+ * @brief 轨迹包围盒
+ */
+struct TrajectoryBounds {
+    double minX = 0.0;  ///< X 最小值
+    double minY = 0.0;  ///< Y 最小值
+    double minZ = 0.0;  ///< Z 最小值
+    double maxX = 0.0;  ///< X 最大值
+    double maxY = 0.0;  ///< Y 最大值
+    double maxZ = 0.0;  ///< Z 最大值
+
+    /**
+     * @brief 在 XY 平面上是否与另一个包围盒相交（含边界）
+     * @param other 另一个包围盒
+     * @return 是否相交
+     */
+    bool intersectsXY(const TrajectoryBounds& other) const {
+        return minX <= other.maxX && other.minX <= maxX && minY <= other.maxY && other.minY <= maxY;
+    }
+};
+
+/**
+ * @brief 轨迹金字塔的构建参数
+ */
+struct TrajectoryPyramidOptions {
+    double baseTolerance = 0.01;    ///< 第1层的容差（mm）
+    double levelFactor = 4.0;       ///< 相邻层的容差倍数
+    size_t tilePoints = 4096;       ///< 每个瓦片的点数
+    size_t maxLevels = 8;           ///< 最大层数（含第0层）
+    size_t minPoints = 1024;        ///< 点数不超过该值时不再构建更粗的层
+};
+
+/**
+ * @brief 轨迹多分辨率金字塔
+ * @details 解析文件时预先计算，用于按视口和缩放返回轨迹，客户端不需要接收全部轨迹点：
+ *          - 第0层为原始轨迹，第 k 层（k >= 1）以 baseTolerance * levelFactor^(k-1) 为容差，
+ *            对第 k-1 层做 Douglas-Peucker 抽稀，相对原始轨迹的累计误差不超过
+ *            该层容差的 levelFactor / (levelFactor - 1) 倍。快速定位与切削的分界点总是保留。
+ *          - 每层按 tilePoints 个点切分为连续的瓦片，相邻瓦片共用分界点以保证线段连续，
+ *            每个瓦片记录包围盒，查询时只返回与视口相交的瓦片。
+ *          层中的点保留行号和序号，不保留 G 代码文本。构造后不再修改，可在多个线程间共享。
+ */
+class TrajectoryPyramid {
+public:
+    /**
+     * @brief 瓦片：层中一段连续的点
+     */
+    struct Tile {
+        size_t begin = 0;           ///< 第一个点的下标
+        size_t end = 0;             ///< 最后一个点的下标（含），与下一个瓦片的 begin 相同
+        TrajectoryBounds bounds;    ///< 包围盒
+    };
+
+    /**
+     * @brief 层
+     */
+    struct Level {
+        double tolerance = 0.0;                 ///< 容差，第0层为0
+        std::vector<TrajectoryPoint> points;    ///< 抽稀后的点
+        std::vector<Tile> tiles;                ///< 瓦片
+    };
+
+    /**
+     * @brief 构造函数，构建全部层
+     * @param points 原始轨迹点
+     * @param options 构建参数
+     */
+    explicit TrajectoryPyramid(const std::vector<TrajectoryPoint>& points, const TrajectoryPyramidOptions& options = TrajectoryPyramidOptions());
+
+    /**
+     * @brief 获取层数
+     * @return 层数，至少为1
+     */
+    size_t getLevelCount() const { return levels_.size(); }
+
+    /**
+     * @brief 获取层
+     * @param level 层编号，必须小于层数
+     * @return 层
+     */
+    const Level& getLevel(size_t level) const { return levels_[level]; }
+
+    /**
+     * @brief 获取整个轨迹的包围盒
+     * @return 包围盒，没有轨迹点时全部为0
+     */
+    const TrajectoryBounds& getBounds() const { return bounds_; }
+
+    /**
+     * @brief 选择容差不超过给定值的最粗层
+     * @param tolerance 允许的误差，通常为一个像素对应的长度
+     * @return 层编号
+     */
+    size_t selectLevel(double tolerance) const;
+
+    /**
+     * @brief 查询与视口相交的瓦片
+     * @param level 层编号，无效时返回空
+     * @param viewport 视口，只比较 XY 范围
+     * @return 瓦片编号，按轨迹顺序排列
+     */
+    std::vector<size_t> queryTiles(size_t level, const TrajectoryBounds& viewport) const;
+
+private:
+    /**
+     * @brief 对点序列做 Douglas-Peucker 抽稀
+     */
+    static std::vector<TrajectoryPoint> decimate(const std::vector<TrajectoryPoint>& points, double tolerance);
+
+    /**
+     * @brief 将层切分为瓦片并计算包围盒
+     */
+    static void buildTiles(Level& level, size_t tilePoints);
+
+    std::vector<Level> levels_;     ///< 各层，第0层为原始轨迹
+    TrajectoryBounds bounds_;       ///< 整个轨迹的包围盒
+};
+
+} // namespace web
+} // namespace xxcnc
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "WebTypes.h"
+#include <algorithm>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
@@ -46,9 +48,89 @@ public:
     // 状态监控API
     virtual StatusResponse getSystemStatus() = 0;
 
-    // 控制指令API
+    /**
+     * @brief 获取通道数，单通道实现无需重写
+     * @return 通道数
+     */
+    virtual size_t getChannelCount() { return 1; }
+
+    /**
+     * @brief 获取指定通道的状态，默认只有通道0
+     * @param channel 通道编号
+     * @param response 输出的通道状态
+     * @return 通道存在时返回true
+     */
+    virtual bool getChannelStatus(int channel, StatusResponse& response) {
+        if (channel != 0) {
+            return false;
+        }
+        response = getSystemStatus();
+        return true;
+    }
+
+    /**
+     * @brief 获取通道状态和序号游标之后的轨迹点，用于增量轨迹查询和状态推送
+     * @details 默认实现读取完整状态后截掉序号不大于游标的轨迹点
+     * @param channel 通道编号
+     * @param sinceSequence 客户端已有的最新轨迹点序号，0 表示从头获取
+     * @param maxPoints 最多返回的轨迹点数
+     * @param response 输出的通道状态
+     * @return 通道存在时返回true
+     */
+    virtual bool getChannelUpdate(int channel, uint64_t sinceSequence, size_t maxPoints, StatusResponse& response) {
+        if (!getChannelStatus(channel, response)) {
+            return false;
+        }
+        auto& points = response.trajectoryPoints;
+        if (!points.empty() && response.trajectorySequence == 0) {
+            response.trajectorySequence = points.back().sequence;
+        }
+        auto first = std::find_if(points.begin(), points.end(),
+                                  [sinceSequence](const TrajectoryPoint& point) { return point.sequence > sinceSequence; });
+        points.erase(points.begin(), sinceSequence > 0 ? first : points.begin());
+        if (points.size() > maxPoints) {
+            points.resize(maxPoints);
+        }
+        return true;
+    }
+
+    // 控制指令API，命令中可用 "channel" 字段指定通道，缺省为通道0
     virtual bool executeCommand(const nlohmann::json& command) = 0;
 
+    /**
+     * @brief 执行控制指令并返回附加结果
+     * @details 异步执行的命令（如 motion.start）在受理后立即返回，result 中带有作业编号，
+     *          作业进度通过状态中的 job 字段获取；默认实现不返回附加结果
+     * @param command 控制指令
+     * @param result 输出的附加结果，合并到命令的响应中
+     * @return 命令被受理时返回true
+     */
+    virtual bool executeCommandWithResult(const nlohmann::json& command, nlohmann::json& /* result */) {
+        return executeCommand(command);
+    }
+
+    /**
+     * @brief 将加工作业状态转换为 JSON，供状态响应和作业队列命令使用
+     */
+    static nlohmann::json jobToJson(const JobStatus& job) {
+        nlohmann::json json = {
+            {"id", job.id},
+            {"phase", job.phase},
+            {"file", job.file},
+            {"parsedLines", job.parsedLines},
+            {"plannedSegments", job.plannedSegments},
+            {"totalSegments", job.totalSegments},
+            {"queuedAt", job.queuedAt},
+            {"parsedAt", job.parsedAt},
+            {"startedAt", job.startedAt},
+            {"finishedAt", job.finishedAt}
+        };
+        if (!job.error.empty()) {
+            json["error"] = job.error;
+        }
+        return json;
+    }
+
     // 文件管理API
     virtual FileListResponse getFileList(const std::string& path) = 0;
 
@@ -58,6 +140,11 @@ public:
     // 文件解析API
     virtual FileParseResponse parseFile(const std::string& filename) = 0;
 
+    // 文件解析API，返回共享的解析结果，有缓存的实现可直接返回缓存对象而不复制
+    virtual std::shared_ptr<const FileParseResponse> parseFileShared(const std::string& filename) {
+        return std::make_shared<const FileParseResponse>(parseFile(filename));
+    }
+
     // 配置管理API
     virtual ConfigResponse getConfig() = 0;
     virtual bool updateConfig(const ConfigData& config) = 0;
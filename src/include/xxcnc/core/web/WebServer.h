@@ -58,6 +58,12 @@ public:
     std::string getStaticDir() const { return staticDir_; }
     bool getEnableCors() const { return enableCors_; }
 
+    // 状态推送（/api/events）配置：推送频率 (Hz) 和位置死区 (mm)，状态变化小于死区时不推送
+    void setPushRate(double rate) { pushRate_ = rate; }
+    void setPushDeadband(double deadband) { pushDeadband_ = deadband; }
+    double getPushRate() const { return pushRate_; }
+    double getPushDeadband() const { return pushDeadband_; }
+
 private:
     std::unique_ptr<WebServerImpl> impl_;
     std::shared_ptr<WebAPI> api_;
@@ -70,6 +76,8 @@ private:
     int port_;
     std::string staticDir_;
     bool enableCors_;
+    double pushRate_ = 30.0;
+    double pushDeadband_ = 0.001;
 
     friend class WebServerImpl;
 };
@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <cstdint>
 
 namespace xxcnc {
 namespace web {
@@ -16,12 +17,53 @@ struct TrajectoryPoint {
     double z = 0.0;
     bool isRapid = false;
     std::string command;
+    int lineNumber = 0;     ///< 源文件行号（从1开始），0 表示未知
+    uint64_t sequence = 0;  ///< 轨迹历史中的序号，从1开始单调递增，清除历史后不复位；0 表示不属于轨迹历史
+};
+
+/**
+ * @brief 加工作业状态
+ * @details 作业由通道的后台线程依次解析和规划，阶段为 parsing、planning、running，
+ *          结束时为 completed、failed 或 cancelled；排队的作业先为 queued，预先解析完成后为 ready。
+ *          各时间为 Unix 毫秒时间戳，0 表示尚未到达该阶段
+ */
+struct JobStatus {
+    uint64_t id = 0;                ///< 作业编号，从1开始递增，0 表示通道尚未提交过作业
+    std::string phase;              ///< 作业阶段
+    std::string file;               ///< 加工文件
+    size_t parsedLines = 0;         ///< 已解析的行数
+    size_t plannedSegments = 0;     ///< 已规划的线段数
+    size_t totalSegments = 0;       ///< 线段总数，解析完成后才确定
+    std::string error;              ///< 失败原因
+    uint64_t queuedAt = 0;          ///< 提交时间
+    uint64_t parsedAt = 0;          ///< 解析完成的时间
+    uint64_t startedAt = 0;         ///< 开始运动的时间
+    uint64_t finishedAt = 0;        ///< 结束时间
+
+    bool operator==(const JobStatus& other) const {
+        return id == other.id &&
+               phase == other.phase &&
+               file == other.file &&
+               parsedLines == other.parsedLines &&
+               plannedSegments == other.plannedSegments &&
+               totalSegments == other.totalSegments &&
+               error == other.error &&
+               queuedAt == other.queuedAt &&
+               parsedAt == other.parsedAt &&
+               startedAt == other.startedAt &&
+               finishedAt == other.finishedAt;
+    }
+
+    bool operator!=(const JobStatus& other) const {
+        return !(*this == other);
+    }
 };
 
 /**
  * @brief 系统状态响应
  */
 struct StatusResponse {
+    int channel = 0;        ///< 通道编号
     std::string status;    ///< 系统当前状态
     struct {
         double x = 0.0;
@@ -31,20 +73,29 @@ struct StatusResponse {
     double feedRate = 100;  ///< 进给速度
     std::string currentFile;///< 当前文件
     double progress = 0;    ///< 进度
+    int currentLine = 0;    ///< 正在执行的源文件行号，0 表示未知
     int errorCode = 0;      ///< 错误代码
     std::vector<std::string> messages;  ///< 状态消息列表
-    std::vector<TrajectoryPoint> trajectoryPoints; ///< 轨迹点列表
+    std::vector<TrajectoryPoint> trajectoryPoints; ///< 轨迹点列表，状态查询时为空，增量查询时为游标之后的点
+    uint64_t trajectorySequence = 0;              ///< 最新轨迹点的序号，0 表示尚无轨迹点
+    uint64_t trajectoryCleared = 0;               ///< 最近一次清除轨迹历史时的最新序号，不大于该值的点已被清除
+    JobStatus job;                                ///< 通道当前或最近结束的加工作业
+    size_t queuedJobs = 0;                        ///< 作业队列中等待的作业数
 
     bool operator==(const StatusResponse& other) const {
-        return status == other.status &&
+        return channel == other.channel &&
+               status == other.status &&
                position.x == other.position.x &&
                position.y == other.position.y &&
                position.z == other.position.z &&
                feedRate == other.feedRate &&
                currentFile == other.currentFile &&
                progress == other.progress &&
+               currentLine == other.currentLine &&
                errorCode == other.errorCode &&
                messages == other.messages &&
+               job == other.job &&
+               queuedJobs == other.queuedJobs &&
                trajectoryPoints.size() == other.trajectoryPoints.size();
     }
 };
@@ -1,8 +1,11 @@
 #pragma once
 
+#include "xxcnc/motion/AxisCompensation.h"
+#include "xxcnc/motion/JerkLimitedTrajectory.h"
 #include <string>
 #include <memory>
 #include <atomic>
+#include <cstdint>
 
 namespace xxcnc {
 namespace motion {
@@ -33,9 +36,16 @@ struct AxisParameters {
 
 /**
  * @brief 轴类，实现单轴的运动控制
+ * @details 点到点运动、速度运动、回零和减速停止均受加速度和加加速度限制：点到点运动由
+ *          JerkLimitedTrajectory 在线规划，以最短时间精确到达目标并静止，运动中改变目标时从
+ *          当前状态重新规划；速度运动以加加速度受限的方式跟踪目标速度。
+ *          运动指令可在任意线程调用，规划和积分在调用 update() 的线程中完成。
  */
 class Axis {
 public:
+    // 轴组批量更新时直接读写轴的周期状态
+    friend class AxisGroup;
+
     /**
      * @brief 构造函数
      * @param name 轴名称
@@ -61,6 +71,31 @@ public:
      */
     double getCurrentVelocity() const { return currentVelocity_; }
 
+    /**
+     * @brief 获取当前加速度
+     * @return 当前加速度 (mm/s^2)
+     */
+    double getCurrentAcceleration() const { return currentAcceleration_; }
+
+    /**
+     * @brief 获取经误差补偿后的电机位置指令
+     * @details 每周期由当前位置加上螺距误差和反向间隙补偿量得到；getCurrentPosition() 仍为补偿前的位置
+     * @return 电机位置指令 (mm)
+     */
+    double getMotorPosition() const { return motorPosition_; }
+
+    /**
+     * @brief 设置误差补偿表，须在配置阶段（控制循环开始前或轴停止时）调用
+     * @param compensation 补偿表
+     */
+    void setCompensation(const AxisCompensation& compensation);
+
+    /**
+     * @brief 获取误差补偿表
+     * @return 补偿表
+     */
+    const AxisCompensation& getCompensation() const { return compensation_; }
+
     /**
      * @brief 获取当前状态
      * @return 轴状态
@@ -79,6 +114,12 @@ public:
      */
     double getMaxAcceleration() const { return params_.maxAcceleration; }
 
+    /**
+     * @brief 获取最大加加速度
+     * @return 最大加加速度 (mm/s^3)
+     */
+    double getMaxJerk() const { return params_.maxJerk; }
+
     /**
      * @brief 使能轴
      * @return 是否成功
@@ -93,12 +134,21 @@ public:
 
     /**
      * @brief 移动到指定位置
+     * @details 空闲或运动中均可调用，运动中调用时在下一次 update() 从当前状态重新规划
      * @param position 目标位置 (mm)
      * @param velocity 运动速度 (mm/s)
      * @return 是否成功
      */
     bool moveTo(double position, double velocity);
 
+    /**
+     * @brief 周期同步位置模式：直接跟随插补器下发的位置指令
+     * @param position 本周期位置指令 (mm)
+     * @param deltaTime 插补周期 (s)
+     * @return 是否成功，超出软限位或隐含速度超过最大速度时进入错误状态并返回false
+     */
+    bool followPosition(double position, double deltaTime);
+
     /**
      * @brief 以指定速度连续运动
      * @param velocity 运动速度 (mm/s)
@@ -132,13 +182,80 @@ public:
     bool clearTrajectory();
 
 private:
+    /**
+     * @brief 是否参与周期更新（禁用和错误状态的轴保持不动）
+     * @return 是否参与更新
+     */
+    bool isUpdating() const;
+
+    /**
+     * @brief 应用新的运动指令：点到点运动从当前状态重新规划
+     */
+    void applyCommand();
+
+    /**
+     * @brief 发出新的运动指令，由 update() 在下一周期切换运动模式
+     * @param positionMode 是否为点到点运动
+     */
+    void issueCommand(bool positionMode);
+
+    /**
+     * @brief 获取有效的加加速度限制，未配置时视为不限制（1ms 内到达最大加速度）
+     * @return 加加速度限制 (mm/s^3)
+     */
+    double jerkLimit() const;
+
+    /**
+     * @brief 点到点运动的周期更新
+     * @param deltaTime 时间间隔 (s)
+     */
+    void updatePositionMode(double deltaTime);
+
+    /**
+     * @brief 速度运动的周期更新
+     * @param deltaTime 时间间隔 (s)
+     */
+    void updateVelocityMode(double deltaTime);
+
+    /**
+     * @brief 写回速度模式一个周期的积分结果，速度和目标速度都为零时回到空闲
+     * @param position 位置 (mm)
+     * @param velocity 速度 (mm/s)
+     * @param acceleration 加速度 (mm/s^2)
+     * @param targetVelocity 本周期的目标速度 (mm/s)
+     */
+    void finishVelocityStep(double position, double velocity, double acceleration, double targetVelocity);
+
+    /**
+     * @brief 对本周期的位置指令做误差补偿并发布电机位置
+     * @param deltaTime 时间间隔 (s)
+     */
+    void updateMotorPosition(double deltaTime);
+
+    /**
+     * @brief 触发软限位：停在限位内侧并进入错误状态
+     * @param position 越限的位置
+     */
+    void triggerSoftLimit(double position);
+
     std::string name_;              ///< 轴名称
     AxisParameters params_;         ///< 轴参数
     std::atomic<double> currentPosition_{0.0};   ///< 当前位置
     std::atomic<double> currentVelocity_{0.0};   ///< 当前速度
     std::atomic<double> targetPosition_{0.0};    ///< 目标位置
     std::atomic<double> targetVelocity_{0.0};    ///< 目标速度
+    std::atomic<double> currentAcceleration_{0.0}; ///< 当前加速度
+    std::atomic<double> motorPosition_{0.0};       ///< 补偿后的电机位置指令
+    std::atomic<double> profileVelocity_{0.0};     ///< 点到点运动速度
     std::atomic<AxisState> state_{AxisState::DISABLED}; ///< 当前状态
+    std::atomic<uint64_t> command_{0};             ///< 指令字：序号左移一位，最低位为点到点运动标志
+
+    // 仅由调用 update() 的线程访问
+    uint64_t appliedCommand_ = 0;                  ///< 已应用的指令字
+    bool positionMode_ = false;                    ///< 是否在执行点到点运动
+    JerkLimitedTrajectory trajectory_;             ///< 点到点轨迹
+    double trajectoryTime_ = 0.0;                  ///< 点到点轨迹已执行时间 (s)
+    AxisCompensation compensation_;                ///< 螺距误差和反向间隙补偿
 };
 
 } // namespace motion
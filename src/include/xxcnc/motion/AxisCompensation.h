@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace xxcnc {
+namespace motion {
+
+/**
+ * @brief 单轴误差补偿：丝杠螺距误差表和反向间隙
+ * @details 螺距误差表在等间距网格上给出各位置的补偿值（加到指令位置上的修正量，即测得误差的相反数），
+ *          查表为 O(1)：由位置直接算出网格下标并线性插值，超出表范围时取端点值，无分支、不分配内存。
+ *          反向间隙按半间隙对称模型补偿：正向运动时加 +backlash/2，负向运动时加 -backlash/2，
+ *          方向由相邻两个周期的指令位置之差判定，停止时保持上一次的方向。可选地以 backlashRampVelocity
+ *          限制反向时补偿量的变化速度，避免指令位置阶跃。
+ *
+ *          表在配置阶段设置；apply() 只能由控制循环线程调用。
+ */
+class AxisCompensation {
+public:
+    AxisCompensation();
+
+    /**
+     * @brief 设置螺距误差补偿表
+     * @param start 第一个网格点的位置 (mm)
+     * @param spacing 网格间距 (mm)，必须为正
+     * @param corrections 各网格点的补偿值 (mm)，至少2个点
+     * @return 参数有效时返回true
+     */
+    bool setPitchTable(double start, double spacing, const std::vector<double>& corrections);
+
+    /**
+     * @brief 设置反向间隙
+     * @param backlash 反向间隙 (mm)，不能为负
+     * @param rampVelocity 反向时补偿量的最大变化速度 (mm/s)，0 表示立即生效
+     * @return 参数有效时返回true
+     */
+    bool setBacklash(double backlash, double rampVelocity = 0.0);
+
+    /**
+     * @brief 从文件加载补偿表
+     * @details 文本格式，# 开头为注释；"backlash <间隙>" 和 "backlash_ramp <速度>" 设置反向间隙；
+     *          其余每行为 "<位置> <补偿值>"，位置须递增且等间距
+     * @param filename 文件路径
+     * @return 是否成功，失败时保持原配置
+     */
+    bool loadFromFile(const std::string& filename);
+
+    /**
+     * @brief 查询螺距误差补偿值
+     * @param position 指令位置 (mm)
+     * @return 补偿值 (mm)
+     */
+    double pitchCorrection(double position) const {
+        const double u = std::min(std::max((position - start_) * inverseSpacing_, 0.0), lastIndex_);
+        const size_t index = std::min(static_cast<size_t>(u), corrections_.size() - 2);
+        const double fraction = u - static_cast<double>(index);
+        return corrections_[index] + fraction * (corrections_[index + 1] - corrections_[index]);
+    }
+
+    /**
+     * @brief 补偿本周期的指令位置
+     * @param position 指令位置 (mm)
+     * @param deltaTime 控制周期 (s)
+     * @return 补偿后的电机位置指令 (mm)
+     */
+    double apply(double position, double deltaTime);
+
+    /**
+     * @brief 重置运动方向，用于回零或使能后从静止开始
+     * @param position 当前指令位置 (mm)
+     */
+    void reset(double position);
+
+    /**
+     * @brief 获取当前的反向间隙补偿量
+     * @return 补偿量 (mm)
+     */
+    double getBacklashOffset() const { return backlashOffset_; }
+
+    /**
+     * @brief 获取反向间隙
+     * @return 反向间隙 (mm)
+     */
+    double getBacklash() const { return backlash_; }
+
+    /**
+     * @brief 获取螺距误差表的点数
+     * @return 点数，未设置时为0
+     */
+    size_t getPitchPointCount() const { return pitchPointCount_; }
+
+private:
+    double start_ = 0.0;                ///< 第一个网格点的位置 (mm)
+    double inverseSpacing_ = 0.0;       ///< 网格间距的倒数 (1/mm)
+    double lastIndex_ = 0.0;            ///< 最后一个网格点的下标
+    std::vector<double> corrections_;   ///< 各网格点的补偿值 (mm)，至少2个点
+    size_t pitchPointCount_ = 0;        ///< 已设置的螺距误差表点数
+    double backlash_ = 0.0;             ///< 反向间隙 (mm)
+    double backlashRampVelocity_ = 0.0; ///< 反向间隙补偿量的最大变化速度 (mm/s)
+
+    // 仅由控制循环线程访问
+    double lastPosition_ = 0.0;         ///< 上一周期的指令位置
+    double direction_ = 0.0;            ///< 最近的运动方向（1、-1，未运动时为0）
+    double backlashOffset_ = 0.0;       ///< 当前的反向间隙补偿量 (mm)
+};
+
+} // namespace motion
+} // namespace xxcnc
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "xxcnc/motion/Axis.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace xxcnc {
+namespace motion {
+
+/**
+ * @brief 轴组，以结构数组（SoA）形式批量更新多个轴
+ * @details 各轴的限位参数在加入时按轴索引存入连续数组。每个周期先逐轴应用新指令并执行点到点运动，
+ *          再把处于速度运动（含回零和减速停止）的轴的位置、速度、加速度和目标速度收集到连续数组中，
+ *          以一次无分支、可向量化的遍历完成所有轴的加加速度受限速度跟踪、位置积分和软限位检查，
+ *          最后将结果逐轴写回并发布，每个值每周期只写一次。结果与逐轴调用 Axis::update() 相同。
+ *
+ *          update() 须在控制循环线程中调用；轴的运动指令仍可在任意线程调用。
+ */
+class AxisGroup {
+public:
+    /**
+     * @brief 构造函数
+     * @param capacity 预留的轴数
+     */
+    explicit AxisGroup(size_t capacity = 0);
+
+    /**
+     * @brief 添加轴，须在开始更新前完成配置
+     * @param axis 轴，生命周期由调用方保证
+     * @return 轴索引
+     */
+    size_t addAxis(Axis* axis);
+
+    /**
+     * @brief 获取轴数量
+     * @return 轴数量
+     */
+    size_t size() const { return axes_.size(); }
+
+    /**
+     * @brief 获取轴
+     * @param index 轴索引
+     * @return 轴
+     */
+    Axis* getAxis(size_t index) const { return axes_[index]; }
+
+    /**
+     * @brief 批量更新所有轴状态
+     * @param deltaTime 时间间隔 (s)
+     * @param skip 按轴索引标记本周期跳过的轴（如由插补器直接下发位置的轴），为空时更新所有轴
+     */
+    void update(double deltaTime, const std::vector<bool>* skip = nullptr);
+
+private:
+    std::vector<Axis*> axes_;               ///< 按索引排列的轴
+
+    // 限位参数，加入时写入
+    std::vector<double> maxAcceleration_;   ///< 最大加速度
+    std::vector<double> maxJerk_;           ///< 有效的最大加加速度
+    std::vector<double> softLimitMin_;      ///< 软限位最小值
+    std::vector<double> softLimitMax_;      ///< 软限位最大值
+
+    // 工作数组，仅由控制循环线程访问
+    std::vector<double> position_;          ///< 当前位置
+    std::vector<double> velocity_;          ///< 当前速度
+    std::vector<double> acceleration_;      ///< 当前加速度
+    std::vector<double> targetVelocity_;    ///< 目标速度
+    std::vector<uint8_t> active_;           ///< 本周期是否做速度模式积分
+    std::vector<double> limitHit_;          ///< 本周期触发软限位的轴（1.0 触发），与其他数组同宽以便向量化
+};
+
+} // namespace motion
+} // namespace xxcnc
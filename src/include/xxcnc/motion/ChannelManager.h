@@ -0,0 +1,131 @@
+#pragma once
+
+#include "xxcnc/motion/MotionController.h"
+#include "xxcnc/motion/RealTimeLoop.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace xxcnc {
+namespace motion {
+
+/**
+ * @brief 多通道管理：一个进程内驱动多个相互独立的通道
+ * @details 每个通道拥有自己的运动控制器（程序队列、插补器和轴）和实时控制循环，通道之间不共享任何
+ *          实时数据，各通道的控制循环分别绑定到不同的 CPU，互不抢占，总吞吐量随通道数线性增长。
+ *          文件解析、Web 服务等非实时服务在进程内共享，运行在未绑定的普通线程中。
+ *
+ *          通道编号为添加顺序（从0开始）。通道只能在全部控制循环停止时添加；
+ *          运行中可以单独启停某个通道的控制循环。
+ */
+class ChannelManager {
+public:
+    /// 自动分配 CPU：第 i 个通道绑定到 firstCpu + i（按 CPU 数取模）
+    static constexpr int kAutoCpu = -2;
+
+    /**
+     * @brief 构造函数
+     * @param loopOptions 各通道控制循环的公共配置，其中的 cpu 字段被忽略
+     * @param firstCpu 自动分配时第一个通道使用的 CPU，-1 表示自动分配时不绑定
+     */
+    explicit ChannelManager(const RealTimeLoopOptions& loopOptions = RealTimeLoopOptions(), int firstCpu = -1);
+
+    /**
+     * @brief 析构函数，停止所有通道的控制循环
+     */
+    ~ChannelManager();
+
+    ChannelManager(const ChannelManager&) = delete;
+    ChannelManager& operator=(const ChannelManager&) = delete;
+
+    /**
+     * @brief 添加通道
+     * @param controller 通道的运动控制器，不能与其他通道共用
+     * @param cpu 控制循环绑定的 CPU，kAutoCpu 表示自动分配，-1 表示不绑定
+     * @return 通道编号，失败时返回 -1
+     */
+    int addChannel(std::shared_ptr<MotionController> controller, int cpu = kAutoCpu);
+
+    /**
+     * @brief 获取通道数
+     * @return 通道数
+     */
+    size_t getChannelCount() const { return channels_.size(); }
+
+    /**
+     * @brief 检查通道编号是否有效
+     * @param channel 通道编号
+     * @return 是否有效
+     */
+    bool hasChannel(int channel) const {
+        return channel >= 0 && static_cast<size_t>(channel) < channels_.size();
+    }
+
+    /**
+     * @brief 获取通道的运动控制器
+     * @param channel 通道编号
+     * @return 运动控制器，编号无效时返回 nullptr
+     */
+    std::shared_ptr<MotionController> getChannel(int channel) const;
+
+    /**
+     * @brief 获取通道的控制循环，用于查询运行统计
+     * @param channel 通道编号
+     * @return 控制循环，编号无效时返回 nullptr
+     */
+    RealTimeLoop* getLoop(int channel) const;
+
+    /**
+     * @brief 获取通道控制循环绑定的 CPU
+     * @param channel 通道编号
+     * @return CPU 编号，不绑定或编号无效时返回 -1
+     */
+    int getChannelCpu(int channel) const;
+
+    /**
+     * @brief 启动所有通道的控制循环
+     * @return 全部启动（或已在运行）时返回true
+     */
+    bool start();
+
+    /**
+     * @brief 停止所有通道的控制循环
+     */
+    void stop();
+
+    /**
+     * @brief 启动指定通道的控制循环
+     * @param channel 通道编号
+     * @return 是否成功启动
+     */
+    bool startChannel(int channel);
+
+    /**
+     * @brief 停止指定通道的控制循环
+     * @param channel 通道编号
+     */
+    void stopChannel(int channel);
+
+    /**
+     * @brief 检查是否有通道的控制循环在运行
+     * @return 是否有通道在运行
+     */
+    bool isRunning() const;
+
+private:
+    /**
+     * @brief 通道
+     */
+    struct Channel {
+        std::shared_ptr<MotionController> controller;   ///< 运动控制器
+        std::unique_ptr<RealTimeLoop> loop;             ///< 实时控制循环
+        int cpu = -1;                                   ///< 绑定的 CPU
+    };
+
+    RealTimeLoopOptions loopOptions_;   ///< 控制循环的公共配置
+    int firstCpu_;                      ///< 自动分配的起始 CPU
+    std::vector<Channel> channels_;     ///< 通道列表，下标即通道编号
+};
+
+} // namespace motion
+} // namespace xxcnc
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace xxcnc {
+namespace motion {
+
+/**
+ * @brief 高度图插值方式
+ */
+enum class HeightMapInterpolation {
+    Bilinear,   ///< 双线性，网格内连续
+    Bicubic     ///< 双三次（Catmull-Rom），一阶导数连续，曲面更平滑
+};
+
+/**
+ * @brief 工作台表面高度图，按 XY 位置给出 Z 补偿量
+ * @details 在规则网格上探测得到各节点高度，加载时为每个网格单元预计算 4x4 多项式系数并按单元连续存放，
+ *          查询时只访问一个单元的系数块（两条缓存行），以 Horner 法求值，无分支、不分配内存。
+ *          网格外的点截断到边界，取边界上的高度。双三次插值所需的边界外侧节点按线性外推，
+ *          两种插值方式都能在整个网格上精确重现平面。
+ *
+ *          高度图定义在机床坐标系中，作用于工件坐标变换（CoordinateSystem::workToMachine）之后的插补点。
+ */
+class HeightMap {
+public:
+    /**
+     * @brief 设置网格
+     * @param originX 第一列的 X 坐标 (mm)
+     * @param originY 第一行的 Y 坐标 (mm)
+     * @param spacingX 列间距 (mm)，必须为正
+     * @param spacingY 行间距 (mm)，必须为正
+     * @param columns 列数（X 方向节点数），至少2
+     * @param rows 行数（Y 方向节点数），至少2
+     * @param heights 各节点高度 (mm)，按行存放：heights[row * columns + column]
+     * @param interpolation 插值方式
+     * @return 参数有效时返回true
+     */
+    bool setGrid(double originX, double originY, double spacingX, double spacingY, size_t columns, size_t rows,
+                 const std::vector<double>& heights,
+                 HeightMapInterpolation interpolation = HeightMapInterpolation::Bicubic);
+
+    /**
+     * @brief 从 CSV 文件加载探测数据
+     * @details 每行为 "x,y,z"，# 开头为注释，第一行可以是表头；节点顺序任意，
+     *          但 X 和 Y 必须各自等间距且构成完整的网格
+     * @param filename 文件路径
+     * @param interpolation 插值方式
+     * @return 是否成功，失败时保持原网格
+     */
+    bool loadFromCsv(const std::string& filename,
+                     HeightMapInterpolation interpolation = HeightMapInterpolation::Bicubic);
+
+    /**
+     * @brief 查询指定位置的表面高度
+     * @param x X 坐标 (mm)
+     * @param y Y 坐标 (mm)
+     * @return 表面高度 (mm)，未设置网格时为0
+     */
+    double heightAt(double x, double y) const {
+        const double gx = std::min(std::max((x - originX_) * inverseSpacingX_, 0.0), maxCellX_);
+        const double gy = std::min(std::max((y - originY_) * inverseSpacingY_, 0.0), maxCellY_);
+        const size_t cellX = std::min(static_cast<size_t>(gx), cellColumns_ - 1);
+        const size_t cellY = std::min(static_cast<size_t>(gy), cellRows_ - 1);
+        const double u = gx - static_cast<double>(cellX);
+        const double v = gy - static_cast<double>(cellY);
+
+        // p(u, v) = Σ a[i][j] · u^i · v^j，先按 v 再按 u 做 Horner 求值
+        const double* a = &coefficients_[(cellY * cellColumns_ + cellX) * kCoefficients];
+        double result = 0.0;
+        for (int i = 3; i >= 0; --i) {
+            const double* row = a + i * 4;
+            result = result * u + (((row[3] * v + row[2]) * v + row[1]) * v + row[0]);
+        }
+        return result;
+    }
+
+    /**
+     * @brief 是否已设置网格
+     * @return 是否已设置
+     */
+    bool isEmpty() const { return columns_ == 0; }
+
+    /**
+     * @brief 获取列数
+     * @return 列数
+     */
+    size_t getColumns() const { return columns_; }
+
+    /**
+     * @brief 获取行数
+     * @return 行数
+     */
+    size_t getRows() const { return rows_; }
+
+    /**
+     * @brief 获取插值方式
+     * @return 插值方式
+     */
+    HeightMapInterpolation getInterpolation() const { return interpolation_; }
+
+private:
+    /// 每个网格单元的多项式系数个数
+    static constexpr size_t kCoefficients = 16;
+
+    double originX_ = 0.0;                      ///< 第一列的 X 坐标 (mm)
+    double originY_ = 0.0;                      ///< 第一行的 Y 坐标 (mm)
+    double inverseSpacingX_ = 0.0;              ///< 列间距的倒数 (1/mm)
+    double inverseSpacingY_ = 0.0;              ///< 行间距的倒数 (1/mm)
+    double maxCellX_ = 0.0;                     ///< X 方向网格坐标上限（单元数）
+    double maxCellY_ = 0.0;                     ///< Y 方向网格坐标上限（单元数）
+    size_t columns_ = 0;                        ///< 列数
+    size_t rows_ = 0;                           ///< 行数
+    size_t cellColumns_ = 1;                    ///< X 方向单元数
+    size_t cellRows_ = 1;                       ///< Y 方向单元数
+    HeightMapInterpolation interpolation_ = HeightMapInterpolation::Bicubic; ///< 插值方式
+    std::vector<double> coefficients_ = std::vector<double>(kCoefficients, 0.0); ///< 按单元连续存放的系数
+};
+
+} // namespace motion
+} // namespace xxcnc
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+
+namespace xxcnc {
+namespace motion {
+
+/**
+ * @brief 输入整形器类型
+ */
+enum class InputShaperType {
+    None,   ///< 不整形
+    ZV,     ///< 零振动（2个脉冲，延迟半个振动周期）
+    ZVD,    ///< 零振动零导数（3个脉冲，延迟一个振动周期，对频率误差更鲁棒）
+    EI      ///< 极不敏感（3个脉冲，容许5%残余振动，频率鲁棒性最好）
+};
+
+/**
+ * @brief 单轴输入整形器
+ * @details 将位置指令与一组正脉冲卷积：y[n] = Σ A_i · x(n·Ts - t_i)，脉冲幅值和时刻由谐振频率
+ *          和阻尼比计算，使该频率的残余振动相互抵消，从而允许更高的加速度。非整数周期的延迟
+ *          在相邻两个历史点之间线性插值。历史指令保存在固定大小的环形缓冲区中，每周期 O(脉冲数)，
+ *          不分配内存。脉冲幅值均为正且和为1，输出始终位于输入的凸包内，不会超出软限位。
+ */
+class InputShaper {
+public:
+    /// 历史缓冲区长度（插补周期数），必须为2的幂
+    static constexpr size_t kHistorySize = 512;
+    /// 最多脉冲数
+    static constexpr size_t kMaxImpulses = 3;
+
+    InputShaper();
+
+    /**
+     * @brief 配置整形器
+     * @param type 整形器类型
+     * @param frequency 谐振频率 (Hz)
+     * @param damping 阻尼比（0 <= damping < 1）
+     * @param samplePeriod 插补周期 (s)
+     * @return 参数有效且整形时长不超过历史缓冲区时返回true，失败时保持原配置
+     */
+    bool configure(InputShaperType type, double frequency, double damping, double samplePeriod);
+
+    /**
+     * @brief 以给定位置填满历史，整形器处于静止状态
+     * @param value 当前位置
+     */
+    void reset(double value);
+
+    /**
+     * @brief 输入一个周期的位置指令，输出整形后的位置指令
+     * @param input 位置指令
+     * @return 整形后的位置指令
+     */
+    double process(double input);
+
+    /**
+     * @brief 输出是否已追上输入（输入保持不变超过整形时长）
+     * @return 是否稳定
+     */
+    bool isSettled() const { return stableCount_ >= settleSamples_; }
+
+    /**
+     * @brief 获取整形器类型
+     * @return 整形器类型
+     */
+    InputShaperType getType() const { return type_; }
+
+    /**
+     * @brief 获取谐振频率
+     * @return 频率 (Hz)
+     */
+    double getFrequency() const { return frequency_; }
+
+    /**
+     * @brief 获取阻尼比
+     * @return 阻尼比
+     */
+    double getDamping() const { return damping_; }
+
+    /**
+     * @brief 获取整形引入的总延迟
+     * @return 最后一个脉冲的时刻 (s)
+     */
+    double getDuration() const { return duration_; }
+
+private:
+    double history_[kHistorySize];              ///< 历史位置指令环形缓冲区
+    size_t head_ = 0;                           ///< 最新指令的位置
+    double amplitudes_[kMaxImpulses] = {};      ///< 脉冲幅值
+    size_t delays_[kMaxImpulses] = {};          ///< 脉冲延迟的整数周期部分
+    double fractions_[kMaxImpulses] = {};       ///< 脉冲延迟的小数部分
+    size_t impulseCount_ = 1;                   ///< 脉冲数
+    size_t settleSamples_ = 0;                  ///< 输出追上输入所需的周期数
+    size_t stableCount_ = 0;                    ///< 输入保持不变的周期数
+    InputShaperType type_ = InputShaperType::None; ///< 整形器类型
+    double frequency_ = 0.0;                    ///< 谐振频率 (Hz)
+    double damping_ = 0.0;                      ///< 阻尼比
+    double duration_ = 0.0;                     ///< 整形时长 (s)
+};
+
+} // namespace motion
+} // namespace xxcnc
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace xxcnc {
+namespace motion {
+
+/**
+ * @brief 单轴运动学状态
+ */
+struct KinematicState {
+    double position = 0.0;      ///< 位置 (mm)
+    double velocity = 0.0;      ///< 速度 (mm/s)
+    double acceleration = 0.0;  ///< 加速度 (mm/s^2)
+};
+
+/**
+ * @brief 单轴运动限制
+ */
+struct KinematicLimits {
+    double maxVelocity = 0.0;       ///< 最大速度 (mm/s)
+    double maxAcceleration = 0.0;   ///< 最大加速度 (mm/s^2)
+    double maxJerk = 0.0;           ///< 最大加加速度 (mm/s^3)
+};
+
+/**
+ * @brief 在线加加速度受限的单轴点到点轨迹
+ * @details 从任意初始状态（位置、速度、加速度）出发，在速度、加速度和加加速度限制下以最短时间
+ *          到达目标位置并静止。轨迹由至多7段恒定加加速度组成：速度过渡到峰值速度 vp（加速度归零），
+ *          匀速段，再从 vp 减速到零；vp 由二分法求解使总位移等于目标距离。初始速度过大或方向相反时
+ *          vp 取反向值，轨迹先越过再返回。规划为 O(1) 内存、数微秒计算，可在目标改变时于实时线程
+ *          中从当前状态重新规划；采样为解析计算，终点精确。
+ */
+class JerkLimitedTrajectory {
+public:
+    /// 最多的恒定加加速度段数
+    static constexpr size_t kMaxPieces = 7;
+
+    /**
+     * @brief 从当前状态规划到目标位置的轨迹
+     * @param start 初始状态
+     * @param target 目标位置 (mm)
+     * @param limits 运动限制，各项必须为正
+     * @return 限制有效时返回true
+     */
+    bool plan(const KinematicState& start, double target, const KinematicLimits& limits);
+
+    /**
+     * @brief 采样轨迹
+     * @param time 自规划起的时间 (s)，超过总时长时返回终点静止状态
+     * @return 该时刻的状态
+     */
+    KinematicState sample(double time) const;
+
+    /**
+     * @brief 获取轨迹总时长
+     * @return 时长 (s)
+     */
+    double getDuration() const { return duration_; }
+
+    /**
+     * @brief 获取目标位置
+     * @return 目标位置 (mm)
+     */
+    double getTarget() const { return target_; }
+
+private:
+    /**
+     * @brief 恒定加加速度段
+     */
+    struct Piece {
+        double duration = 0.0;  ///< 时长 (s)
+        double jerk = 0.0;      ///< 加加速度 (mm/s^3)
+    };
+
+    /**
+     * @brief 最短时间的速度过渡：从 (v0, a0) 到 (v1, 0)
+     * @param v0 初始速度
+     * @param a0 初始加速度
+     * @param v1 目标速度
+     * @param limits 运动限制
+     * @param pieces 输出的恒定加加速度段（至多3段）
+     * @return 段数
+     */
+    static size_t velocityChange(double v0, double a0, double v1, const KinematicLimits& limits, Piece* pieces);
+
+    /**
+     * @brief 以恒定加加速度推进状态
+     */
+    static KinematicState advance(const KinematicState& state, double jerk, double time);
+
+    /**
+     * @brief 构造经峰值速度 vp 的轨迹并返回终点位置
+     * @param vp 峰值速度
+     * @param cruise 匀速段时长 (s)
+     * @return 终点位置
+     */
+    double build(double vp, double cruise);
+
+    KinematicState start_;              ///< 初始状态
+    KinematicLimits limits_;            ///< 运动限制
+    Piece pieces_[kMaxPieces];          ///< 恒定加加速度段
+    size_t pieceCount_ = 0;             ///< 段数
+    double duration_ = 0.0;             ///< 总时长 (s)
+    double target_ = 0.0;               ///< 目标位置
+};
+
+/**
+ * @brief 加加速度受限的速度跟踪，推进一个控制周期
+ * @details 目标加速度取能以最大加加速度恰好减速到目标速度的值 sign(e)·min(A, sqrt(2J|e|))，
+ *          加速度以 J·dt 为步长逼近目标加速度，按恒定加加速度精确积分；收敛到一个周期的
+ *          增量以内时吸附到目标速度。无分支，可在批量更新中向量化。
+ * @param position 位置 (mm)，原地更新
+ * @param velocity 速度 (mm/s)，原地更新
+ * @param acceleration 加速度 (mm/s^2)，原地更新
+ * @param targetVelocity 目标速度 (mm/s)
+ * @param maxAcceleration 最大加速度 (mm/s^2)
+ * @param maxJerk 最大加加速度 (mm/s^3)
+ * @param deltaTime 控制周期 (s)
+ */
+inline void jerkLimitedVelocityStep(double& position, double& velocity, double& acceleration,
+                                    double targetVelocity, double maxAcceleration, double maxJerk,
+                                    double deltaTime) {
+    const double error = targetVelocity - velocity;
+    const double brake = std::min(maxAcceleration, std::sqrt(2.0 * maxJerk * std::abs(error)));
+    const double desired = std::copysign(brake, error);
+    const double maxStep = maxJerk * deltaTime;
+    const double newAcceleration = acceleration + std::min(std::max(desired - acceleration, -maxStep), maxStep);
+    // 本周期加速度的增量，即加加速度乘以周期
+    const double step = newAcceleration - acceleration;
+
+    const double newPosition = position + velocity * deltaTime + acceleration * deltaTime * deltaTime * 0.5 +
+                               step * deltaTime * deltaTime / 6.0;
+    const double newVelocity = velocity + acceleration * deltaTime + step * deltaTime * 0.5;
+
+    // 末端吸附，消除离散化引起的极限环；吸附量不超过一个周期的加速度和加加速度增量
+    const double settleAcceleration = std::min(maxStep, maxAcceleration);
+    const bool settled = (std::abs(targetVelocity - newVelocity) <= settleAcceleration * deltaTime) &
+                         (std::abs(newAcceleration) <= settleAcceleration);
+    position = newPosition;
+    velocity = settled ? targetVelocity : newVelocity;
+    acceleration = settled ? 0.0 : newAcceleration;
+}
+
+} // namespace motion
+} // namespace xxcnc
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace xxcnc {
+namespace motion {
+
+/**
+ * @brief 运动学变换接口：插补坐标（刀尖在工件坐标系中的位置和姿态）与关节（各轴位置）之间的映射
+ * @details 变换以批量方式处理结构数组（SoA）：coordinates[c][i] 为第 i 个点的第 c 个坐标，
+ *          joints[j][i] 为第 i 个点的第 j 个关节位置。各实现的内层循环无分支、点间无依赖，
+ *          可由编译器向量化；控制循环每周期变换一个点，批量接口用于预览和离线计算。
+ *
+ *          实现必须无状态（变换为 const），可在实时线程中调用，不分配内存。
+ */
+class Kinematics {
+public:
+    /// 插补坐标和关节的最多个数
+    static constexpr size_t kMaxCoordinates = 9;
+
+    virtual ~Kinematics() = default;
+
+    /**
+     * @brief 获取运动学名称
+     * @return 名称
+     */
+    virtual std::string getName() const = 0;
+
+    /**
+     * @brief 获取插补坐标数
+     * @return 坐标数
+     */
+    virtual size_t getCoordinateCount() const = 0;
+
+    /**
+     * @brief 获取关节数
+     * @return 关节数
+     */
+    virtual size_t getJointCount() const = 0;
+
+    /**
+     * @brief 获取插补坐标名称，用于按名称指定运动目标和输入整形
+     * @param index 坐标索引
+     * @return 坐标名称
+     */
+    virtual const char* getCoordinateName(size_t index) const = 0;
+
+    /**
+     * @brief 逆变换：插补坐标到关节位置
+     * @param coordinates 各坐标的数组，每个数组 count 个点
+     * @param joints 各关节的输出数组，每个数组 count 个点
+     * @param count 点数
+     * @return 所有点都可达时返回true，不可达点的关节位置无意义
+     */
+    virtual bool inverse(const double* const* coordinates, double* const* joints, size_t count) const = 0;
+
+    /**
+     * @brief 正变换：关节位置到插补坐标
+     * @param joints 各关节的数组，每个数组 count 个点
+     * @param coordinates 各坐标的输出数组，每个数组 count 个点
+     * @param count 点数
+     * @return 所有关节组合都有效时返回true
+     */
+    virtual bool forward(const double* const* joints, double* const* coordinates, size_t count) const = 0;
+};
+
+/**
+ * @brief CoreXY 运动学
+ * @details 两个电机共同驱动 XY 平面：A = X + Y，B = X - Y，Z 直接驱动。
+ *          关节顺序为 A、B、Z。
+ */
+class CoreXYKinematics : public Kinematics {
+public:
+    std::string getName() const override { return "CoreXY"; }
+    size_t getCoordinateCount() const override { return 3; }
+    size_t getJointCount() const override { return 3; }
+    const char* getCoordinateName(size_t index) const override;
+    bool inverse(const double* const* coordinates, double* const* joints, size_t count) const override;
+    bool forward(const double* const* joints, double* const* coordinates, size_t count) const override;
+};
+
+/**
+ * @brief 线性并联（Delta）运动学
+ * @details 三根竖直导轨按 210°、330°、90° 均布在半径 radius 的圆上，滑块经长度 armLength 的
+ *          连杆驱动末端。radius 为滑块铰点到末端铰点的水平距离之差（已扣除末端偏置），
+ *          关节位置为滑块高度，坐标原点位于导轨圆中心。关节顺序为三根导轨。
+ */
+class DeltaKinematics : public Kinematics {
+public:
+    /**
+     * @brief 构造函数
+     * @param armLength 连杆长度 (mm)
+     * @param radius 有效导轨半径 (mm)
+     */
+    DeltaKinematics(double armLength, double radius);
+
+    std::string getName() const override { return "Delta"; }
+    size_t getCoordinateCount() const override { return 3; }
+    size_t getJointCount() const override { return 3; }
+    const char* getCoordinateName(size_t index) const override;
+    bool inverse(const double* const* coordinates, double* const* joints, size_t count) const override;
+    bool forward(const double* const* joints, double* const* coordinates, size_t count) const override;
+
+    /**
+     * @brief 获取连杆长度
+     * @return 连杆长度 (mm)
+     */
+    double getArmLength() const { return armLength_; }
+
+    /**
+     * @brief 获取有效导轨半径
+     * @return 半径 (mm)
+     */
+    double getRadius() const { return radius_; }
+
+private:
+    double armLength_;          ///< 连杆长度 (mm)
+    double radius_;             ///< 有效导轨半径 (mm)
+    double towerX_[3];          ///< 导轨 X 坐标 (mm)
+    double towerY_[3];          ///< 导轨 Y 坐标 (mm)
+};
+
+/**
+ * @brief 双转台（A 摆台 + C 转台）五轴运动学，带刀尖点跟随（RTCP）
+ * @details 插补坐标为刀尖在工件坐标系中的 X/Y/Z 与转台角度 A/C（度），A=C=0 时工件坐标系与
+ *          机床坐标系重合。A 轴绕 X 方向、经过机床坐标 pivot 的轴线旋转摇篮；C 轴固定在摇篮上，
+ *          绕经过 pivot + cOffset（摇篮坐标系）的 Z 方向轴线旋转工作台，均按右手定则为正。
+ *          逆变换求出使刀尖落在旋转后工件点上的机床 X/Y/Z，转台运动时刀尖在工件上保持不动。
+ *          关节顺序为 X、Y、Z、A、C。
+ */
+class TableTableKinematics : public Kinematics {
+public:
+    /**
+     * @brief 构造函数
+     * @param pivotX A 轴旋转中心 X (mm)
+     * @param pivotY A 轴旋转中心 Y (mm)
+     * @param pivotZ A 轴旋转中心 Z (mm)
+     * @param cOffsetY C 轴相对 A 轴旋转中心的 Y 偏置 (mm)
+     * @param cOffsetZ C 轴相对 A 轴旋转中心的 Z 偏置 (mm)
+     */
+    TableTableKinematics(double pivotX, double pivotY, double pivotZ, double cOffsetY = 0.0, double cOffsetZ = 0.0);
+
+    std::string getName() const override { return "TableTable"; }
+    size_t getCoordinateCount() const override { return 5; }
+    size_t getJointCount() const override { return 5; }
+    const char* getCoordinateName(size_t index) const override;
+    bool inverse(const double* const* coordinates, double* const* joints, size_t count) const override;
+    bool forward(const double* const* joints, double* const* coordinates, size_t count) const override;
+
+private:
+    double pivotX_;             ///< A 轴旋转中心 X (mm)
+    double pivotY_;             ///< A 轴旋转中心 Y (mm)
+    double pivotZ_;             ///< A 轴旋转中心 Z (mm)
+    double cOffsetY_;           ///< C 轴 Y 偏置 (mm)
+    double cOffsetZ_;           ///< C 轴 Z 偏置 (mm)
+};
+
+} // namespace motion
+} // namespace xxcnc
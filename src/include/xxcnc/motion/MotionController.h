@@ -1,11 +1,22 @@
 #pragma once
 
 #include "xxcnc/motion/Axis.h"
+#include "xxcnc/motion/AxisGroup.h"
+#include "xxcnc/motion/HeightMap.h"
+#include "xxcnc/motion/InputShaper.h"
+#include "xxcnc/motion/Kinematics.h"
 #include "xxcnc/core/motion/InterpolationEngine.h"
+#include "xxcnc/core/motion/SeqLock.h"
 #include "xxcnc/core/motion/TimeBasedInterpolator.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
+#include <variant>
+#include <vector>
 
 namespace xxcnc {
 namespace motion {
@@ -22,9 +33,35 @@ public:
         Idle,           ///< 空闲状态
         Moving,         ///< 运动中
         Interpolating,  ///< 插补中
+        Holding,        ///< 进给保持减速中
+        Held,           ///< 进给保持已停止
         Error           ///< 错误状态
     };
 
+    /**
+     * @brief 控制器状态快照，由控制循环每周期发布一次
+     * @details 所有字段来自同一周期，读取方通过 getSnapshot() 无锁获取
+     */
+    struct Snapshot {
+        static constexpr size_t kMaxAxes = 16;      ///< 快照包含的最多轴数
+
+        uint64_t tick = 0;                          ///< 发布序号
+        size_t axisCount = 0;                       ///< 轴数量（按轴索引排列）
+        double positions[kMaxAxes] = {};            ///< 各轴位置 (mm)
+        double velocities[kMaxAxes] = {};           ///< 各轴速度 (mm/s)
+        AxisState axisStates[kMaxAxes] = {};        ///< 各轴状态
+        MotionState motionState = MotionState::Idle; ///< 运动状态
+        double progress = 0.0;                      ///< 插补进度（0.0-1.0）
+        int lineNumber = 0;                         ///< 正在执行的源程序行号，0 表示未知
+        bool moving = false;                        ///< 是否在执行轨迹
+        bool interpolationFinished = true;          ///< 插补是否完成
+    };
+
+    /// 笛卡尔插补坐标轴数（X/Y/Z）
+    static constexpr size_t kPathAxisCount = 3;
+    /// 参与插补的最多轴数，X/Y/Z 之后的轴按添加顺序排列
+    static constexpr size_t kMaxPathAxisCount = core::motion::kMaxInterpolationAxes;
+
     /**
      * @brief 构造函数
      */
@@ -45,6 +82,50 @@ public:
      */
     std::shared_ptr<Axis> getAxis(const std::string& name);
 
+    /**
+     * @brief 获取轴的索引，索引按添加顺序在配置时分配
+     * @param name 轴名称
+     * @return 轴索引，如果不存在返回-1
+     */
+    int getAxisIndex(const std::string& name) const;
+
+    /**
+     * @brief 按索引获取轴，不涉及字符串查找和引用计数
+     * @param index 轴索引
+     * @return 轴指针，如果索引无效返回nullptr
+     */
+    Axis* getAxisAt(size_t index) const;
+
+    /**
+     * @brief 获取轴数量
+     * @return 轴数量
+     */
+    size_t getAxisCount() const;
+
+    /**
+     * @brief 获取参与插补的坐标数，即所选插补器实例的轴数
+     * @details X/Y/Z 固定占用前3个坐标，其余轴按添加顺序依次追加，最多 kMaxPathAxisCount 个
+     * @return 插补坐标数
+     */
+    size_t getPathAxisCount() const;
+
+    /**
+     * @brief 设置运动学变换
+     * @details 插补坐标经输入整形后按运动学逆变换为关节位置，下发到 jointAxes 指定的轴，
+     *          插补坐标数和名称由运动学决定。传入 nullptr 恢复笛卡尔直连（插补坐标与同名轴一一对应）。
+     *          只能在运动停止时设置
+     * @param kinematics 运动学变换
+     * @param jointAxes 各关节对应的轴名称，个数须等于关节数
+     * @return 是否成功
+     */
+    bool setKinematics(std::shared_ptr<const Kinematics> kinematics, const std::vector<std::string>& jointAxes = {});
+
+    /**
+     * @brief 获取运动学变换
+     * @return 运动学变换，笛卡尔直连时返回nullptr
+     */
+    const Kinematics* getKinematics() const;
+
     /**
      * @brief 使能所有轴
      * @return 是否成功
@@ -59,24 +140,74 @@ public:
 
     /**
      * @brief 多轴直线插补运动
+     * @details 运动段追加到插补队列尾部，起点为上一段终点；运动中追加的段将连续执行，
+     *          空闲时需调用 startMotion() 开始执行。A/B/C 等附加轴与 X/Y/Z 一起联动插补
      * @param targetPositions 目标位置映射表
      * @param feedRate 进给速度 (mm/min)
      * @return 是否成功
      */
     bool moveLinear(const std::map<std::string, double>& targetPositions, double feedRate);
 
+    /**
+     * @brief 多轴直线插补运动，目标为 X/Y/Z 插补坐标
+     * @details 与按名称的版本语义相同，未配置的坐标轴和附加轴保持起点坐标
+     * @param target 目标位置
+     * @param feedRate 进给速度 (mm/min)
+     * @param lineNumber 源程序行号，执行该段时出现在状态快照中
+     * @return 是否成功
+     */
+    bool moveLinear(const core::motion::Point& target, double feedRate, int lineNumber = 0);
+
     /**
      * @brief 紧急停止所有轴
+     * @details 清空插补队列，只能在命令线程（插补队列的生产者）调用；
+     *          控制循环中的指令失败通过 serviceFault() 处理
      * @return 是否成功
      */
     bool emergencyStop();
 
     /**
-     * @brief 更新所有轴的状态
+     * @brief 处理控制循环上报的故障
+     * @details 插补点下发失败时控制循环只停止各轴、将运动状态置为 Error 并上报故障，
+     *          不在实时线程中记录日志或清空队列；由命令线程调用本函数完成这两步。
+     *          startMotion()、追加运动段和 emergencyStop() 会先调用本函数
+     * @return 是否有待处理的故障
+     */
+    bool serviceFault();
+
+    /**
+     * @brief 进给保持：沿编程路径在加速度和加加速度限制内减速并停止在路径上
+     * @details 请求在下一个插补周期开始时生效，响应延迟不超过一个周期，
+     *          实际延迟可通过 getLastFeedHoldLatency() 获取
+     * @return 是否接受请求
+     */
+    bool feedHold();
+
+    /**
+     * @brief 从进给保持点恢复运行，剩余轨迹保持不变
+     * @return 是否接受请求
+     */
+    bool resume();
+
+    /**
+     * @brief 获取最近一次进给保持的响应延迟（从请求到开始减速）
+     * @return 响应延迟，尚未发生进给保持时返回负值
+     */
+    std::chrono::microseconds getLastFeedHoldLatency() const;
+
+    /**
+     * @brief 更新所有轴的状态，并在周期末发布状态快照
      * @param deltaTime 时间增量 (s)
      */
     void update(double deltaTime);
 
+    /**
+     * @brief 获取最近一个控制周期发布的状态快照
+     * @details 顺序锁读取，不加锁也不阻塞控制循环，可在任意线程调用
+     * @return 状态快照
+     */
+    Snapshot getSnapshot() const;
+
     /**
      * @brief 设置插补周期
      * @param periodMs 周期（毫秒）
@@ -89,6 +220,53 @@ public:
      */
     int getInterpolationPeriod() const;
 
+    /**
+     * @brief 设置粗插补周期
+     * @param periodMs 周期（毫秒）
+     */
+    void setCoarseInterpolationPeriod(int periodMs);
+
+    /**
+     * @brief 获取粗插补周期
+     * @return 粗插补周期（毫秒）
+     */
+    int getCoarseInterpolationPeriod() const;
+
+    /**
+     * @brief 设置插补坐标轴的输入整形器
+     * @details 整形器位于插补输出和轴位置指令之间，以插补周期运行，抑制该轴在指定频率的残余振动，
+     *          从而允许更高的加速度；代价是轨迹增加约 getDuration() 的延迟。只能在运动停止时设置，
+     *          修改插补周期时自动按新周期重新计算
+     * @param axisName 参与插补的轴名称，设置运动学后为运动学坐标名称
+     * @param type 整形器类型，None 表示关闭
+     * @param frequency 谐振频率 (Hz)
+     * @param damping 阻尼比
+     * @return 是否成功
+     */
+    bool setInputShaper(const std::string& axisName, InputShaperType type, double frequency, double damping);
+
+    /**
+     * @brief 获取插补坐标轴的输入整形器
+     * @param axisName 轴名称
+     * @return 整形器指针，轴不参与插补时返回nullptr
+     */
+    const InputShaper* getInputShaper(const std::string& axisName) const;
+
+    /**
+     * @brief 设置工作台表面高度图
+     * @details 每个插补周期按整形后的 X/Y 位置查询高度并加到 Z 指令上，补偿随刀具位置连续变化，
+     *          长直线无需拆分即可跟随表面；编程坐标和运动起点不包含补偿量。只能在运动停止时设置
+     * @param heightMap 高度图，nullptr 表示关闭
+     * @return 是否成功
+     */
+    bool setHeightMap(std::shared_ptr<const HeightMap> heightMap);
+
+    /**
+     * @brief 获取工作台表面高度图
+     * @return 高度图，未设置时返回nullptr
+     */
+    const HeightMap* getHeightMap() const;
+
     /**
      * @brief 获取当前插补进度
      * @return 进度（0.0-1.0）
@@ -102,13 +280,14 @@ public:
     bool isInterpolationFinished() const;
 
     /**
-     * @brief 获取当前插补队列中的点数
-     * @return 队列中的点数
+     * @brief 获取当前插补队列中尚未完成的运动段数
+     * @return 队列中的运动段数
      */
     size_t getInterpolationQueueSize() const;
 
     /**
      * @brief 启动运动控制器执行已规划的轨迹
+     * @details 第一个插补点在下一次 update() 时下发
      * @return 是否成功启动
      */
     bool startMotion();
@@ -143,11 +322,152 @@ protected:
     virtual void emit_clear_trajectory() {}
 
 private:
-    std::map<std::string, std::shared_ptr<Axis>> axes_;
+    /// 按插补坐标索引的位置
+    using PathPosition = std::array<double, kMaxPathAxisCount>;
+
+    /// 各轴数的插补器实例，添加轴时按插补坐标数选择
+    using PathInterpolator = std::variant<
+        std::unique_ptr<core::motion::BasicTimeBasedInterpolator<3>>,
+        std::unique_ptr<core::motion::BasicTimeBasedInterpolator<4>>,
+        std::unique_ptr<core::motion::BasicTimeBasedInterpolator<5>>,
+        std::unique_ptr<core::motion::BasicTimeBasedInterpolator<6>>,
+        std::unique_ptr<core::motion::BasicTimeBasedInterpolator<7>>,
+        std::unique_ptr<core::motion::BasicTimeBasedInterpolator<8>>,
+        std::unique_ptr<core::motion::BasicTimeBasedInterpolator<9>>>;
+
+    /**
+     * @brief 以当前插补器实例调用 f
+     * @param f 以插补器引用为参数的可调用对象
+     * @return f 的返回值
+     */
+    template <typename F>
+    decltype(auto) withInterpolator(F&& f) const {
+        return std::visit([&](const auto& interpolator) -> decltype(auto) { return f(*interpolator); },
+                          timeBasedInterpolator_);
+    }
+
+    /**
+     * @brief 按插补坐标数重新选择插补器实例，保留插补周期设置
+     * @param axisCount 插补坐标数
+     */
+    void selectInterpolator(size_t axisCount);
+
+    /**
+     * @brief 按当前插补坐标或关节配置标记由插补器驱动的轴
+     */
+    void updateInterpolatedAxes();
+
+    /**
+     * @brief 执行一个控制周期的插补和轴指令下发，并更新不由插补器驱动的轴
+     * @param deltaTime 时间增量 (s)
+     */
+    void updateMotion(double deltaTime);
+
+    /**
+     * @brief 取一个插补点下发到插补坐标对应的轴，轨迹结束时停止运动
+     * @param deltaTime 时间增量 (s)
+     */
+    void updatePath(double deltaTime);
+
+    /**
+     * @brief 发布状态快照（仅控制循环线程或配置阶段调用）
+     */
+    void publishSnapshot();
+
+    /**
+     * @brief 处理挂起的进给保持和恢复请求
+     */
+    void processFeedHoldRequests();
+
+    /**
+     * @brief 控制循环中指令失败时停止各轴并上报故障，不加锁、不分配内存、不记录日志
+     */
+    void stopOnFault();
+
+    /**
+     * @brief 将插补点作为本周期位置指令下发到各轴
+     * @param point 插补点
+     * @param deltaTime 插补周期 (s)
+     * @return 是否成功
+     */
+    template <size_t N>
+    bool commandAxes(const core::motion::PointN<N>& point, double deltaTime);
+
+    /**
+     * @brief 按运动学逆变换将插补坐标下发到各关节轴
+     * @param coordinates 插补坐标
+     * @param deltaTime 插补周期 (s)
+     * @return 是否成功，坐标不可达时返回false
+     */
+    bool commandJoints(const PathPosition& coordinates, double deltaTime);
+
+    /**
+     * @brief 插补坐标逆变换为关节位置
+     * @param coordinates 插补坐标
+     * @param joints 输出的关节位置
+     * @return 坐标是否可达
+     */
+    bool toJoints(const PathPosition& coordinates, PathPosition& joints) const;
+
+    /**
+     * @brief 获取各轴当前位置对应的插补坐标
+     * @return 插补坐标
+     */
+    PathPosition currentPathPosition() const;
+
+    /**
+     * @brief 各插补坐标的整形输出是否都已追上输入
+     * @return 是否稳定
+     */
+    bool shapersSettled() const;
+
+    /**
+     * @brief 按名称查找插补坐标
+     * @details 笛卡尔直连时为同名轴对应的坐标，设置运动学后为运动学定义的坐标名称
+     * @param axisName 轴或坐标名称
+     * @return 插补坐标索引，不参与插补时返回-1
+     */
+    int findPathAxis(const std::string& axisName) const;
+
+    /**
+     * @brief 获取直线运动的起点：运动中或已有待执行段时为队尾位置，否则为各轴当前位置
+     * @return 起点
+     */
+    PathPosition getPathStart() const;
+
+    /**
+     * @brief 按插补坐标追加直线段
+     * @param target 目标位置
+     * @param feedRate 进给速度 (mm/min)
+     * @param lineNumber 源程序行号
+     * @return 是否成功
+     */
+    bool appendPathLinear(const PathPosition& target, double feedRate, int lineNumber = 0);
+
+    std::map<std::string, std::shared_ptr<Axis>> axes_;              ///< 按名称索引的轴（仅用于配置）
+    std::vector<Axis*> axisList_;                                    ///< 按索引排列的轴
+    std::vector<bool> interpolatedAxes_;                             ///< 各轴是否由插补器驱动（按轴索引）
+    AxisGroup axisGroup_;                                            ///< 按轴索引批量更新各轴
+    std::array<Axis*, kMaxPathAxisCount> pathAxes_{};                ///< 插补坐标对应的轴，未配置时为nullptr
+    size_t pathAxisCount_ = kPathAxisCount;                          ///< 插补坐标数
+    size_t directAxisCount_ = kPathAxisCount;                        ///< 笛卡尔直连时的插补坐标数
+    std::shared_ptr<const Kinematics> kinematics_;                   ///< 运动学变换，nullptr 为笛卡尔直连
+    std::shared_ptr<const HeightMap> heightMap_;                     ///< 工作台表面高度图，nullptr 表示不补偿
+    std::array<Axis*, Kinematics::kMaxCoordinates> jointAxes_{};     ///< 各关节对应的轴
+    size_t jointCount_ = 0;                                          ///< 关节数
+    std::array<InputShaper, kMaxPathAxisCount> shapers_;             ///< 各插补坐标的输入整形器（仅控制循环运行时访问）
+    PathPosition lastPathCommand_{};                                 ///< 最近一个整形前的插补点，插补结束后继续输入直到整形稳定
     std::unique_ptr<core::motion::InterpolationEngine> interpolationEngine_;
-    std::unique_ptr<core::motion::TimeBasedInterpolator> timeBasedInterpolator_;
-    bool isMoving_;
-    MotionState motionState_;
+    PathInterpolator timeBasedInterpolator_;                         ///< 时基插补器
+    std::atomic<bool> isMoving_;                     ///< 是否在执行轨迹（实时线程与命令线程共享）
+    std::atomic<MotionState> motionState_;           ///< 运动状态
+    std::atomic<bool> feedHoldRequested_{false};     ///< 进给保持请求
+    std::atomic<bool> resumeRequested_{false};       ///< 恢复运行请求
+    std::atomic<bool> faultPending_{false};          ///< 控制循环上报的待处理故障
+    std::atomic<int64_t> feedHoldRequestTimeNs_{0};  ///< 进给保持请求时间 (steady_clock, ns)
+    std::atomic<int64_t> lastFeedHoldLatencyUs_{-1}; ///< 最近一次进给保持响应延迟 (us)
+    core::motion::SeqLock<Snapshot> snapshot_;       ///< 每周期发布的状态快照
+    uint64_t snapshotTick_ = 0;                      ///< 已发布的快照序号（仅写者访问）
 };
 
 } // namespace motion
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "xxcnc/motion/MotionController.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace xxcnc {
+namespace motion {
+
+/**
+ * @brief 实时控制循环的线程配置
+ */
+struct RealTimeLoopOptions {
+    int priority = 0;          ///< SCHED_FIFO 优先级（1-99），0 表示不修改调度策略
+    int cpu = -1;              ///< 绑定的 CPU 编号，-1 表示不绑定
+    bool lockMemory = false;   ///< 是否调用 mlockall 锁定进程内存
+};
+
+/**
+ * @brief 实时控制循环，在独立线程中按插补周期调用 MotionController::update()
+ * @details 使用绝对截止时间的 clock_nanosleep 睡眠，避免周期误差累积；
+ *          每周期记录唤醒抖动（实际唤醒时间与截止时间之差）和超限次数，
+ *          统计数据使用原子计数器保存，可在任意线程无锁查询。
+ *          运动控制器的插补器消费者一侧仅由本线程访问。
+ *          非 Linux 平台退化为 std::this_thread::sleep_until，
+ *          Windows 下以 THREAD_PRIORITY_TIME_CRITICAL 代替 SCHED_FIFO。
+ */
+class RealTimeLoop {
+public:
+    /// 抖动直方图桶数：桶0为小于1us，桶k为 [2^(k-1), 2^k) us，最后一个桶为溢出桶
+    static constexpr size_t kJitterBuckets = 24;
+
+    /**
+     * @brief 运行统计
+     */
+    struct Statistics {
+        uint64_t cycles = 0;                                 ///< 已执行周期数
+        uint64_t overruns = 0;                               ///< 超限次数（本周期结束时已错过下一截止时间）
+        uint64_t skippedCycles = 0;                          ///< 因超限跳过的周期数
+        int64_t maxJitterNs = 0;                             ///< 最大唤醒抖动 (ns)
+        int64_t totalJitterNs = 0;                           ///< 唤醒抖动总和 (ns)
+        std::array<uint64_t, kJitterBuckets> jitterHistogram{};  ///< 唤醒抖动直方图
+    };
+
+    /**
+     * @brief 构造函数
+     * @param controller 运动控制器
+     * @param options 线程配置
+     */
+    RealTimeLoop(std::shared_ptr<MotionController> controller,
+                 const RealTimeLoopOptions& options = RealTimeLoopOptions());
+
+    /**
+     * @brief 析构函数，停止循环线程
+     */
+    ~RealTimeLoop();
+
+    RealTimeLoop(const RealTimeLoop&) = delete;
+    RealTimeLoop& operator=(const RealTimeLoop&) = delete;
+
+    /**
+     * @brief 启动循环线程，周期取运动控制器当前的插补周期
+     * @return 是否成功启动（已在运行时返回 false）
+     */
+    bool start();
+
+    /**
+     * @brief 停止循环线程并等待其退出
+     */
+    void stop();
+
+    /**
+     * @brief 检查循环是否在运行
+     * @return 是否在运行
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief 获取运行统计
+     * @return 统计快照
+     */
+    Statistics getStatistics() const;
+
+    /**
+     * @brief 清零运行统计
+     */
+    void resetStatistics();
+
+    /**
+     * @brief 获取直方图桶的抖动上限
+     * @param bucket 桶编号
+     * @return 上限 (us)，溢出桶返回 -1
+     */
+    static int64_t bucketUpperBoundUs(size_t bucket);
+
+private:
+    /**
+     * @brief 循环线程主函数
+     */
+    void run();
+
+    /**
+     * @brief 按配置设置当前线程的调度策略、CPU 亲和性和内存锁定，失败时记录警告
+     */
+    void configureCurrentThread();
+
+    /**
+     * @brief 记录一次唤醒抖动
+     * @param jitterNs 抖动 (ns)
+     */
+    void recordJitter(int64_t jitterNs);
+
+    std::shared_ptr<MotionController> controller_;
+    RealTimeLoopOptions options_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+
+    std::atomic<uint64_t> cycles_{0};
+    std::atomic<uint64_t> overruns_{0};
+    std::atomic<uint64_t> skippedCycles_{0};
+    std::atomic<int64_t> maxJitterNs_{0};
+    std::atomic<int64_t> totalJitterNs_{0};
+    std::array<std::atomic<uint64_t>, kJitterBuckets> jitterHistogram_{};
+};
+
+} // namespace motion
+} // namespace xxcnc
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cstdlib>
 #include <string>
 #include <filesystem>
 #include <iostream>
@@ -42,9 +44,24 @@ int main() {
         
         spdlog::info("Starting XXCNC server...");
 
-        // 创建 RealWebAPI 实例
-        auto api = std::make_shared<RealWebAPI>();
-        spdlog::info("Created RealWebAPI instance");
+        // 创建 RealWebAPI 实例，通道数由环境变量 XXCNC_CHANNELS 指定，缺省为1
+        size_t channelCount = 1;
+        if (const char* channels = std::getenv("XXCNC_CHANNELS")) {
+            channelCount = static_cast<size_t>(std::max(1, std::atoi(channels)));
+        }
+        // 每个通道轨迹历史的容量（点）由环境变量 XXCNC_TRAJECTORY_HISTORY 指定
+        size_t historyCapacity = xxcnc::web::TrajectoryHistory::kDefaultCapacity;
+        if (const char* history = std::getenv("XXCNC_TRAJECTORY_HISTORY")) {
+            historyCapacity = static_cast<size_t>(std::max(1LL, std::atoll(history)));
+        }
+        // 解析结果缓存的内存预算（MB）由环境变量 XXCNC_PARSE_CACHE_MB 指定
+        size_t parseCacheBudget = xxcnc::web::ParseCache::kDefaultBudget;
+        if (const char* budget = std::getenv("XXCNC_PARSE_CACHE_MB")) {
+            parseCacheBudget = static_cast<size_t>(std::max(0LL, std::atoll(budget))) * 1024 * 1024;
+        }
+        auto api = std::make_shared<RealWebAPI>(channelCount, historyCapacity, parseCacheBudget);
+        spdlog::info("Created RealWebAPI instance with {} channel(s), trajectory history capacity {} points, "
+                     "parse cache budget {} MB", channelCount, historyCapacity, parseCacheBudget / (1024 * 1024));
 
         // 创建 WebServer 实例
         xxcnc::web::WebServer server(api);
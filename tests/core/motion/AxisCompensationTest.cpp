@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include "xxcnc/motion/Axis.h"
+#include "xxcnc/motion/AxisCompensation.h"
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using namespace xxcnc::motion;
+
+class AxisCompensationTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // 0~100mm 每10mm一个点，误差线性增长到0.02mm
+        std::vector<double> corrections;
+        for (int i = 0; i <= 10; ++i) {
+            corrections.push_back(-0.002 * i);
+        }
+        ASSERT_TRUE(compensation_.setPitchTable(0.0, 10.0, corrections));
+        ASSERT_TRUE(compensation_.setBacklash(0.02));
+    }
+
+    void TearDown() override {
+        if (!tempFile_.empty()) {
+            std::filesystem::remove(tempFile_);
+        }
+    }
+
+    /**
+     * @brief 将内容写入临时补偿表文件
+     */
+    std::string writeTable(const std::string& content) {
+        tempFile_ = (std::filesystem::temp_directory_path() / "xxcnc_compensation_test.txt").string();
+        std::ofstream file(tempFile_);
+        file << content;
+        return tempFile_;
+    }
+
+    AxisCompensation compensation_;
+    std::string tempFile_;
+    const double dt_ = 0.001;
+};
+
+TEST_F(AxisCompensationTest, PitchTableInterpolatesAndClamps) {
+    EXPECT_DOUBLE_EQ(compensation_.pitchCorrection(0.0), 0.0);
+    EXPECT_NEAR(compensation_.pitchCorrection(25.0), -0.005, 1e-15);
+    EXPECT_NEAR(compensation_.pitchCorrection(100.0), -0.02, 1e-15);
+    // 超出表范围取端点值
+    EXPECT_NEAR(compensation_.pitchCorrection(-50.0), 0.0, 1e-15);
+    EXPECT_NEAR(compensation_.pitchCorrection(250.0), -0.02, 1e-15);
+
+    // 未设置的表补偿为零
+    AxisCompensation empty;
+    EXPECT_DOUBLE_EQ(empty.pitchCorrection(123.0), 0.0);
+    EXPECT_DOUBLE_EQ(empty.apply(5.0, dt_), 5.0);
+
+    EXPECT_FALSE(compensation_.setPitchTable(0.0, 0.0, {0.0, 1.0}));
+    EXPECT_FALSE(compensation_.setPitchTable(0.0, 1.0, {0.0}));
+}
+
+TEST_F(AxisCompensationTest, BacklashFlipsOnDirectionReversal) {
+    compensation_.reset(10.0);
+    EXPECT_DOUBLE_EQ(compensation_.getBacklashOffset(), 0.0);
+
+    // 正向运动：加半个间隙
+    double position = 10.0;
+    for (int i = 0; i < 10; ++i) {
+        position += 0.1;
+        compensation_.apply(position, dt_);
+    }
+    EXPECT_DOUBLE_EQ(compensation_.getBacklashOffset(), 0.01);
+
+    // 停止时保持方向
+    for (int i = 0; i < 10; ++i) {
+        compensation_.apply(position, dt_);
+    }
+    EXPECT_DOUBLE_EQ(compensation_.getBacklashOffset(), 0.01);
+
+    // 反向：立即切换到另一侧，电机指令包含螺距补偿和间隙补偿
+    position -= 0.1;
+    const double motor = compensation_.apply(position, dt_);
+    EXPECT_DOUBLE_EQ(compensation_.getBacklashOffset(), -0.01);
+    EXPECT_NEAR(motor, position + compensation_.pitchCorrection(position) - 0.01, 1e-15);
+
+    // 低于阈值的抖动不改变方向
+    compensation_.apply(position + 1e-12, dt_);
+    EXPECT_DOUBLE_EQ(compensation_.getBacklashOffset(), -0.01);
+}
+
+TEST_F(AxisCompensationTest, BacklashRampLimitsCommandStep) {
+    ASSERT_TRUE(compensation_.setBacklash(0.02, 5.0));   // 5mm/s，每周期最多0.005mm
+    compensation_.reset(50.0);
+    double position = 50.0;
+    for (int i = 0; i < 20; ++i) {
+        position += 0.01;
+        compensation_.apply(position, dt_);
+    }
+    EXPECT_DOUBLE_EQ(compensation_.getBacklashOffset(), 0.01);
+
+    // 反向后补偿量按最大速度过渡，4个周期完成
+    int ticks = 0;
+    double last = compensation_.getBacklashOffset();
+    while (compensation_.getBacklashOffset() > -0.01 && ticks < 100) {
+        position -= 0.01;
+        compensation_.apply(position, dt_);
+        EXPECT_LE(last - compensation_.getBacklashOffset(), 0.005 + 1e-15);
+        last = compensation_.getBacklashOffset();
+        ++ticks;
+    }
+    EXPECT_EQ(ticks, 4);
+}
+
+TEST_F(AxisCompensationTest, LoadsTableFromFile) {
+    AxisCompensation loaded;
+    ASSERT_TRUE(loaded.loadFromFile(writeTable(
+        "# X 轴螺距误差\n"
+        "backlash 0.015   # 反向间隙\n"
+        "backlash_ramp 2.0\n"
+        "-10  0.001\n"
+        "0    0.000\n"
+        "10  -0.003\n")));
+    EXPECT_EQ(loaded.getPitchPointCount(), 3u);
+    EXPECT_DOUBLE_EQ(loaded.getBacklash(), 0.015);
+    EXPECT_NEAR(loaded.pitchCorrection(5.0), -0.0015, 1e-15);
+    EXPECT_NEAR(loaded.pitchCorrection(-5.0), 0.0005, 1e-15);
+
+    // 非等间距或格式错误时失败且保持原配置
+    EXPECT_FALSE(loaded.loadFromFile(writeTable("0 0\n10 0.001\n25 0.002\n")));
+    EXPECT_FALSE(loaded.loadFromFile(writeTable("backlash abc\n")));
+    EXPECT_FALSE(loaded.loadFromFile("/nonexistent/compensation.txt"));
+    EXPECT_EQ(loaded.getPitchPointCount(), 3u);
+    EXPECT_DOUBLE_EQ(loaded.getBacklash(), 0.015);
+}
+
+TEST_F(AxisCompensationTest, AxisPublishesCompensatedMotorPosition) {
+    AxisParameters params;
+    params.maxVelocity = 50000.0;    // 单周期跳变到 40mm 不超速
+    params.maxAcceleration = 1000.0;
+    params.maxJerk = 5000.0;
+    params.homeVelocity = 10.0;
+    params.softLimitMin = -1000.0;
+    params.softLimitMax = 1000.0;
+    params.homePosition = 0.0;
+    Axis axis("X", params);
+    axis.setCompensation(compensation_);
+    ASSERT_TRUE(axis.enable());
+
+    ASSERT_TRUE(axis.followPosition(40.0, dt_));
+    EXPECT_DOUBLE_EQ(axis.getCurrentPosition(), 40.0);
+    EXPECT_NEAR(axis.getMotorPosition(), 40.0 - 0.008 + 0.01, 1e-12);
+
+    ASSERT_TRUE(axis.followPosition(39.0, dt_));
+    EXPECT_NEAR(axis.getMotorPosition(), 39.0 - 0.0078 - 0.01, 1e-12);
+}
+
+TEST_F(AxisCompensationTest, Performance) {
+    std::vector<double> corrections(1001);
+    for (size_t i = 0; i < corrections.size(); ++i) {
+        corrections[i] = 0.01 * std::sin(0.05 * static_cast<double>(i));
+    }
+    ASSERT_TRUE(compensation_.setPitchTable(0.0, 1.0, corrections));
+
+    // 往复运动的位置指令，覆盖整张表并频繁反向
+    std::vector<double> positions(4096);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        positions[i] = 500.0 + 400.0 * std::sin(static_cast<double>(i) * 0.01);
+    }
+
+    const int ticks = 1000000;
+    double checksum = 0.0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int n = 0; n < ticks; ++n) {
+        checksum += compensation_.apply(positions[n & 4095], dt_);
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now() - start);
+
+    EXPECT_TRUE(std::isfinite(checksum));
+    double perTick = static_cast<double>(duration.count()) / ticks;
+    EXPECT_LT(perTick, 1000.0);
+    std::cout << "AxisCompensation::apply: " << perTick << " ns/tick" << std::endl;
+}
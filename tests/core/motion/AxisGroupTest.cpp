@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "xxcnc/motion/AxisGroup.h"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace xxcnc::motion;
+
+class AxisGroupTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        params_.maxVelocity = 1000.0;      // 最大速度 1000mm/s
+        params_.maxAcceleration = 500.0;   // 最大加速度 500mm/s²
+        params_.maxJerk = 5000.0;          // 最大加加速度 5000mm/s³
+        params_.homeVelocity = 10.0;       // 回零速度 10mm/s
+        params_.softLimitMin = -100.0;     // 软限位最小值 -100mm
+        params_.softLimitMax = 100.0;      // 软限位最大值 100mm
+        params_.homePosition = 0.0;
+    }
+
+    // 创建两组相同的轴，一组加入轴组批量更新，另一组逐轴更新
+    void createAxes(size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            const std::string name = "A" + std::to_string(i);
+            batched_.push_back(std::make_unique<Axis>(name, params_));
+            scalar_.push_back(std::make_unique<Axis>(name, params_));
+            EXPECT_EQ(group_.addAxis(batched_[i].get()), i);
+        }
+    }
+
+    // 对两组轴发出同样的指令
+    template <typename Command>
+    void command(size_t index, Command&& command) {
+        EXPECT_EQ(command(*batched_[index]), command(*scalar_[index]));
+    }
+
+    AxisParameters params_;
+    AxisGroup group_;
+    std::vector<std::unique_ptr<Axis>> batched_;
+    std::vector<std::unique_ptr<Axis>> scalar_;
+};
+
+TEST_F(AxisGroupTest, MatchesSingleAxisUpdate) {
+    // 速度运动（含超速限幅和触发软限位）、点到点运动、回零和未使能的轴
+    createAxes(7);
+    const std::vector<double> velocities = {50.0, -80.0, 300.0, 0.0, -2000.0};
+    for (size_t i = 0; i < velocities.size(); ++i) {
+        command(i, [](Axis& axis) { return axis.enable(); });
+        command(i, [&](Axis& axis) { return axis.moveVelocity(velocities[i]); });
+    }
+    command(5, [](Axis& axis) { return axis.enable(); });
+    command(5, [](Axis& axis) { return axis.home(); });
+
+    for (int tick = 0; tick < 2000; ++tick) {
+        if (tick == 300) {
+            command(0, [](Axis& axis) { return axis.stop(); });
+            command(3, [](Axis& axis) { return axis.moveTo(20.0, 100.0); });
+        }
+        if (tick == 400) {
+            // 点到点运动中改变目标，从当前状态重新规划
+            command(3, [](Axis& axis) { return axis.moveTo(-10.0, 200.0); });
+        }
+        group_.update(0.001);
+        for (auto& axis : scalar_) {
+            axis->update(0.001);
+        }
+        for (size_t i = 0; i < scalar_.size(); ++i) {
+            ASSERT_DOUBLE_EQ(batched_[i]->getCurrentPosition(), scalar_[i]->getCurrentPosition())
+                << "axis " << i << " tick " << tick;
+            ASSERT_DOUBLE_EQ(batched_[i]->getCurrentVelocity(), scalar_[i]->getCurrentVelocity());
+            ASSERT_DOUBLE_EQ(batched_[i]->getCurrentAcceleration(), scalar_[i]->getCurrentAcceleration());
+            ASSERT_DOUBLE_EQ(batched_[i]->getMotorPosition(), scalar_[i]->getMotorPosition());
+            ASSERT_EQ(batched_[i]->getState(), scalar_[i]->getState());
+        }
+    }
+
+    // 减速停止和点到点运动结束的轴回到空闲，高速轴触发软限位进入错误状态
+    EXPECT_EQ(batched_[0]->getState(), AxisState::IDLE);
+    EXPECT_EQ(batched_[2]->getState(), AxisState::ERROR);
+    EXPECT_EQ(batched_[3]->getState(), AxisState::IDLE);
+    EXPECT_NEAR(batched_[3]->getCurrentPosition(), -10.0, 1e-9);
+    EXPECT_EQ(batched_[4]->getState(), AxisState::ERROR);
+    EXPECT_EQ(batched_[6]->getState(), AxisState::DISABLED);
+    EXPECT_DOUBLE_EQ(batched_[6]->getCurrentPosition(), 0.0);
+}
+
+TEST_F(AxisGroupTest, SkipsMarkedAxes) {
+    createAxes(2);
+    EXPECT_EQ(group_.size(), 2u);
+    EXPECT_EQ(group_.getAxis(1), batched_[1].get());
+    for (auto& axis : batched_) {
+        ASSERT_TRUE(axis->enable());
+        ASSERT_TRUE(axis->moveVelocity(10.0));
+    }
+
+    // 被跳过的轴（由插补器驱动）不积分
+    const std::vector<bool> skip = {false, true};
+    for (int i = 0; i < 100; ++i) {
+        group_.update(0.01, &skip);
+    }
+    EXPECT_GT(batched_[0]->getCurrentPosition(), 0.0);
+    EXPECT_DOUBLE_EQ(batched_[1]->getCurrentPosition(), 0.0);
+
+    // 禁用后立即停止
+    ASSERT_TRUE(batched_[0]->disable());
+    double position = batched_[0]->getCurrentPosition();
+    group_.update(0.01);
+    EXPECT_DOUBLE_EQ(batched_[0]->getCurrentPosition(), position);
+    EXPECT_DOUBLE_EQ(batched_[0]->getCurrentVelocity(), 0.0);
+}
+
+// 性能测试
+TEST_F(AxisGroupTest, Performance) {
+    // 模拟多台机床：共 48 个控制器 x 6 轴
+    const size_t axisCount = 48 * 6;
+    const int ticks = 2000;
+    params_.softLimitMin = -1e9;
+    params_.softLimitMax = 1e9;
+    createAxes(axisCount);
+    for (size_t i = 0; i < axisCount; ++i) {
+        const double velocity = static_cast<double>(i % 7) * 10.0 + 1.0;
+        command(i, [](Axis& axis) { return axis.enable(); });
+        command(i, [velocity](Axis& axis) { return axis.moveVelocity(velocity); });
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int tick = 0; tick < ticks; ++tick) {
+        group_.update(0.001);
+    }
+    auto groupDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now() - start);
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int tick = 0; tick < ticks; ++tick) {
+        for (auto& axis : scalar_) {
+            axis->update(0.001);
+        }
+    }
+    auto axisDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now() - start);
+
+    EXPECT_DOUBLE_EQ(batched_[axisCount - 1]->getCurrentPosition(), scalar_[axisCount - 1]->getCurrentPosition());
+    double groupPerAxis = static_cast<double>(groupDuration.count()) / (ticks * axisCount);
+    double axisPerAxis = static_cast<double>(axisDuration.count()) / (ticks * axisCount);
+    std::cout << "AxisGroup::update: " << groupPerAxis << " ns/axis, "
+              << "Axis::update: " << axisPerAxis << " ns/axis" << std::endl;
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include "xxcnc/motion/ChannelManager.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace xxcnc::motion;
+
+class ChannelManagerTest : public ::testing::Test {
+protected:
+    static std::shared_ptr<MotionController> createController() {
+        AxisParameters params;
+        params.maxVelocity = 500.0;
+        params.maxAcceleration = 1000.0;
+        params.maxJerk = 5000.0;
+        params.homeVelocity = 10.0;
+        params.softLimitMin = -1000.0;
+        params.softLimitMax = 1000.0;
+        params.homePosition = 0.0;
+        auto controller = std::make_shared<MotionController>();
+        controller->addAxis("X", params);
+        controller->addAxis("Y", params);
+        controller->addAxis("Z", params);
+        controller->enableAllAxes();
+        return controller;
+    }
+};
+
+TEST_F(ChannelManagerTest, AssignsChannelIdsAndCpus) {
+    ChannelManager manager(RealTimeLoopOptions(), 0);
+    const int cpuCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    EXPECT_EQ(manager.addChannel(createController()), 0);
+    EXPECT_EQ(manager.addChannel(createController()), 1);
+    EXPECT_EQ(manager.addChannel(createController(), -1), 2);
+    EXPECT_EQ(manager.getChannelCount(), 3u);
+
+    EXPECT_EQ(manager.getChannelCpu(0), 0);
+    EXPECT_EQ(manager.getChannelCpu(1), 1 % cpuCount);
+    EXPECT_EQ(manager.getChannelCpu(2), -1);
+
+    // 空控制器、与其他通道共用的控制器和无效编号
+    EXPECT_EQ(manager.addChannel(nullptr), -1);
+    EXPECT_EQ(manager.addChannel(manager.getChannel(0)), -1);
+    EXPECT_EQ(manager.getChannel(3), nullptr);
+    EXPECT_EQ(manager.getLoop(-1), nullptr);
+    EXPECT_FALSE(manager.startChannel(5));
+    EXPECT_EQ(manager.getChannelCount(), 3u);
+}
+
+TEST_F(ChannelManagerTest, ChannelsRunIndependentPrograms) {
+    ChannelManager manager;
+    const int first = manager.addChannel(createController());
+    const int second = manager.addChannel(createController());
+    auto firstController = manager.getChannel(first);
+    auto secondController = manager.getChannel(second);
+
+    ASSERT_TRUE(firstController->moveLinear({{"X", 10.0}}, 6000.0));
+    ASSERT_TRUE(secondController->moveLinear({{"Y", -5.0}, {"Z", 2.0}}, 3000.0));
+    ASSERT_TRUE(manager.start());
+    EXPECT_TRUE(manager.isRunning());
+
+    // 运行中不能添加通道
+    EXPECT_EQ(manager.addChannel(createController()), -1);
+
+    ASSERT_TRUE(firstController->startMotion());
+    ASSERT_TRUE(secondController->startMotion());
+    for (int i = 0; i < 300 && !(firstController->isInterpolationFinished() &&
+                                 secondController->isInterpolationFinished()); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // 停止一个通道不影响另一个通道
+    manager.stopChannel(first);
+    EXPECT_FALSE(manager.getLoop(first)->isRunning());
+    EXPECT_TRUE(manager.getLoop(second)->isRunning());
+    manager.stop();
+    EXPECT_FALSE(manager.isRunning());
+
+    EXPECT_NEAR(firstController->getAxis("X")->getCurrentPosition(), 10.0, 1e-9);
+    EXPECT_NEAR(firstController->getAxis("Y")->getCurrentPosition(), 0.0, 1e-9);
+    EXPECT_NEAR(secondController->getAxis("X")->getCurrentPosition(), 0.0, 1e-9);
+    EXPECT_NEAR(secondController->getAxis("Y")->getCurrentPosition(), -5.0, 1e-9);
+    EXPECT_NEAR(secondController->getAxis("Z")->getCurrentPosition(), 2.0, 1e-9);
+    EXPECT_GT(manager.getLoop(first)->getStatistics().cycles, 50u);
+    EXPECT_GT(manager.getLoop(second)->getStatistics().cycles, 50u);
+}
+
+TEST_F(ChannelManagerTest, Performance) {
+    // 各通道在独立线程中连续执行插补周期，测量总吞吐量随通道数的变化
+    constexpr int kCycles = 50000;
+    const unsigned cpuCount = std::max(1u, std::thread::hardware_concurrency());
+    double singleThroughput = 0.0;
+
+    for (unsigned channels = 1; channels <= std::min(4u, cpuCount); channels *= 2) {
+        std::vector<std::shared_ptr<MotionController>> controllers;
+        for (unsigned i = 0; i < channels; ++i) {
+            auto controller = createController();
+            ASSERT_TRUE(controller->moveLinear({{"X", 900.0}, {"Y", 450.0}}, 600.0));
+            ASSERT_TRUE(controller->startMotion());
+            controllers.push_back(controller);
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<std::thread> threads;
+        for (auto& controller : controllers) {
+            threads.emplace_back([&controller]() {
+                for (int cycle = 0; cycle < kCycles; ++cycle) {
+                    controller->update(0.001);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        double seconds = std::chrono::duration<double>(end - start).count();
+        double throughput = channels * kCycles / seconds;
+        if (channels == 1) {
+            singleThroughput = throughput;
+        }
+        std::cout << channels << " 个通道总吞吐量: " << throughput / 1e6 << " M周期/秒，相对单通道 "
+                  << throughput / singleThroughput << " 倍" << std::endl;
+
+        for (auto& controller : controllers) {
+            EXPECT_TRUE(controller->getSnapshot().moving);
+        }
+    }
+}
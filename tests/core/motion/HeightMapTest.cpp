@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include "xxcnc/motion/HeightMap.h"
+#include "xxcnc/motion/MotionController.h"
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+using namespace xxcnc::motion;
+
+class HeightMapTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        if (!tempFile_.empty()) {
+            std::filesystem::remove(tempFile_);
+        }
+    }
+
+    /**
+     * @brief 按函数生成网格高度
+     */
+    template <typename F>
+    std::vector<double> sampleGrid(size_t columns, size_t rows, double spacing, F&& surface) {
+        std::vector<double> heights(columns * rows);
+        for (size_t r = 0; r < rows; ++r) {
+            for (size_t c = 0; c < columns; ++c) {
+                heights[r * columns + c] = surface(c * spacing, r * spacing);
+            }
+        }
+        return heights;
+    }
+
+    /**
+     * @brief 将内容写入临时 CSV 文件
+     */
+    std::string writeCsv(const std::string& content) {
+        tempFile_ = (std::filesystem::temp_directory_path() / "xxcnc_heightmap_test.csv").string();
+        std::ofstream file(tempFile_);
+        file << content;
+        return tempFile_;
+    }
+
+    std::string tempFile_;
+};
+
+TEST_F(HeightMapTest, ReproducesNodesAndPlanes) {
+    auto plane = [](double x, double y) { return 0.2 + 0.001 * x - 0.002 * y; };
+    const std::vector<double> heights = sampleGrid(6, 5, 20.0, plane);
+
+    for (HeightMapInterpolation interpolation : {HeightMapInterpolation::Bilinear, HeightMapInterpolation::Bicubic}) {
+        HeightMap map;
+        ASSERT_TRUE(map.setGrid(0.0, 0.0, 20.0, 20.0, 6, 5, heights, interpolation));
+        // 网格内任意点（含边界单元）都精确重现平面
+        for (double x = 0.0; x <= 100.0; x += 3.7) {
+            for (double y = 0.0; y <= 80.0; y += 4.1) {
+                EXPECT_NEAR(map.heightAt(x, y), plane(x, y), 1e-12);
+            }
+        }
+        // 网格外截断到边界
+        EXPECT_NEAR(map.heightAt(-50.0, 40.0), plane(0.0, 40.0), 1e-12);
+        EXPECT_NEAR(map.heightAt(130.0, 200.0), plane(100.0, 80.0), 1e-12);
+    }
+
+    HeightMap empty;
+    EXPECT_TRUE(empty.isEmpty());
+    EXPECT_DOUBLE_EQ(empty.heightAt(10.0, 10.0), 0.0);
+    EXPECT_FALSE(empty.setGrid(0.0, 0.0, 10.0, 10.0, 2, 2, {0.0, 0.0, 0.0}));
+}
+
+TEST_F(HeightMapTest, BicubicFollowsCurvedSurface) {
+    auto surface = [](double x, double y) { return 0.1 * std::sin(x * 0.02) * std::cos(y * 0.015); };
+    const std::vector<double> heights = sampleGrid(11, 11, 25.0, surface);
+    HeightMap bilinear;
+    HeightMap bicubic;
+    ASSERT_TRUE(bilinear.setGrid(0.0, 0.0, 25.0, 25.0, 11, 11, heights, HeightMapInterpolation::Bilinear));
+    ASSERT_TRUE(bicubic.setGrid(0.0, 0.0, 25.0, 25.0, 11, 11, heights, HeightMapInterpolation::Bicubic));
+
+    double bilinearError = 0.0;
+    double bicubicError = 0.0;
+    for (double x = 25.0; x <= 225.0; x += 1.3) {
+        for (double y = 25.0; y <= 225.0; y += 1.7) {
+            bilinearError = std::max(bilinearError, std::abs(bilinear.heightAt(x, y) - surface(x, y)));
+            bicubicError = std::max(bicubicError, std::abs(bicubic.heightAt(x, y) - surface(x, y)));
+        }
+    }
+    EXPECT_LT(bicubicError, 0.5 * bilinearError);
+
+    // 节点上精确，节点之间连续
+    EXPECT_NEAR(bicubic.heightAt(100.0, 150.0), surface(100.0, 150.0), 1e-12);
+    EXPECT_NEAR(bicubic.heightAt(100.0 - 1e-9, 137.0), bicubic.heightAt(100.0 + 1e-9, 137.0), 1e-9);
+}
+
+TEST_F(HeightMapTest, LoadsProbeCsv) {
+    HeightMap map;
+    ASSERT_TRUE(map.loadFromCsv(writeCsv(
+        "x,y,z\n"
+        "# 探测顺序任意\n"
+        "10,0,0.02\n"
+        "0,0,0.00\n"
+        "0,5,0.01\n"
+        "10,5,0.05\n"), HeightMapInterpolation::Bilinear));
+    EXPECT_EQ(map.getColumns(), 2u);
+    EXPECT_EQ(map.getRows(), 2u);
+    EXPECT_NEAR(map.heightAt(5.0, 2.5), 0.02, 1e-12);
+
+    // 缺少节点或不等间距时失败且保持原网格
+    EXPECT_FALSE(map.loadFromCsv(writeCsv("0,0,0\n10,0,0\n0,5,0\n")));
+    EXPECT_FALSE(map.loadFromCsv(writeCsv("0,0,0\n10,0,0\n25,0,0\n0,5,0\n10,5,0\n25,5,0\n")));
+    EXPECT_FALSE(map.loadFromCsv(writeCsv("0,0,0\n10,0,0\n0,5,abc\n10,5,0\n")));
+    EXPECT_NEAR(map.heightAt(5.0, 2.5), 0.02, 1e-12);
+}
+
+TEST_F(HeightMapTest, ControllerFollowsSurfaceAlongLongMove) {
+    AxisParameters params;
+    params.maxVelocity = 500.0;
+    params.maxAcceleration = 1000.0;
+    params.maxJerk = 5000.0;
+    params.homeVelocity = 10.0;
+    params.softLimitMin = -1000.0;
+    params.softLimitMax = 1000.0;
+    params.homePosition = 0.0;
+    MotionController controller;
+    controller.addAxis("X", params);
+    controller.addAxis("Y", params);
+    controller.addAxis("Z", params);
+    controller.enableAllAxes();
+
+    // 工作台沿 X 方向倾斜并带一个凸起
+    auto surface = [](double x, double y) { return 0.005 * x + 0.2 * std::exp(-((x - 100) * (x - 100) + y * y) / 800.0); };
+    auto map = std::make_shared<HeightMap>();
+    ASSERT_TRUE(map->setGrid(0.0, -50.0, 10.0, 10.0, 21, 11,
+                             sampleGrid(21, 11, 10.0, [&](double x, double y) { return surface(x, y - 50.0); })));
+    ASSERT_TRUE(controller.setHeightMap(map));
+
+    // 一段 200mm 的长直线，Z 每个周期都跟随表面；轴从 Z=0 出发，编程高度为 -h(0, 0)
+    auto axis = [&](const char* name) { return controller.getAxis(name)->getCurrentPosition(); };
+    const double programZ = -map->heightAt(0.0, 0.0);
+    ASSERT_TRUE(controller.moveLinear({{"X", 200.0}}, 6000.0));
+    ASSERT_TRUE(controller.startMotion());
+    for (int i = 0; i < 10000; ++i) {
+        controller.update(0.001);
+        EXPECT_NEAR(axis("Z"), programZ + map->heightAt(axis("X"), axis("Y")), 1e-12);
+        if (!controller.getSnapshot().moving) {
+            break;
+        }
+    }
+    EXPECT_NEAR(axis("X"), 200.0, 1e-9);
+    EXPECT_NEAR(axis("Z"), programZ + map->heightAt(200.0, 0.0), 1e-12);
+
+    // 编程坐标不含补偿：Z=0 的编程高度正好落在表面上
+    ASSERT_TRUE(controller.moveLinear({{"X", 150.0}, {"Z", 0.0}}, 6000.0));
+    ASSERT_TRUE(controller.startMotion());
+    for (int i = 0; i < 10000; ++i) {
+        controller.update(0.001);
+        if (!controller.getSnapshot().moving) {
+            break;
+        }
+    }
+    EXPECT_NEAR(axis("Z"), map->heightAt(150.0, 0.0), 1e-12);
+}
+
+TEST_F(HeightMapTest, Performance) {
+    const size_t size = 101;
+    HeightMap map;
+    ASSERT_TRUE(map.setGrid(0.0, 0.0, 10.0, 10.0, size, size,
+                            sampleGrid(size, size, 10.0, [](double x, double y) { return std::sin(x * 0.01) * y * 1e-4; })));
+
+    // 模拟插补点：沿光栅路径连续移动的查询位置
+    std::vector<double> xs(1 << 16);
+    std::vector<double> ys(xs.size());
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> step(-0.5, 0.5);
+    double x = 500.0;
+    double y = 500.0;
+    for (size_t i = 0; i < xs.size(); ++i) {
+        x = std::min(std::max(x + step(rng), 0.0), 1000.0);
+        y = std::min(std::max(y + step(rng), 0.0), 1000.0);
+        xs[i] = x;
+        ys[i] = y;
+    }
+
+    const int lookups = 2000000;
+    double checksum = 0.0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int n = 0; n < lookups; ++n) {
+        const size_t i = static_cast<size_t>(n) & (xs.size() - 1);
+        checksum += map.heightAt(xs[i], ys[i]);
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now() - start);
+
+    EXPECT_TRUE(std::isfinite(checksum));
+    double perLookup = static_cast<double>(duration.count()) / lookups;
+    EXPECT_LT(perLookup, 1000.0);
+    std::cout << "HeightMap::heightAt (bicubic, 101x101): " << perLookup << " ns/lookup" << std::endl;
+}
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include "xxcnc/motion/InputShaper.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace xxcnc::motion;
+
+class InputShaperTest : public ::testing::Test {
+protected:
+    /**
+     * @brief 以恒定加速度加速再减速的点到点指令序列，按插补周期采样
+     * @param distance 运动距离 (mm)
+     * @param acceleration 加速度 (mm/s²)
+     */
+    std::vector<double> bangBangMove(double distance, double acceleration) const {
+        const double half = std::sqrt(distance / acceleration);
+        std::vector<double> commands;
+        for (double t = 0.0; t < 2.0 * half + period_; t += period_) {
+            if (t < half) {
+                commands.push_back(0.5 * acceleration * t * t);
+            } else if (t < 2.0 * half) {
+                commands.push_back(distance - 0.5 * acceleration * (2.0 * half - t) * (2.0 * half - t));
+            } else {
+                commands.push_back(distance);
+            }
+        }
+        return commands;
+    }
+
+    /**
+     * @brief 以指令序列驱动二阶振荡器（龙门的一阶谐振模态），返回运动结束后的残余振幅
+     * @param commands 位置指令序列
+     * @param shaper 整形器，nullptr 表示不整形
+     */
+    double residualVibration(const std::vector<double>& commands, InputShaper* shaper) const {
+        const double omega = 2.0 * 3.14159265358979323846 * plantFrequency_;
+        const int substeps = 100;
+        const double h = period_ / substeps;
+        const int tailTicks = 400;
+        const double target = commands.back();
+
+        double x = commands.front();
+        double v = 0.0;
+        double previous = commands.front();
+        if (shaper) {
+            shaper->reset(previous);
+        }
+
+        double residual = 0.0;
+        const size_t total = commands.size() + tailTicks;
+        for (size_t n = 0; n < total; ++n) {
+            double command = commands[std::min(n, commands.size() - 1)];
+            if (shaper) {
+                command = shaper->process(command);
+            }
+
+            // 指令在周期内线性变化，振荡器以小步长积分
+            const double commandVelocity = (command - previous) / period_;
+            for (int k = 1; k <= substeps; ++k) {
+                const double u = previous + commandVelocity * h * k;
+                const double a = -omega * omega * (x - u) - 2.0 * plantDamping_ * omega * (v - commandVelocity);
+                v += a * h;
+                x += v * h;
+            }
+            previous = command;
+
+            // 只统计指令（含整形延迟）结束之后的振动
+            if (n >= commands.size() + 100) {
+                residual = std::max(residual, std::abs(x - target));
+            }
+        }
+        return residual;
+    }
+
+    const double period_ = 0.001;          // 插补周期 1ms
+    const double plantFrequency_ = 40.0;   // 龙门谐振频率 40Hz
+    const double plantDamping_ = 0.05;     // 龙门阻尼比
+};
+
+TEST_F(InputShaperTest, StepResponseHasUnitGainAndSettles) {
+    for (InputShaperType type : {InputShaperType::ZV, InputShaperType::ZVD, InputShaperType::EI}) {
+        InputShaper shaper;
+        ASSERT_TRUE(shaper.configure(type, 40.0, 0.1, period_));
+        shaper.reset(0.0);
+        EXPECT_TRUE(shaper.isSettled());
+
+        // 阶跃输入：输出单调、不超调，在整形时长后精确到达终值
+        double last = 0.0;
+        int ticks = 0;
+        do {
+            const double output = shaper.process(1.0);
+            EXPECT_GE(output, last - 1e-12);
+            EXPECT_LE(output, 1.0 + 1e-12);
+            last = output;
+            ++ticks;
+        } while (!shaper.isSettled() && ticks < 1000);
+
+        EXPECT_DOUBLE_EQ(last, 1.0);
+        EXPECT_NEAR(ticks * period_, shaper.getDuration(), 2.0 * period_);
+    }
+
+    // 关闭整形时输出等于输入
+    InputShaper passThrough;
+    EXPECT_DOUBLE_EQ(passThrough.process(3.5), 3.5);
+    EXPECT_TRUE(passThrough.isSettled());
+}
+
+TEST_F(InputShaperTest, RejectsInvalidParameters) {
+    InputShaper shaper;
+    EXPECT_FALSE(shaper.configure(InputShaperType::ZV, 0.0, 0.1, period_));
+    EXPECT_FALSE(shaper.configure(InputShaperType::ZV, 40.0, 1.0, period_));
+    EXPECT_FALSE(shaper.configure(InputShaperType::ZV, 40.0, 0.1, 0.0));
+    // 整形时长超出历史缓冲区
+    EXPECT_FALSE(shaper.configure(InputShaperType::ZVD, 1.0, 0.1, period_));
+    EXPECT_EQ(shaper.getType(), InputShaperType::None);
+}
+
+TEST_F(InputShaperTest, SuppressesResidualVibration) {
+    const std::vector<double> slow = bangBangMove(10.0, 3000.0);
+    const std::vector<double> fast = bangBangMove(10.0, 12000.0);
+    const double unshapedSlow = residualVibration(slow, nullptr);
+    const double unshapedFast = residualVibration(fast, nullptr);
+    ASSERT_GT(unshapedSlow, 1e-3);
+
+    for (InputShaperType type : {InputShaperType::ZV, InputShaperType::ZVD, InputShaperType::EI}) {
+        InputShaper shaper;
+        ASSERT_TRUE(shaper.configure(type, plantFrequency_, plantDamping_, period_));
+        const double shaped = residualVibration(fast, &shaper);
+        std::cout << "InputShaper type " << static_cast<int>(type) << ": residual " << shaped
+                  << " mm (unshaped " << unshapedFast << " mm at 4x, " << unshapedSlow << " mm at 1x)" << std::endl;
+
+        // 4倍加速度下整形后的残余振动仍小于不整形时1倍加速度的残余振动
+        EXPECT_LT(shaped, 0.1 * unshapedFast);
+        EXPECT_LT(shaped, unshapedSlow);
+    }
+
+    // 谐振频率估计偏差10%时，ZVD/EI 仍能大幅抑制振动
+    for (InputShaperType type : {InputShaperType::ZVD, InputShaperType::EI}) {
+        InputShaper shaper;
+        ASSERT_TRUE(shaper.configure(type, plantFrequency_ * 1.1, plantDamping_, period_));
+        EXPECT_LT(residualVibration(fast, &shaper), 0.25 * unshapedFast);
+    }
+}
+
+TEST_F(InputShaperTest, Performance) {
+    // 9轴插补，每轴一个 EI 整形器，测量每个插补周期的整形开销
+    const size_t axes = 9;
+    std::vector<InputShaper> shapers(axes);
+    for (size_t i = 0; i < axes; ++i) {
+        ASSERT_TRUE(shapers[i].configure(InputShaperType::EI, 30.0 + i, 0.05, period_));
+        shapers[i].reset(0.0);
+    }
+
+    const int ticks = 200000;
+    double checksum = 0.0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int n = 0; n < ticks; ++n) {
+        const double command = std::sin(n * 1e-3);
+        for (size_t i = 0; i < axes; ++i) {
+            checksum += shapers[i].process(command);
+        }
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now() - start);
+
+    EXPECT_TRUE(std::isfinite(checksum));
+    double perTick = static_cast<double>(duration.count()) / ticks;
+    EXPECT_LT(perTick, 20000.0);
+    std::cout << "InputShaper (9 axes, EI): " << perTick << " ns/tick" << std::endl;
+}
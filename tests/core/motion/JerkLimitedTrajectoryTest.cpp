@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include "xxcnc/motion/Axis.h"
+#include "xxcnc/motion/JerkLimitedTrajectory.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+
+using namespace xxcnc::motion;
+
+class JerkLimitedTrajectoryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        limits_.maxVelocity = 200.0;       // 最大速度 200mm/s
+        limits_.maxAcceleration = 1000.0;  // 最大加速度 1000mm/s²
+        limits_.maxJerk = 20000.0;         // 最大加加速度 20000mm/s³
+    }
+
+    /**
+     * @brief 逐周期采样轨迹，检查连续性和各项限制，返回终点状态
+     */
+    KinematicState checkTrajectory(const JerkLimitedTrajectory& trajectory, const KinematicState& start) {
+        const double dt = 1e-4;
+        const double tolerance = 1e-6;
+        KinematicState last = trajectory.sample(0.0);
+        EXPECT_NEAR(last.position, start.position, 1e-9);
+        EXPECT_NEAR(last.velocity, start.velocity, 1e-9);
+        EXPECT_NEAR(last.acceleration, start.acceleration, 1e-9);
+
+        // 初始加速度需要时间降到零，期间速度可能超出限制：上界为立即降加速度时到达的速度
+        const double initialSpeed = std::abs(start.velocity) +
+            std::max(0.0, start.acceleration * (start.velocity >= 0.0 ? 1.0 : -1.0)) *
+            std::abs(start.acceleration) / (2.0 * limits_.maxJerk);
+        const double initialAcceleration = std::abs(start.acceleration);
+        for (double t = dt; t < trajectory.getDuration() + 2 * dt; t += dt) {
+            KinematicState state = trajectory.sample(t);
+            EXPECT_LE(std::abs(state.velocity), std::max(limits_.maxVelocity, initialSpeed) + tolerance);
+            EXPECT_LE(std::abs(state.acceleration), std::max(limits_.maxAcceleration, initialAcceleration) + tolerance);
+            EXPECT_LE(std::abs(state.acceleration - last.acceleration), limits_.maxJerk * dt + tolerance);
+            EXPECT_LE(std::abs(state.position - last.position),
+                      std::max(std::abs(state.velocity), std::abs(last.velocity)) * dt + 1e-6);
+            last = state;
+        }
+        return last;
+    }
+
+    KinematicLimits limits_;
+};
+
+TEST_F(JerkLimitedTrajectoryTest, RestToRestReachesTargetExactly) {
+    for (double target : {0.0, 0.01, 1.0, 15.0, 100.0, -250.0}) {
+        JerkLimitedTrajectory trajectory;
+        KinematicState start;
+        ASSERT_TRUE(trajectory.plan(start, target, limits_));
+        KinematicState end = checkTrajectory(trajectory, start);
+        EXPECT_DOUBLE_EQ(end.position, target);
+        EXPECT_DOUBLE_EQ(end.velocity, 0.0);
+        EXPECT_DOUBLE_EQ(end.acceleration, 0.0);
+    }
+
+    // 长距离为七段 S 曲线：T = d/V + V/A + A/J
+    JerkLimitedTrajectory trajectory;
+    ASSERT_TRUE(trajectory.plan(KinematicState(), 100.0, limits_));
+    EXPECT_NEAR(trajectory.getDuration(), 100.0 / 200.0 + 200.0 / 1000.0 + 1000.0 / 20000.0, 1e-9);
+}
+
+TEST_F(JerkLimitedTrajectoryTest, ReplansFromArbitraryState) {
+    // 随机初始状态（包括速度方向背离目标、加速度不为零）均能从当前状态连续地到达目标
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> position(-50.0, 50.0);
+    std::uniform_real_distribution<double> velocity(-200.0, 200.0);
+    std::uniform_real_distribution<double> acceleration(-1000.0, 1000.0);
+    for (int i = 0; i < 200; ++i) {
+        KinematicState start;
+        start.position = position(rng);
+        start.velocity = velocity(rng);
+        start.acceleration = acceleration(rng);
+        double target = position(rng);
+
+        JerkLimitedTrajectory trajectory;
+        ASSERT_TRUE(trajectory.plan(start, target, limits_));
+        KinematicState end = checkTrajectory(trajectory, start);
+        EXPECT_DOUBLE_EQ(end.position, target);
+
+        // 终点前一刻已非常接近目标，终点没有跳变
+        KinematicState beforeEnd = trajectory.sample(trajectory.getDuration() - 1e-9);
+        EXPECT_NEAR(beforeEnd.position, target, 1e-7);
+        EXPECT_NEAR(beforeEnd.velocity, 0.0, 1e-3);
+    }
+
+    JerkLimitedTrajectory trajectory;
+    KinematicLimits invalid = limits_;
+    invalid.maxJerk = 0.0;
+    EXPECT_FALSE(trajectory.plan(KinematicState(), 10.0, invalid));
+}
+
+TEST_F(JerkLimitedTrajectoryTest, AxisMoveToRetargetsMidMove) {
+    AxisParameters params;
+    params.maxVelocity = 200.0;
+    params.maxAcceleration = 1000.0;
+    params.maxJerk = 20000.0;
+    params.homeVelocity = 10.0;
+    params.softLimitMin = -1000.0;
+    params.softLimitMax = 1000.0;
+    params.homePosition = 0.0;
+    Axis axis("X", params);
+    ASSERT_TRUE(axis.enable());
+    ASSERT_TRUE(axis.moveTo(100.0, 150.0));
+
+    const double dt = 0.001;
+    for (int i = 0; i < 200; ++i) {
+        axis.update(dt);
+    }
+    EXPECT_GT(axis.getCurrentVelocity(), 0.0);
+
+    // 运动中改变目标，从当前状态重新规划，加速度连续
+    double lastAcceleration = axis.getCurrentAcceleration();
+    ASSERT_TRUE(axis.moveTo(10.0, 150.0));
+    double maxVelocity = 0.0;
+    for (int i = 0; i < 5000 && axis.getState() == AxisState::MOVING; ++i) {
+        axis.update(dt);
+        EXPECT_LE(std::abs(axis.getCurrentAcceleration() - lastAcceleration), params.maxJerk * dt + 1e-6);
+        lastAcceleration = axis.getCurrentAcceleration();
+        maxVelocity = std::max(maxVelocity, std::abs(axis.getCurrentVelocity()));
+    }
+    EXPECT_EQ(axis.getState(), AxisState::IDLE);
+    EXPECT_DOUBLE_EQ(axis.getCurrentPosition(), 10.0);
+    EXPECT_DOUBLE_EQ(axis.getCurrentVelocity(), 0.0);
+    EXPECT_LE(maxVelocity, 150.0 + 1e-6);
+
+    // 速度运动同样受加加速度限制，并精确到达目标速度
+    ASSERT_TRUE(axis.moveVelocity(50.0));
+    lastAcceleration = 0.0;
+    for (int i = 0; i < 1000; ++i) {
+        axis.update(dt);
+        EXPECT_LE(std::abs(axis.getCurrentAcceleration() - lastAcceleration), params.maxJerk * dt + 1e-6);
+        lastAcceleration = axis.getCurrentAcceleration();
+    }
+    EXPECT_DOUBLE_EQ(axis.getCurrentVelocity(), 50.0);
+    EXPECT_DOUBLE_EQ(axis.getCurrentAcceleration(), 0.0);
+}
+
+// 性能测试
+TEST_F(JerkLimitedTrajectoryTest, Performance) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> value(-100.0, 100.0);
+    const int plans = 10000;
+    std::vector<KinematicState> starts(plans);
+    std::vector<double> targets(plans);
+    for (int i = 0; i < plans; ++i) {
+        starts[i].position = value(rng);
+        starts[i].velocity = value(rng);
+        starts[i].acceleration = value(rng) * 5.0;
+        targets[i] = value(rng);
+    }
+
+    JerkLimitedTrajectory trajectory;
+    double totalDuration = 0.0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < plans; ++i) {
+        trajectory.plan(starts[i], targets[i], limits_);
+        totalDuration += trajectory.getDuration();
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now() - start);
+
+    EXPECT_GT(totalDuration, 0.0);
+    double perPlan = static_cast<double>(duration.count()) / plans;
+    EXPECT_LT(perPlan, 100000.0);
+    std::cout << "JerkLimitedTrajectory::plan: " << perPlan << " ns/plan" << std::endl;
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include "xxcnc/motion/Kinematics.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace xxcnc::motion;
+
+class KinematicsTest : public ::testing::Test {
+protected:
+    /**
+     * @brief 按列存放的一批点
+     */
+    struct Batch {
+        Batch(size_t columns, size_t count) : data(columns, std::vector<double>(count)) {
+            for (auto& column : data) {
+                pointers.push_back(column.data());
+            }
+        }
+
+        const double* const* in() const { return pointers.data(); }
+        double* const* out() { return pointers.data(); }
+
+        std::vector<std::vector<double>> data;
+        std::vector<double*> pointers;
+    };
+
+    /**
+     * @brief 在给定范围内生成随机坐标
+     */
+    Batch randomCoordinates(size_t columns, size_t count, const std::vector<std::pair<double, double>>& ranges) {
+        Batch batch(columns, count);
+        std::mt19937 rng(11);
+        for (size_t c = 0; c < columns; ++c) {
+            std::uniform_real_distribution<double> value(ranges[c].first, ranges[c].second);
+            for (size_t i = 0; i < count; ++i) {
+                batch.data[c][i] = value(rng);
+            }
+        }
+        return batch;
+    }
+
+    /**
+     * @brief 逆变换再正变换，检查回到原坐标
+     */
+    void expectRoundTrip(const Kinematics& kinematics, const Batch& coordinates, double tolerance) {
+        const size_t count = coordinates.data[0].size();
+        Batch joints(kinematics.getJointCount(), count);
+        Batch back(kinematics.getCoordinateCount(), count);
+        ASSERT_TRUE(kinematics.inverse(coordinates.in(), joints.out(), count));
+        ASSERT_TRUE(kinematics.forward(joints.in(), back.out(), count));
+        for (size_t c = 0; c < kinematics.getCoordinateCount(); ++c) {
+            for (size_t i = 0; i < count; ++i) {
+                ASSERT_NEAR(back.data[c][i], coordinates.data[c][i], tolerance) << "coordinate " << c << ", point " << i;
+            }
+        }
+    }
+
+    /**
+     * @brief 测量批量逆变换吞吐量
+     */
+    void measureThroughput(const Kinematics& kinematics, const Batch& coordinates) {
+        const size_t count = coordinates.data[0].size();
+        Batch joints(kinematics.getJointCount(), count);
+        const int repeats = 20;
+        double checksum = 0.0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int r = 0; r < repeats; ++r) {
+            kinematics.inverse(coordinates.in(), joints.out(), count);
+            checksum += joints.data[0][r];
+        }
+        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::high_resolution_clock::now() - start);
+
+        EXPECT_TRUE(std::isfinite(checksum));
+        double perPoint = static_cast<double>(duration.count()) / (repeats * count);
+        EXPECT_LT(perPoint, 2000.0);
+        std::cout << kinematics.getName() << "::inverse: " << perPoint << " ns/point, "
+                  << 1000.0 / perPoint << " Mpoints/s" << std::endl;
+    }
+
+    const size_t kBenchmarkPoints = 100000;
+};
+
+TEST_F(KinematicsTest, CoreXYMapsMotorsToCartesian) {
+    CoreXYKinematics kinematics;
+    Batch coordinates(3, 1);
+    coordinates.data[0][0] = 10.0;
+    coordinates.data[1][0] = 4.0;
+    coordinates.data[2][0] = -2.0;
+    Batch joints(3, 1);
+    ASSERT_TRUE(kinematics.inverse(coordinates.in(), joints.out(), 1));
+    EXPECT_DOUBLE_EQ(joints.data[0][0], 14.0);
+    EXPECT_DOUBLE_EQ(joints.data[1][0], 6.0);
+    EXPECT_DOUBLE_EQ(joints.data[2][0], -2.0);
+
+    expectRoundTrip(kinematics, randomCoordinates(3, 1000, {{-200, 200}, {-200, 200}, {-50, 50}}), 1e-12);
+}
+
+TEST_F(KinematicsTest, DeltaRoundTripAndReach) {
+    DeltaKinematics kinematics(250.0, 120.0);
+
+    // 中心点三个滑块等高
+    Batch center(3, 1);
+    center.data[2][0] = 10.0;
+    Batch joints(3, 1);
+    ASSERT_TRUE(kinematics.inverse(center.in(), joints.out(), 1));
+    const double expected = 10.0 + std::sqrt(250.0 * 250.0 - 120.0 * 120.0);
+    for (size_t tower = 0; tower < 3; ++tower) {
+        EXPECT_NEAR(joints.data[tower][0], expected, 1e-9);
+    }
+
+    expectRoundTrip(kinematics, randomCoordinates(3, 1000, {{-80, 80}, {-80, 80}, {0, 200}}), 1e-9);
+
+    // 超出连杆长度的点不可达
+    Batch outside(3, 1);
+    outside.data[0][0] = 400.0;
+    EXPECT_FALSE(kinematics.inverse(outside.in(), joints.out(), 1));
+}
+
+TEST_F(KinematicsTest, TableTableKeepsToolTipOnWorkpiece) {
+    TableTableKinematics kinematics(0.0, 0.0, -100.0, 5.0, 20.0);
+
+    // 工件上位于 C 轴线上的点，转 C 时机床 XYZ 不变
+    Batch onAxis(5, 2);
+    onAxis.data[1][0] = onAxis.data[1][1] = 5.0;
+    onAxis.data[2][0] = onAxis.data[2][1] = 30.0;
+    onAxis.data[4][1] = 90.0;
+    Batch joints(5, 2);
+    ASSERT_TRUE(kinematics.inverse(onAxis.in(), joints.out(), 2));
+    for (size_t j = 0; j < 3; ++j) {
+        EXPECT_NEAR(joints.data[j][0], joints.data[j][1], 1e-9);
+    }
+
+    // A 转 90°：A 轴中心上方 130mm 的点转到 -Y 方向
+    Batch tilted(5, 1);
+    tilted.data[2][0] = 30.0;
+    tilted.data[3][0] = 90.0;
+    ASSERT_TRUE(kinematics.inverse(tilted.in(), joints.out(), 1));
+    EXPECT_NEAR(joints.data[0][0], 0.0, 1e-9);
+    EXPECT_NEAR(joints.data[1][0], -130.0, 1e-9);
+    EXPECT_NEAR(joints.data[2][0], -100.0, 1e-9);
+    EXPECT_DOUBLE_EQ(joints.data[3][0], 90.0);
+
+    expectRoundTrip(kinematics,
+                    randomCoordinates(5, 1000, {{-100, 100}, {-100, 100}, {-50, 50}, {-120, 120}, {-360, 360}}), 1e-9);
+}
+
+TEST_F(KinematicsTest, Performance) {
+    CoreXYKinematics coreXY;
+    measureThroughput(coreXY, randomCoordinates(3, kBenchmarkPoints, {{-200, 200}, {-200, 200}, {-50, 50}}));
+
+    DeltaKinematics delta(250.0, 120.0);
+    measureThroughput(delta, randomCoordinates(3, kBenchmarkPoints, {{-80, 80}, {-80, 80}, {0, 200}}));
+
+    TableTableKinematics tableTable(0.0, 0.0, -100.0, 5.0, 20.0);
+    measureThroughput(tableTable, randomCoordinates(5, kBenchmarkPoints,
+                                                    {{-100, 100}, {-100, 100}, {-50, 50}, {-120, 120}, {-360, 360}}));
+}
@@ -0,0 +1,394 @@
+#include <gtest/gtest.h>
+#include "xxcnc/motion/MotionController.h"
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+using namespace xxcnc::motion;
+
+class MotionControllerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        AxisParameters params;
+        params.maxVelocity = 500.0;       // 最大速度 500mm/s
+        params.maxAcceleration = 1000.0;  // 最大加速度 1000mm/s²
+        params.maxJerk = 5000.0;          // 最大加加速度 5000mm/s³
+        params.homeVelocity = 10.0;       // 回零速度 10mm/s
+        params.softLimitMin = -1000.0;    // 软限位最小值 -1000mm
+        params.softLimitMax = 1000.0;     // 软限位最大值 1000mm
+        params.homePosition = 0.0;
+        controller_.addAxis("X", params);
+        controller_.addAxis("Y", params);
+        controller_.addAxis("Z", params);
+        controller_.enableAllAxes();
+    }
+
+    double position(const std::string& name) {
+        return controller_.getAxis(name)->getCurrentPosition();
+    }
+
+    MotionController controller_;
+    const double dt_ = 0.001;
+};
+
+TEST_F(MotionControllerTest, FeedHoldStopsOnPathAndResumes) {
+    // 6000mm/min = 100mm/s，沿X方向直线运动
+    ASSERT_TRUE(controller_.moveLinear({{"X", 100.0}, {"Y", 0.0}, {"Z", 0.0}}, 6000.0));
+    ASSERT_TRUE(controller_.startMotion());
+
+    for (int i = 0; i < 200; ++i) {
+        controller_.update(dt_);
+    }
+    double holdStart = position("X");
+    EXPECT_GT(holdStart, 0.0);
+
+    // 请求进给保持，下一个周期开始减速
+    ASSERT_TRUE(controller_.feedHold());
+    controller_.update(dt_);
+    EXPECT_EQ(controller_.getMotionState(), MotionController::MotionState::Holding);
+    EXPECT_GE(controller_.getLastFeedHoldLatency().count(), 0);
+
+    // 减速过程中保持在路径上，且速度单调下降
+    double lastX = position("X");
+    double lastVelocity = 100.0;
+    for (int i = 0; i < 1000 && controller_.getMotionState() == MotionController::MotionState::Holding; ++i) {
+        controller_.update(dt_);
+        double velocity = (position("X") - lastX) / dt_;
+        EXPECT_LE(velocity, lastVelocity + 1e-6);
+        EXPECT_NEAR(position("Y"), 0.0, 1e-9);
+        EXPECT_NEAR(position("Z"), 0.0, 1e-9);
+        lastVelocity = velocity;
+        lastX = position("X");
+    }
+    ASSERT_EQ(controller_.getMotionState(), MotionController::MotionState::Held);
+
+    // 保持期间位置不变，剩余轨迹未丢失
+    double heldX = position("X");
+    EXPECT_GT(heldX, holdStart);
+    EXPECT_LT(heldX, 100.0);
+    for (int i = 0; i < 100; ++i) {
+        controller_.update(dt_);
+    }
+    EXPECT_DOUBLE_EQ(position("X"), heldX);
+    EXPECT_FALSE(controller_.isInterpolationFinished());
+
+    // 恢复后完成剩余轨迹
+    ASSERT_TRUE(controller_.resume());
+    for (int i = 0; i < 5000 && !controller_.isInterpolationFinished(); ++i) {
+        controller_.update(dt_);
+    }
+    EXPECT_TRUE(controller_.isInterpolationFinished());
+    EXPECT_NEAR(position("X"), 100.0, 1e-9);
+}
+
+TEST_F(MotionControllerTest, FeedHoldRejectedWhenIdle) {
+    EXPECT_FALSE(controller_.feedHold());
+    EXPECT_FALSE(controller_.resume());
+}
+
+TEST_F(MotionControllerTest, HoldEndsWhenPathRunsOut) {
+    // 剩余路径短于减速距离：队列在减速完成前执行完，运动结束时回到空闲
+    ASSERT_TRUE(controller_.moveLinear({{"X", 100.0}}, 6000.0));
+    ASSERT_TRUE(controller_.startMotion());
+    EXPECT_EQ(controller_.getMotionState(), MotionController::MotionState::Moving);
+    for (int i = 0; i < 5000 && position("X") < 99.0; ++i) {
+        controller_.update(dt_);
+    }
+    ASSERT_TRUE(controller_.feedHold());
+    for (int i = 0; i < 5000 && controller_.getSnapshot().moving; ++i) {
+        controller_.update(dt_);
+    }
+    EXPECT_FALSE(controller_.getSnapshot().moving);
+    EXPECT_EQ(controller_.getMotionState(), MotionController::MotionState::Idle);
+    EXPECT_EQ(controller_.getSnapshot().motionState, MotionController::MotionState::Idle);
+
+    // 新的运动可以再次进给保持
+    ASSERT_TRUE(controller_.moveLinear({{"X", 0.0}}, 6000.0));
+    ASSERT_TRUE(controller_.startMotion());
+    controller_.update(dt_);
+    EXPECT_TRUE(controller_.feedHold());
+}
+
+TEST_F(MotionControllerTest, CommandFailureReportsFault) {
+    // 越过软限位时控制循环只停止并上报故障，队列由命令线程清空
+    ASSERT_TRUE(controller_.moveLinear({{"X", 1500.0}}, 60000.0));
+    ASSERT_TRUE(controller_.startMotion());
+    for (int i = 0; i < 20000; ++i) {
+        controller_.update(dt_);
+        if (!controller_.getSnapshot().moving) {
+            break;
+        }
+    }
+    EXPECT_FALSE(controller_.getSnapshot().moving);
+    EXPECT_EQ(controller_.getSnapshot().motionState, MotionController::MotionState::Error);
+    EXPECT_GT(controller_.getInterpolationQueueSize(), 0u);
+
+    EXPECT_TRUE(controller_.serviceFault());
+    EXPECT_FALSE(controller_.serviceFault());
+    EXPECT_EQ(controller_.getInterpolationQueueSize(), 0u);
+    EXPECT_FALSE(controller_.startMotion());
+}
+
+TEST_F(MotionControllerTest, FollowPositionRejectsOverspeed) {
+    // 位置指令隐含的速度超过最大速度时与越过软限位一样进入错误状态
+    auto axis = controller_.getAxis("X");
+    ASSERT_TRUE(axis->followPosition(0.5, dt_));
+    ASSERT_TRUE(axis->followPosition(0.0, dt_));
+    EXPECT_FALSE(axis->followPosition(0.6, dt_));
+    EXPECT_EQ(axis->getState(), AxisState::ERROR);
+    EXPECT_DOUBLE_EQ(axis->getCurrentPosition(), 0.0);
+    EXPECT_DOUBLE_EQ(axis->getCurrentVelocity(), 0.0);
+}
+
+TEST_F(MotionControllerTest, AxisCommandsRunWithoutPath) {
+    // 未执行轨迹时轴的点到点运动也由控制周期推进
+    ASSERT_TRUE(controller_.getAxis("Z")->moveTo(5.0, 50.0));
+    for (int i = 0; i < 2000 && controller_.getAxis("Z")->getState() == AxisState::MOVING; ++i) {
+        controller_.update(dt_);
+    }
+    EXPECT_NEAR(position("Z"), 5.0, 1e-6);
+    EXPECT_EQ(controller_.getAxis("Z")->getState(), AxisState::IDLE);
+    EXPECT_NEAR(controller_.getSnapshot().positions[2], 5.0, 1e-6);
+}
+
+TEST_F(MotionControllerTest, MoveLinearAppendsContinuousPath) {
+    // 连续追加多段直线，每段以上一段终点为起点
+    ASSERT_TRUE(controller_.moveLinear({{"X", 10.0}}, 6000.0));
+    ASSERT_TRUE(controller_.moveLinear({{"Y", 10.0}}, 6000.0));
+    ASSERT_TRUE(controller_.moveLinear({{"X", 0.0}}, 6000.0));
+    EXPECT_EQ(controller_.getInterpolationQueueSize(), 3u);
+
+    ASSERT_TRUE(controller_.startMotion());
+    for (int i = 0; i < 100; ++i) {
+        controller_.update(dt_);
+    }
+
+    // 运动中继续追加
+    ASSERT_TRUE(controller_.moveLinear({{"Y", 0.0}}, 6000.0));
+
+    double maxX = 0.0;
+    double maxY = 0.0;
+    for (int i = 0; i < 5000 && !controller_.isInterpolationFinished(); ++i) {
+        controller_.update(dt_);
+        maxX = std::max(maxX, position("X"));
+        maxY = std::max(maxY, position("Y"));
+    }
+    EXPECT_TRUE(controller_.isInterpolationFinished());
+    EXPECT_NEAR(maxX, 10.0, 1e-9);
+    EXPECT_NEAR(maxY, 10.0, 1e-9);
+    EXPECT_NEAR(position("X"), 0.0, 1e-9);
+    EXPECT_NEAR(position("Y"), 0.0, 1e-9);
+    EXPECT_DOUBLE_EQ(controller_.getInterpolationProgress(), 1.0);
+}
+
+TEST_F(MotionControllerTest, MoveAfterClearStartsFromCurrentPosition) {
+    // 运动中清除轨迹后立即追加新段，新段应从实际位置开始，而不是被清除程序的终点
+    ASSERT_TRUE(controller_.moveLinear({{"X", 100.0}}, 6000.0));
+    ASSERT_TRUE(controller_.startMotion());
+    for (int i = 0; i < 100; ++i) {
+        controller_.update(dt_);
+    }
+    ASSERT_FALSE(controller_.isInterpolationFinished());
+    const double clearedX = position("X");
+    ASSERT_GT(clearedX, 0.0);
+    ASSERT_LT(clearedX, 50.0);
+
+    controller_.clearTrajectory();
+    ASSERT_TRUE(controller_.moveLinear({{"Y", 10.0}}, 6000.0));
+
+    // 每周期位移不超过最大速度
+    double lastX = position("X");
+    double lastY = position("Y");
+    for (int i = 0; i < 5000 && !controller_.isInterpolationFinished(); ++i) {
+        controller_.update(dt_);
+        EXPECT_LE(std::abs(position("X") - lastX), 500.0 * dt_ + 1e-9) << "tick " << i;
+        EXPECT_LE(std::abs(position("Y") - lastY), 500.0 * dt_ + 1e-9) << "tick " << i;
+        lastX = position("X");
+        lastY = position("Y");
+    }
+    EXPECT_TRUE(controller_.isInterpolationFinished());
+    EXPECT_NEAR(position("X"), clearedX, 1e-9);
+    EXPECT_NEAR(position("Y"), 10.0, 1e-9);
+}
+
+TEST_F(MotionControllerTest, AxesResolvedToIndicesAtConfiguration) {
+    EXPECT_EQ(controller_.getAxisCount(), 3u);
+    EXPECT_EQ(controller_.getAxisIndex("X"), 0);
+    EXPECT_EQ(controller_.getAxisIndex("Z"), 2);
+    EXPECT_EQ(controller_.getAxisIndex("A"), -1);
+    EXPECT_EQ(controller_.getAxisAt(1), controller_.getAxis("Y").get());
+    EXPECT_EQ(controller_.getAxisAt(3), nullptr);
+
+    // 按坐标的直线运动与按名称的版本等价
+    ASSERT_TRUE(controller_.moveLinear(xxcnc::core::motion::Point(5.0, -5.0, 1.0), 6000.0));
+    ASSERT_TRUE(controller_.startMotion());
+    for (int i = 0; i < 5000 && !controller_.isInterpolationFinished(); ++i) {
+        controller_.update(dt_);
+    }
+    EXPECT_NEAR(position("X"), 5.0, 1e-9);
+    EXPECT_NEAR(position("Y"), -5.0, 1e-9);
+    EXPECT_NEAR(position("Z"), 1.0, 1e-9);
+}
+
+TEST_F(MotionControllerTest, InputShapedAxisLagsAndSettlesOnTarget) {
+    EXPECT_FALSE(controller_.setInputShaper("A", InputShaperType::ZVD, 40.0, 0.1));
+    EXPECT_FALSE(controller_.setInputShaper("X", InputShaperType::ZVD, -40.0, 0.1));
+    ASSERT_TRUE(controller_.setInputShaper("X", InputShaperType::ZVD, 40.0, 0.1));
+    ASSERT_NE(controller_.getInputShaper("X"), nullptr);
+    EXPECT_EQ(controller_.getInputShaper("X")->getType(), InputShaperType::ZVD);
+    EXPECT_EQ(controller_.getInputShaper("Y")->getType(), InputShaperType::None);
+
+    // 对角直线运动：只有X轴整形，X滞后于Y，插补结束后继续运行直到整形输出到达终点
+    ASSERT_TRUE(controller_.moveLinear({{"X", 10.0}, {"Y", 10.0}}, 6000.0));
+    ASSERT_TRUE(controller_.startMotion());
+    EXPECT_FALSE(controller_.setInputShaper("X", InputShaperType::ZV, 40.0, 0.1));
+
+    int ticksAfterInterpolation = 0;
+    for (int i = 0; i < 5000; ++i) {
+        controller_.update(dt_);
+        EXPECT_LE(position("X"), position("Y") + 1e-9);
+        if (!controller_.getSnapshot().moving) {
+            break;
+        }
+        if (controller_.isInterpolationFinished()) {
+            ++ticksAfterInterpolation;
+        }
+    }
+
+    EXPECT_FALSE(controller_.getSnapshot().moving);
+    EXPECT_NEAR(position("X"), 10.0, 1e-9);
+    EXPECT_NEAR(position("Y"), 10.0, 1e-9);
+    EXPECT_NEAR(ticksAfterInterpolation * dt_, controller_.getInputShaper("X")->getDuration(), 3 * dt_);
+}
+
+TEST_F(MotionControllerTest, CoreXYKinematicsDrivesMotorAxes) {
+    AxisParameters params;
+    params.maxVelocity = 500.0;
+    params.maxAcceleration = 1000.0;
+    params.maxJerk = 5000.0;
+    params.softLimitMin = -1000.0;
+    params.softLimitMax = 1000.0;
+    ASSERT_TRUE(controller_.addAxis("A", params));
+    ASSERT_TRUE(controller_.addAxis("B", params));
+    controller_.enableAllAxes();
+
+    EXPECT_FALSE(controller_.setKinematics(std::make_shared<CoreXYKinematics>(), {"A", "B"}));
+    EXPECT_FALSE(controller_.setKinematics(std::make_shared<CoreXYKinematics>(), {"A", "B", "W"}));
+    ASSERT_TRUE(controller_.setKinematics(std::make_shared<CoreXYKinematics>(), {"A", "B", "Z"}));
+    EXPECT_EQ(controller_.getPathAxisCount(), 3u);
+
+    // 按笛卡尔坐标编程，电机 A = X + Y，B = X - Y
+    ASSERT_TRUE(controller_.moveLinear({{"X", 10.0}, {"Y", 5.0}}, 6000.0));
+    ASSERT_TRUE(controller_.startMotion());
+    for (int i = 0; i < 5000; ++i) {
+        controller_.update(dt_);
+        EXPECT_NEAR(position("A"), 3.0 * position("B"), 1e-9);
+        if (!controller_.getSnapshot().moving) {
+            break;
+        }
+    }
+    EXPECT_NEAR(position("A"), 15.0, 1e-9);
+    EXPECT_NEAR(position("B"), 5.0, 1e-9);
+    EXPECT_DOUBLE_EQ(position("X"), 0.0);
+
+    // 起点由电机位置正变换得到
+    ASSERT_TRUE(controller_.moveLinear({{"Y", 0.0}}, 6000.0));
+    ASSERT_TRUE(controller_.startMotion());
+    for (int i = 0; i < 5000; ++i) {
+        controller_.update(dt_);
+        if (!controller_.getSnapshot().moving) {
+            break;
+        }
+    }
+    EXPECT_NEAR(position("A"), 10.0, 1e-9);
+    EXPECT_NEAR(position("B"), 10.0, 1e-9);
+
+    ASSERT_TRUE(controller_.setKinematics(nullptr));
+    EXPECT_EQ(controller_.getPathAxisCount(), 5u);
+}
+
+TEST_F(MotionControllerTest, RotaryAxesSelectWiderInterpolator) {
+    EXPECT_EQ(controller_.getPathAxisCount(), 3u);
+
+    AxisParameters params;
+    params.maxVelocity = 500.0;
+    params.maxAcceleration = 1000.0;
+    params.maxJerk = 5000.0;
+    params.softLimitMin = -1000.0;
+    params.softLimitMax = 1000.0;
+    controller_.setCoarseInterpolationPeriod(2);
+    ASSERT_TRUE(controller_.addAxis("A", params));
+    ASSERT_TRUE(controller_.addAxis("B", params));
+    controller_.enableAllAxes();
+
+    // 附加轴按添加顺序扩展插补坐标，插补周期设置保留
+    EXPECT_EQ(controller_.getPathAxisCount(), 5u);
+    EXPECT_EQ(controller_.getCoarseInterpolationPeriod(), 2);
+
+    // X 与 A/B 联动，同时到达终点
+    ASSERT_TRUE(controller_.moveLinear({{"X", 10.0}, {"A", 90.0}, {"B", -45.0}}, 6000.0));
+    ASSERT_TRUE(controller_.startMotion());
+    for (int i = 0; i < 5000 && !controller_.isInterpolationFinished(); ++i) {
+        controller_.update(dt_);
+        EXPECT_NEAR(position("A"), position("X") * 9.0, 1e-6);
+        EXPECT_NEAR(position("B"), position("X") * -4.5, 1e-6);
+    }
+    EXPECT_TRUE(controller_.isInterpolationFinished());
+    EXPECT_NEAR(position("X"), 10.0, 1e-9);
+    EXPECT_NEAR(position("A"), 90.0, 1e-9);
+    EXPECT_NEAR(position("B"), -45.0, 1e-9);
+}
+
+TEST_F(MotionControllerTest, SnapshotIsConsistentAcrossAxes) {
+    // 沿 X=Y 对角线运动，各周期快照中两轴位置必须相等
+    ASSERT_TRUE(controller_.moveLinear(xxcnc::core::motion::Point(50.0, 50.0, 0.0), 6000.0, 7));
+    ASSERT_TRUE(controller_.moveLinear(xxcnc::core::motion::Point(0.0, 0.0, 0.0), 6000.0, 8));
+
+    MotionController::Snapshot initial = controller_.getSnapshot();
+    EXPECT_EQ(initial.axisCount, 3u);
+    EXPECT_EQ(initial.lineNumber, 0);
+
+    ASSERT_TRUE(controller_.startMotion());
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::atomic<int> reads{0};
+    std::thread reader([&]() {
+        uint64_t lastTick = 0;
+        while (!done.load()) {
+            MotionController::Snapshot snapshot = controller_.getSnapshot();
+            if (snapshot.positions[0] != snapshot.positions[1] || snapshot.tick < lastTick) {
+                ++torn;
+            }
+            lastTick = snapshot.tick;
+            ++reads;
+        }
+    });
+
+    while (reads.load() == 0) {
+        std::this_thread::yield();
+    }
+
+    bool sawFirstLine = false;
+    bool sawSecondLine = false;
+    for (int i = 0; i < 5000 && !controller_.isInterpolationFinished(); ++i) {
+        controller_.update(dt_);
+        MotionController::Snapshot snapshot = controller_.getSnapshot();
+        sawFirstLine = sawFirstLine || snapshot.lineNumber == 7;
+        sawSecondLine = sawSecondLine || snapshot.lineNumber == 8;
+        EXPECT_DOUBLE_EQ(snapshot.positions[0], position("X"));
+        EXPECT_EQ(snapshot.axisStates[0], controller_.getAxis("X")->getState());
+        EXPECT_DOUBLE_EQ(snapshot.progress, controller_.getInterpolationProgress());
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_GT(reads.load(), 0);
+    EXPECT_TRUE(sawFirstLine);
+    EXPECT_TRUE(sawSecondLine);
+
+    MotionController::Snapshot last = controller_.getSnapshot();
+    EXPECT_TRUE(last.interpolationFinished);
+    EXPECT_DOUBLE_EQ(last.progress, 1.0);
+    EXPECT_NEAR(last.positions[0], 0.0, 1e-9);
+}
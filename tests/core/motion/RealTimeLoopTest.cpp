@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "xxcnc/motion/RealTimeLoop.h"
+#include <chrono>
+#include <numeric>
+#include <thread>
+
+using namespace xxcnc::motion;
+
+class RealTimeLoopTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        AxisParameters params;
+        params.maxVelocity = 500.0;
+        params.maxAcceleration = 1000.0;
+        params.maxJerk = 5000.0;
+        params.homeVelocity = 10.0;
+        params.softLimitMin = -1000.0;
+        params.softLimitMax = 1000.0;
+        params.homePosition = 0.0;
+        controller_ = std::make_shared<MotionController>();
+        controller_->addAxis("X", params);
+        controller_->addAxis("Y", params);
+        controller_->addAxis("Z", params);
+        controller_->enableAllAxes();
+    }
+
+    std::shared_ptr<MotionController> controller_;
+};
+
+TEST_F(RealTimeLoopTest, DrivesMotionControllerAtInterpolationPeriod) {
+    RealTimeLoop loop(controller_);
+    ASSERT_TRUE(loop.start());
+    EXPECT_TRUE(loop.isRunning());
+    EXPECT_FALSE(loop.start());
+
+    // 6000mm/min = 100mm/s，10mm 直线约 0.11s 完成
+    ASSERT_TRUE(controller_->moveLinear({{"X", 10.0}}, 6000.0));
+    ASSERT_TRUE(controller_->startMotion());
+    for (int i = 0; i < 200 && !controller_->isInterpolationFinished(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    loop.stop();
+    EXPECT_FALSE(loop.isRunning());
+
+    EXPECT_TRUE(controller_->isInterpolationFinished());
+    EXPECT_NEAR(controller_->getAxis("X")->getCurrentPosition(), 10.0, 1e-9);
+
+    // 直方图计数之和等于周期数
+    RealTimeLoop::Statistics stats = loop.getStatistics();
+    EXPECT_GT(stats.cycles, 100u);
+    uint64_t histogramTotal = std::accumulate(stats.jitterHistogram.begin(), stats.jitterHistogram.end(), uint64_t(0));
+    EXPECT_EQ(histogramTotal, stats.cycles);
+    EXPECT_GE(stats.maxJitterNs, 0);
+
+    loop.resetStatistics();
+    EXPECT_EQ(loop.getStatistics().cycles, 0u);
+}
+
+TEST_F(RealTimeLoopTest, HistogramBucketBounds) {
+    EXPECT_EQ(RealTimeLoop::bucketUpperBoundUs(0), 1);
+    EXPECT_EQ(RealTimeLoop::bucketUpperBoundUs(1), 2);
+    EXPECT_EQ(RealTimeLoop::bucketUpperBoundUs(10), 1024);
+    EXPECT_EQ(RealTimeLoop::bucketUpperBoundUs(RealTimeLoop::kJitterBuckets - 1), -1);
+}
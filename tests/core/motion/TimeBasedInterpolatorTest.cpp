@@ -0,0 +1,227 @@
+#include <gtest/gtest.h>
+#include "xxcnc/core/motion/TimeBasedInterpolator.h"
+#include <chrono>
+#include <iostream>
+
+namespace xxcnc::core::motion::test {
+
+class TimeBasedInterpolatorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        interpolator = std::make_unique<TimeBasedInterpolator>(1);
+        // 6000mm/min = 100mm/s
+        params = InterpolationEngine::InterpolationParams(6000.0, 500.0, 1000.0, 1000.0, 5000.0);
+    }
+
+    std::unique_ptr<TimeBasedInterpolator> interpolator;
+    InterpolationEngine::InterpolationParams params;
+    const double dt = 0.001;
+};
+
+// 追加语义测试
+TEST_F(TimeBasedInterpolatorTest, AppendKeepsQueuedSegments) {
+    ASSERT_TRUE(interpolator->planLinearPath({0.0, 0.0, 0.0}, {10.0, 0.0, 0.0}, params));
+    ASSERT_TRUE(interpolator->appendLinear({10.0, 10.0, 0.0}, params));
+    ASSERT_TRUE(interpolator->appendCircular({20.0, 10.0, 0.0}, {15.0, 10.0, 0.0}, true, params));
+    EXPECT_EQ(interpolator->getQueueSize(), 3u);
+
+    Point tail = interpolator->getTailPosition();
+    EXPECT_DOUBLE_EQ(tail.x, 20.0);
+    EXPECT_DOUBLE_EQ(tail.y, 10.0);
+
+    // 依次执行所有段，相邻插补点距离不超过一个周期的进给量
+    Point last(0.0, 0.0, 0.0);
+    Point point;
+    while (interpolator->getNextPoint(point) && !interpolator->isFinished()) {
+        double step = std::hypot(point.x - last.x, point.y - last.y);
+        EXPECT_LE(step, 100.0 * dt + 1e-9);
+        last = point;
+    }
+    EXPECT_NEAR(point.x, 20.0, 1e-9);
+    EXPECT_NEAR(point.y, 10.0, 1e-9);
+    EXPECT_EQ(interpolator->getQueueSize(), 0u);
+    EXPECT_DOUBLE_EQ(interpolator->getProgress(), 1.0);
+}
+
+TEST_F(TimeBasedInterpolatorTest, ClearQueueDropsAllSegments) {
+    ASSERT_TRUE(interpolator->planLinearPath({0.0, 0.0, 0.0}, {10.0, 0.0, 0.0}, params));
+    ASSERT_TRUE(interpolator->appendLinear({20.0, 0.0, 0.0}, params));
+
+    Point point;
+    ASSERT_TRUE(interpolator->getNextPoint(point));
+    interpolator->clearQueue();
+    EXPECT_EQ(interpolator->getQueueSize(), 0u);
+    EXPECT_TRUE(interpolator->isFinished());
+    EXPECT_FALSE(interpolator->getNextPoint(point));
+}
+
+// 段间速度衔接测试
+TEST_F(TimeBasedInterpolatorTest, CollinearSegmentsBlendWithoutStopping) {
+    // 两段共线直线，拐角速度不受限，段间不应减速
+    ASSERT_TRUE(interpolator->planLinearPath({0.0, 0.0, 0.0}, {20.0, 0.0, 0.0}, params));
+    ASSERT_TRUE(interpolator->appendLinear({40.0, 0.0, 0.0}, params));
+
+    Point last(0.0, 0.0, 0.0);
+    Point point;
+    double velocityAtJoint = 0.0;
+    while (interpolator->getNextPoint(point) && !interpolator->isFinished()) {
+        double velocity = (point.x - last.x) / dt;
+        EXPECT_LE(velocity, 100.0 + 1e-6);
+        if (last.x < 20.0 && point.x >= 20.0) {
+            velocityAtJoint = velocity;
+        }
+        last = point;
+    }
+    EXPECT_NEAR(velocityAtJoint, 100.0, 1e-6);
+    EXPECT_NEAR(point.x, 40.0, 1e-9);
+}
+
+// 两级插补测试
+TEST_F(TimeBasedInterpolatorTest, FineInterpolationIsSmoothBetweenCoarseKnots) {
+    // 整圆匀速段内，精插补点应位于圆上且加速度接近向心加速度 v^2/r
+    interpolator->setCoarsePeriod(10);
+    ASSERT_TRUE(interpolator->planCircularPath({10.0, 0.0, 0.0}, {-10.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, false, params));
+
+    std::vector<Point> points;
+    Point point;
+    while (interpolator->getNextPoint(point) && !interpolator->isFinished()) {
+        points.push_back(point);
+    }
+
+    const double centripetal = 100.0 * 100.0 / 10.0;
+    int checked = 0;
+    for (size_t i = 1; i + 1 < points.size(); ++i) {
+        EXPECT_NEAR(std::hypot(points[i].x, points[i].y), 10.0, 1e-6);
+
+        // 只检查匀速段（相邻步长均为一个周期的进给量）
+        double step0 = std::hypot(points[i].x - points[i - 1].x, points[i].y - points[i - 1].y);
+        double step1 = std::hypot(points[i + 1].x - points[i].x, points[i + 1].y - points[i].y);
+        if (std::abs(step0 - 0.1) > 1e-6 || std::abs(step1 - 0.1) > 1e-6) {
+            continue;
+        }
+        double ax = (points[i + 1].x - 2.0 * points[i].x + points[i - 1].x) / (dt * dt);
+        double ay = (points[i + 1].y - 2.0 * points[i].y + points[i - 1].y) / (dt * dt);
+        EXPECT_NEAR(std::hypot(ax, ay), centripetal, centripetal * 0.01);
+        ++checked;
+    }
+    EXPECT_GT(checked, 100);
+}
+
+TEST_F(TimeBasedInterpolatorTest, CoarsePeriodDoesNotChangePath) {
+    for (int coarsePeriod : {1, 4, 10}) {
+        TimeBasedInterpolator local(1, coarsePeriod);
+        EXPECT_EQ(local.getCoarsePeriod(), coarsePeriod);
+        ASSERT_TRUE(local.planLinearPath({0.0, 0.0, 0.0}, {10.0, 0.0, 0.0}, params));
+        ASSERT_TRUE(local.appendLinear({10.0, 10.0, 0.0}, params));
+
+        // 直线段上的精插补点不偏离路径，终点准确
+        Point point;
+        double maxDeviation = 0.0;
+        while (local.getNextPoint(point) && !local.isFinished()) {
+            maxDeviation = std::max(maxDeviation, std::min(std::abs(point.y), std::abs(point.x - 10.0)));
+        }
+        EXPECT_LT(maxDeviation, 1e-9);
+        EXPECT_NEAR(point.x, 10.0, 1e-9);
+        EXPECT_NEAR(point.y, 10.0, 1e-9);
+    }
+    EXPECT_THROW(interpolator->setCoarsePeriod(0), std::invalid_argument);
+}
+
+// 多轴联动插补测试
+TEST_F(TimeBasedInterpolatorTest, FiveAxisPathInterpolatesAllAxes) {
+    using Point5 = PointN<5>;
+    BasicTimeBasedInterpolator<5> local(1);
+
+    // 直线段五轴同步到达终点，各轴位移与路径长度成比例
+    Point5 end;
+    end[0] = 3.0;
+    end[1] = 4.0;
+    end[3] = 12.0;
+    ASSERT_TRUE(local.planLinearPath(Point5(), end, params));
+    EXPECT_NEAR(local.getTailPosition()[3], 12.0, 1e-12);
+
+    // 圆弧段 XY 走圆弧，其余轴线性插补
+    Point5 arcEnd = end;
+    arcEnd[0] = -3.0;
+    arcEnd[1] = -4.0;
+    arcEnd[4] = 20.0;
+    ASSERT_TRUE(local.appendCircular(arcEnd, Point5(), false, params));
+
+    Point5 point;
+    size_t ticks = 0;
+    while (local.getNextPoint(point) && !local.isFinished()) {
+        if (std::abs(point[4]) < 1e-12) {
+            // 直线段：A 轴与 X 轴成比例
+            EXPECT_NEAR(point[3], point[0] * 4.0, 1e-9);
+        } else {
+            // 圆弧段：XY 保持在半径5的圆上
+            EXPECT_NEAR(std::hypot(point[0], point[1]), 5.0, 1e-6);
+        }
+        EXPECT_DOUBLE_EQ(point[2], 0.0);
+        ++ticks;
+    }
+    EXPECT_GT(ticks, 0u);
+    EXPECT_NEAR(point[0], -3.0, 1e-9);
+    EXPECT_NEAR(point[1], -4.0, 1e-9);
+    EXPECT_NEAR(point[3], 12.0, 1e-9);
+    EXPECT_NEAR(point[4], 20.0, 1e-9);
+}
+
+// 进给保持加减速限制测试
+TEST_F(TimeBasedInterpolatorTest, FeedHoldRespectsAccelerationLimit) {
+    ASSERT_TRUE(interpolator->planLinearPath({0.0, 0.0, 0.0}, {100.0, 0.0, 0.0}, params));
+
+    Point point;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(interpolator->getNextPoint(point));
+    }
+
+    // 由时间缩放系数推算路径速度，检查加速度和加加速度限制
+    const double nominalSpeed = 100.0;
+    interpolator->beginFeedHold();
+    double lastScale = interpolator->getTimeScale();
+    double lastAcceleration = 0.0;
+    while (interpolator->getFeedHoldState() == TimeBasedInterpolator::FeedHoldState::Decelerating) {
+        ASSERT_TRUE(interpolator->getNextPoint(point));
+        double scale = interpolator->getTimeScale();
+        double acceleration = (scale - lastScale) * nominalSpeed / dt;
+        EXPECT_LE(scale, lastScale);
+        EXPECT_LE(std::abs(acceleration), params.deceleration * 1.01);
+        EXPECT_LE(std::abs(acceleration - lastAcceleration) / dt, params.jerk * 1.01);
+        lastScale = scale;
+        lastAcceleration = acceleration;
+    }
+    EXPECT_EQ(interpolator->getFeedHoldState(), TimeBasedInterpolator::FeedHoldState::Held);
+    EXPECT_DOUBLE_EQ(interpolator->getTimeScale(), 0.0);
+}
+
+// 性能测试
+TEST_F(TimeBasedInterpolatorTest, Performance) {
+    // 不同粗插补周期下每个伺服周期的平均耗时
+    for (int coarsePeriod : {1, 4, 10}) {
+        TimeBasedInterpolator local(1, coarsePeriod);
+        for (int i = 0; i < 200; ++i) {
+            double x = (i % 2 == 0) ? 10.0 : 0.0;
+            ASSERT_TRUE(local.appendLinear({x, static_cast<double>(i), 0.0}, params));
+            ASSERT_TRUE(local.appendCircular({x, static_cast<double>(i) + 1.0, 0.0},
+                                             {x, static_cast<double>(i) + 0.5, 0.0}, i % 2 == 0, params));
+        }
+
+        Point point;
+        size_t ticks = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        while (local.getNextPoint(point) && !local.isFinished()) {
+            ++ticks;
+        }
+        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::high_resolution_clock::now() - start);
+
+        ASSERT_GT(ticks, 0u);
+        double perTick = static_cast<double>(duration.count()) / static_cast<double>(ticks);
+        EXPECT_LT(perTick, 100000.0);
+        std::cout << "Coarse period " << coarsePeriod << "ms: " << ticks << " ticks, "
+                  << perTick << " ns/tick" << std::endl;
+    }
+}
+
+} // namespace xxcnc::core::motion::test
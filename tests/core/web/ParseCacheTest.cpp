@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+#include "xxcnc/core/web/ParseCache.h"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace xxcnc::web;
+
+class ParseCacheTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        for (const auto& path : files_) {
+            std::filesystem::remove(path);
+        }
+    }
+
+    std::filesystem::path writeFile(const std::string& name, const std::string& content) {
+        std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+        std::ofstream(path, std::ios::binary) << content;
+        files_.push_back(path);
+        return path;
+    }
+
+    // 解析函数：每行一个轨迹点，记录调用次数
+    ParseCache::Loader loader(const std::filesystem::path& path, size_t lines = 1) {
+        return [this, path, lines](FileParseResponse& response) {
+            ++loads_;
+            response.success = std::filesystem::exists(path);
+            response.toolPathDetails.assign(lines, "G01 X1 Y2");
+            response.trajectoryPoints.resize(lines);
+            return true;
+        };
+    }
+
+    std::vector<std::filesystem::path> files_;
+    std::atomic<int> loads_{0};
+};
+
+TEST_F(ParseCacheTest, CachesUntilFileChanges) {
+    ParseCache cache;
+    const auto path = writeFile("xxcnc_parse_cache_test.nc", "G01 X1\n");
+
+    auto first = cache.get(path, loader(path));
+    ASSERT_TRUE(first->success);
+    EXPECT_EQ(cache.get(path, loader(path)), first);
+    EXPECT_EQ(loads_, 1);
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(cache.getHitCount(), 1u);
+    EXPECT_EQ(cache.getMemoryUsage(), ParseCache::estimateSize(*first));
+
+    // 文件大小变化后重新解析
+    writeFile("xxcnc_parse_cache_test.nc", "G01 X1\nG01 X2\n");
+    auto second = cache.get(path, loader(path, 2));
+    EXPECT_NE(second, first);
+    EXPECT_EQ(second->trajectoryPoints.size(), 2u);
+    EXPECT_EQ(loads_, 2);
+    EXPECT_EQ(cache.size(), 1u);
+
+    // 显式移除后重新解析
+    cache.erase(path);
+    EXPECT_EQ(cache.size(), 0u);
+    cache.get(path, loader(path));
+    EXPECT_EQ(loads_, 3);
+
+    // 无法读取的文件和失败的结果不缓存
+    const auto missing = std::filesystem::temp_directory_path() / "xxcnc_parse_cache_missing.nc";
+    EXPECT_FALSE(cache.get(missing, loader(missing))->success);
+    EXPECT_FALSE(cache.get(missing, loader(missing))->success);
+    EXPECT_EQ(loads_, 5);
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST_F(ParseCacheTest, ConcurrentRequestsParseOnce) {
+    ParseCache cache;
+    const auto path = writeFile("xxcnc_parse_cache_flight.nc", "G01 X1\n");
+    auto slowLoader = [this, path](FileParseResponse& response) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        return loader(path)(response);
+    };
+
+    std::vector<std::shared_ptr<const FileParseResponse>> results(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < results.size(); ++i) {
+        threads.emplace_back([&, i]() { results[i] = cache.get(path, slowLoader); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(loads_, 1);
+    EXPECT_EQ(cache.getLoadCount(), 1u);
+    EXPECT_EQ(cache.getHitCount(), 7u);
+    for (const auto& result : results) {
+        EXPECT_EQ(result, results.front());
+    }
+}
+
+TEST_F(ParseCacheTest, CancelledLoadIsRetriedByWaiters) {
+    ParseCache cache;
+    const auto path = writeFile("xxcnc_parse_cache_cancel.nc", "G01 X1\n");
+
+    // 第一个请求开始解析后被自身中止，等待中的请求不能拿到中止的结果
+    std::promise<void> started;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    auto cancelledLoader = [&](FileParseResponse& response) {
+        started.set_value();
+        released.wait();
+        response.error = "已取消";
+        return false;
+    };
+
+    std::shared_ptr<const FileParseResponse> cancelled;
+    std::thread leader([&]() { cancelled = cache.get(path, cancelledLoader); });
+    started.get_future().wait();
+
+    std::vector<std::shared_ptr<const FileParseResponse>> results(4);
+    std::vector<std::thread> waiters;
+    for (size_t i = 0; i < results.size(); ++i) {
+        waiters.emplace_back([&, i]() { results[i] = cache.get(path, loader(path)); });
+    }
+    // 等待请求合并到进行中的解析后再中止
+    while (cache.getHitCount() < results.size()) {
+        std::this_thread::yield();
+    }
+    release.set_value();
+    leader.join();
+    for (auto& waiter : waiters) {
+        waiter.join();
+    }
+
+    ASSERT_NE(cancelled, nullptr);
+    EXPECT_FALSE(cancelled->success);
+    // 一个等待的请求接替解析，其余请求共享它的结果
+    EXPECT_EQ(loads_, 1);
+    EXPECT_EQ(cache.getLoadCount(), 2u);
+    for (const auto& result : results) {
+        ASSERT_NE(result, nullptr);
+        EXPECT_TRUE(result->success);
+        EXPECT_EQ(result, results.front());
+    }
+    EXPECT_EQ(cache.get(path, loader(path)), results.front());
+    EXPECT_EQ(loads_, 1);
+}
+
+TEST_F(ParseCacheTest, EraseDropsInFlightResult) {
+    ParseCache cache;
+    const auto path = writeFile("xxcnc_parse_cache_erase.nc", "G01 X1\n");
+
+    // 解析期间文件被覆盖（修改时间和大小可能不变），旧内容的结果不能写入缓存
+    std::promise<void> started;
+    std::promise<void> release;
+    auto slowLoader = [&](FileParseResponse& response) {
+        started.set_value();
+        release.get_future().wait();
+        return loader(path)(response);
+    };
+    std::shared_ptr<const FileParseResponse> stale;
+    std::thread leader([&]() { stale = cache.get(path, slowLoader); });
+    started.get_future().wait();
+    cache.erase(path);
+    release.set_value();
+    leader.join();
+
+    ASSERT_NE(stale, nullptr);
+    EXPECT_TRUE(stale->success);
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_NE(cache.get(path, loader(path)), stale);
+    EXPECT_EQ(loads_, 2);
+}
+
+TEST_F(ParseCacheTest, EvictsLeastRecentlyUsedWithinBudget) {
+    // 预算只够两个结果
+    FileParseResponse sample;
+    sample.success = true;
+    sample.toolPathDetails.assign(100, "G01 X1 Y2");
+    sample.trajectoryPoints.resize(100);
+    ParseCache cache(ParseCache::estimateSize(sample) * 5 / 2);
+
+    const auto a = writeFile("xxcnc_parse_cache_a.nc", "A");
+    const auto b = writeFile("xxcnc_parse_cache_b.nc", "B");
+    const auto c = writeFile("xxcnc_parse_cache_c.nc", "C");
+    cache.get(a, loader(a, 100));
+    cache.get(b, loader(b, 100));
+    cache.get(a, loader(a, 100));
+    cache.get(c, loader(c, 100));
+    EXPECT_EQ(loads_, 3);
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_LE(cache.getMemoryUsage(), ParseCache::estimateSize(sample) * 5 / 2);
+
+    // b 最久未使用，已被淘汰
+    cache.get(a, loader(a, 100));
+    cache.get(c, loader(c, 100));
+    EXPECT_EQ(loads_, 3);
+    cache.get(b, loader(b, 100));
+    EXPECT_EQ(loads_, 4);
+
+    // 超过预算的结果不缓存
+    const auto large = writeFile("xxcnc_parse_cache_large.nc", "L");
+    EXPECT_TRUE(cache.get(large, loader(large, 1000))->success);
+    cache.get(large, loader(large, 1000));
+    EXPECT_EQ(loads_, 6);
+}
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include "xxcnc/core/web/RealWebAPI.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace xxcnc::web;
+using json = nlohmann::json;
+
+class RealWebAPITest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::filesystem::create_directories(std::filesystem::current_path() / "uploads");
+    }
+
+    void TearDown() override {
+        for (const std::string& filename : files_) {
+            std::filesystem::remove(std::filesystem::current_path() / "uploads" / filename);
+        }
+    }
+
+    // 在上传目录中生成一个每行一段直线的加工文件
+    std::string writeProgram(const std::string& filename, int lines) {
+        std::ofstream file(std::filesystem::current_path() / "uploads" / filename);
+        for (int i = 0; i < lines; ++i) {
+            file << "G01 X" << (i % 100) * 0.1 << " Y" << (i % 50) * 0.1 << " Z0\n";
+        }
+        files_.push_back(filename);
+        return filename;
+    }
+
+    // 等待作业结束准备阶段
+    static StatusResponse waitForJob(RealWebAPI& api) {
+        StatusResponse status;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+        while (std::chrono::steady_clock::now() < deadline) {
+            api.getChannelStatus(0, status);
+            if (status.job.phase != "parsing" && status.job.phase != "planning") {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return status;
+    }
+
+    std::vector<std::string> files_;
+};
+
+TEST_F(RealWebAPITest, StartReturnsJobAndPlansInBackground) {
+    RealWebAPI api(1, 1024);
+    const std::string filename = writeProgram("job_plan_test.nc", 2000);
+
+    json result;
+    ASSERT_TRUE(api.executeCommandWithResult({{"command", "motion.start"}, {"filename", filename}}, result));
+    EXPECT_EQ(result["jobId"], 1u);
+
+    const StatusResponse status = waitForJob(api);
+    EXPECT_EQ(status.job.id, 1u);
+    EXPECT_TRUE(status.job.phase == "running" || status.job.phase == "completed") << status.job.phase;
+    EXPECT_EQ(status.job.file, filename);
+    EXPECT_EQ(status.job.parsedLines, 2000u);
+    EXPECT_EQ(status.job.totalSegments, 2000u);
+    EXPECT_EQ(status.job.plannedSegments, 2000u);
+    EXPECT_TRUE(status.job.error.empty());
+
+    // 停止后作业标记为已取消，编号不变
+    ASSERT_TRUE(api.executeCommand({{"command", "motion.stop"}}));
+    StatusResponse stopped;
+    api.getChannelStatus(0, stopped);
+    EXPECT_EQ(stopped.status, "idle");
+    EXPECT_EQ(stopped.job.id, 1u);
+}
+
+TEST_F(RealWebAPITest, CancelDuringPreparation) {
+    RealWebAPI api(1, 1024);
+    const std::string filename = writeProgram("job_cancel_test.nc", 200000);
+
+    json result;
+    ASSERT_TRUE(api.executeCommandWithResult({{"command", "motion.start"}, {"filename", filename}}, result));
+    const uint64_t jobId = result["jobId"].get<uint64_t>();
+
+    // 准备期间不接受新的作业，也不接受编号不符的取消请求
+    json busy;
+    EXPECT_FALSE(api.executeCommandWithResult({{"command", "motion.start"}, {"filename", filename}}, busy));
+    EXPECT_EQ(busy["jobId"], jobId);
+    EXPECT_FALSE(api.executeCommand({{"command", "job.cancel"}, {"jobId", jobId + 1}}));
+    ASSERT_TRUE(api.executeCommand({{"command", "job.cancel"}, {"jobId", jobId}}));
+
+    const StatusResponse status = waitForJob(api);
+    EXPECT_EQ(status.job.phase, "cancelled");
+    EXPECT_EQ(status.status, "idle");
+    EXPECT_LT(status.job.plannedSegments, 200000u);
+
+    // 取消后可以提交新的作业
+    json next;
+    ASSERT_TRUE(api.executeCommandWithResult({{"command", "motion.start"}, {"filename", writeProgram("job_next_test.nc", 10)}},
+                                             next));
+    EXPECT_EQ(next["jobId"], jobId + 1);
+    EXPECT_EQ(waitForJob(api).job.plannedSegments, 10u);
+}
+
+TEST_F(RealWebAPITest, StartReplacesRunningJob) {
+    RealWebAPI api(1, 1024);
+
+    json first;
+    ASSERT_TRUE(api.executeCommandWithResult({{"command", "motion.start"}, {"filename", writeProgram("job_replaced_test.nc", 20000)}},
+                                             first));
+    ASSERT_EQ(waitForJob(api).job.phase, "running");
+
+    // 运行中提交新的作业：旧作业被取消，新作业正常开始运行
+    json second;
+    ASSERT_TRUE(api.executeCommandWithResult({{"command", "motion.start"}, {"filename", writeProgram("job_replacing_test.nc", 20000)}},
+                                             second));
+    EXPECT_EQ(second["jobId"], first["jobId"].get<uint64_t>() + 1);
+    const StatusResponse status = waitForJob(api);
+    EXPECT_EQ(status.job.id, second["jobId"].get<uint64_t>());
+    EXPECT_EQ(status.job.phase, "running") << status.job.error;
+    EXPECT_TRUE(status.job.error.empty());
+    EXPECT_EQ(status.status, "machining");
+
+    ASSERT_TRUE(api.executeCommand({{"command", "motion.stop"}}));
+}
+
+TEST_F(RealWebAPITest, MissingFileFailsJob) {
+    RealWebAPI api(1, 1024);
+
+    json result;
+    ASSERT_TRUE(api.executeCommandWithResult({{"command", "motion.start"}, {"filename", "job_missing_test.nc"}}, result));
+    const StatusResponse status = waitForJob(api);
+    EXPECT_EQ(status.job.phase, "failed");
+    EXPECT_FALSE(status.job.error.empty());
+    EXPECT_EQ(status.status, "idle");
+}
+
+TEST_F(RealWebAPITest, ParseFileSharesCachedResult) {
+    RealWebAPI api(1, 1024);
+    const std::string filename = writeProgram("parse_shared_test.nc", 100);
+
+    // 重复解析返回同一个缓存对象，不复制
+    auto first = api.parseFileShared(filename);
+    ASSERT_TRUE(first->success);
+    EXPECT_EQ(first->trajectoryPoints.size(), 100u);
+    EXPECT_EQ(api.parseFileShared(filename), first);
+    EXPECT_EQ(api.parseFile(filename).trajectoryPoints.size(), 100u);
+}
+
+TEST_F(RealWebAPITest, QueueRunsJobsBackToBack) {
+    RealWebAPI api(1, 1024);
+    json result;
+    std::vector<uint64_t> ids;
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(api.executeCommandWithResult(
+            {{"command", "queue.add"}, {"filename", writeProgram("job_queue_test" + std::to_string(i) + ".nc", 20)}},
+            result));
+        EXPECT_EQ(result["position"], static_cast<size_t>(i));
+        ids.push_back(result["jobId"].get<uint64_t>());
+    }
+
+    // 调整顺序并移除一个作业
+    ASSERT_TRUE(api.executeCommand({{"command", "queue.move"}, {"jobId", ids[2]}, {"position", 0}}));
+    ASSERT_TRUE(api.executeCommand({{"command", "queue.remove"}, {"jobId", ids[1]}}));
+    EXPECT_FALSE(api.executeCommand({{"command", "queue.remove"}, {"jobId", ids[1]}}));
+
+    // 队列未启动时也预先解析队首的作业
+    json list;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    do {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        ASSERT_TRUE(api.executeCommandWithResult({{"command", "queue.list"}}, list));
+    } while (list["queue"][0]["phase"] != "ready" && std::chrono::steady_clock::now() < deadline);
+    ASSERT_EQ(list["queue"].size(), 2u);
+    EXPECT_EQ(list["queue"][0]["id"], ids[2]);
+    EXPECT_EQ(list["queue"][0]["phase"], "ready");
+    EXPECT_EQ(list["queue"][0]["totalSegments"], 20u);
+    EXPECT_EQ(list["queue"][1]["id"], ids[0]);
+    EXPECT_EQ(list["history"][0]["phase"], "cancelled");
+    StatusResponse status;
+    api.getChannelStatus(0, status);
+    EXPECT_EQ(status.queuedJobs, 2u);
+
+    // 启动后依次执行，记录各阶段时间
+    ASSERT_TRUE(api.executeCommand({{"command", "queue.start"}}));
+    do {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        ASSERT_TRUE(api.executeCommandWithResult({{"command", "queue.list"}}, list));
+    } while (list["history"].size() < 3 && std::chrono::steady_clock::now() < deadline);
+    ASSERT_EQ(list["history"].size(), 3u);
+    EXPECT_TRUE(list["queue"].empty());
+    const json& first = list["history"][1];
+    const json& second = list["history"][2];
+    EXPECT_EQ(first["id"], ids[2]);
+    EXPECT_EQ(second["id"], ids[0]);
+    for (const json& job : {first, second}) {
+        EXPECT_EQ(job["phase"], "completed");
+        EXPECT_EQ(job["plannedSegments"], 20u);
+        EXPECT_LE(job["queuedAt"].get<uint64_t>(), job["parsedAt"].get<uint64_t>());
+        EXPECT_LE(job["parsedAt"].get<uint64_t>(), job["startedAt"].get<uint64_t>());
+        EXPECT_LE(job["startedAt"].get<uint64_t>(), job["finishedAt"].get<uint64_t>());
+    }
+    // 下一个作业在当前作业结束时已解析完成
+    EXPECT_LE(second["parsedAt"].get<uint64_t>(), first["finishedAt"].get<uint64_t>());
+    EXPECT_GE(second["startedAt"].get<uint64_t>(), first["finishedAt"].get<uint64_t>());
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include "xxcnc/core/web/StaticAssets.h"
+#include <brotli/decode.h>
+#include <zlib.h>
+#include <cstdint>
+#include <fstream>
+
+using namespace xxcnc::web;
+
+namespace {
+
+std::string gunzip(const std::string& input) {
+    z_stream stream{};
+    if (inflateInit2(&stream, 15 + 16) != Z_OK) {
+        return std::string();
+    }
+    std::string output(1 << 20, '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream.avail_in = static_cast<uInt>(input.size());
+    stream.next_out = reinterpret_cast<Bytef*>(&output[0]);
+    stream.avail_out = static_cast<uInt>(output.size());
+    const int result = inflate(&stream, Z_FINISH);
+    output.resize(stream.total_out);
+    inflateEnd(&stream);
+    return result == Z_STREAM_END ? output : std::string();
+}
+
+std::string unbrotli(const std::string& input) {
+    std::string output(1 << 20, '\0');
+    size_t size = output.size();
+    if (BrotliDecoderDecompress(input.size(), reinterpret_cast<const uint8_t*>(input.data()), &size,
+                                reinterpret_cast<uint8_t*>(&output[0])) != BROTLI_DECODER_RESULT_SUCCESS) {
+        return std::string();
+    }
+    output.resize(size);
+    return output;
+}
+
+} // namespace
+
+TEST(HttpCompressionTest, NegotiatesEncoding) {
+    EXPECT_EQ(negotiateEncoding(""), ContentEncoding::Identity);
+    EXPECT_EQ(negotiateEncoding("gzip, deflate, br"), ContentEncoding::Brotli);
+    EXPECT_EQ(negotiateEncoding("gzip, deflate"), ContentEncoding::Gzip);
+    EXPECT_EQ(negotiateEncoding("GZIP"), ContentEncoding::Gzip);
+    EXPECT_EQ(negotiateEncoding("br;q=0.5, gzip;q=0.8"), ContentEncoding::Gzip);
+    EXPECT_EQ(negotiateEncoding("br;q=0, gzip"), ContentEncoding::Gzip);
+    EXPECT_EQ(negotiateEncoding("*"), ContentEncoding::Brotli);
+    EXPECT_EQ(negotiateEncoding("br;q=0, *;q=0.1"), ContentEncoding::Gzip);
+    EXPECT_EQ(negotiateEncoding("identity, *;q=0"), ContentEncoding::Identity);
+    // 只在有对应版本时选择
+    EXPECT_EQ(negotiateEncoding("gzip, br", false, true), ContentEncoding::Gzip);
+    EXPECT_EQ(negotiateEncoding("gzip, br", false, false), ContentEncoding::Identity);
+}
+
+TEST(HttpCompressionTest, CompressesRoundTrip) {
+    std::string json = "[";
+    for (int i = 0; i < 1000; ++i) {
+        json += R"({"x":)" + std::to_string(i * 0.1) + R"(,"y":0.5,"command":"G01"},)";
+    }
+    json += "{}]";
+
+    std::string gzip;
+    ASSERT_TRUE(compressContent(ContentEncoding::Gzip, json, gzip));
+    EXPECT_LT(gzip.size(), json.size() / 4);
+    EXPECT_EQ(gunzip(gzip), json);
+
+    std::string brotli;
+    ASSERT_TRUE(compressContent(ContentEncoding::Brotli, json, brotli, CompressionEffort::Best));
+    EXPECT_LT(brotli.size(), gzip.size());
+    EXPECT_EQ(unbrotli(brotli), json);
+}
+
+class StaticAssetsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        root_ = std::filesystem::temp_directory_path() / "xxcnc_static_assets_test";
+        std::filesystem::remove_all(root_);
+        std::filesystem::create_directories(root_ / "js");
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(root_);
+    }
+
+    void writeFile(const std::string& name, const std::string& content) {
+        std::ofstream(root_ / name, std::ios::binary) << content;
+    }
+
+    std::filesystem::path root_;
+};
+
+TEST_F(StaticAssetsTest, LoadsAndPrecompresses) {
+    std::string script;
+    for (int i = 0; i < 200; ++i) {
+        script += "function update" + std::to_string(i) + "() { return document.getElementById('status'); }\n";
+    }
+    writeFile("index.html", "<!DOCTYPE html><html><body>xxcnc</body></html>");
+    writeFile("js/main.js", script);
+    writeFile("logo.png", std::string(4096, 'a'));
+
+    StaticAssets assets;
+    ASSERT_TRUE(assets.load(root_));
+    EXPECT_EQ(assets.size(), 3u);
+
+    // 目录路径返回 index.html，HTML 每次向服务器确认
+    auto index = assets.find("/");
+    ASSERT_NE(index, nullptr);
+    EXPECT_EQ(index, assets.find("/index.html"));
+    EXPECT_EQ(index->contentType, "text/html; charset=utf-8");
+    EXPECT_EQ(index->cacheControl, "no-cache");
+    EXPECT_EQ(assets.find("/missing.js"), nullptr);
+
+    auto main = assets.find("/js/main.js");
+    ASSERT_NE(main, nullptr);
+    EXPECT_EQ(main->contentType, "text/javascript; charset=utf-8");
+    EXPECT_EQ(main->cacheControl, "public, max-age=" + std::to_string(StaticAssets::kMaxAge));
+    EXPECT_EQ(main->identity, script);
+    EXPECT_EQ(gunzip(main->gzip), script);
+    EXPECT_EQ(unbrotli(main->brotli), script);
+    EXPECT_EQ(&main->body(ContentEncoding::Brotli), &main->brotli);
+
+    // 各编码版本的实体标签不同
+    EXPECT_EQ(main->etag.front(), '"');
+    EXPECT_NE(main->etagFor(ContentEncoding::Gzip), main->etag);
+    EXPECT_NE(main->etagFor(ContentEncoding::Gzip), main->etagFor(ContentEncoding::Brotli));
+    EXPECT_EQ(main->etagFor(ContentEncoding::Identity), main->etag);
+
+    // 已压缩的格式不再压缩
+    auto logo = assets.find("/logo.png");
+    ASSERT_NE(logo, nullptr);
+    EXPECT_TRUE(logo->gzip.empty());
+    EXPECT_TRUE(logo->brotli.empty());
+    EXPECT_EQ(&logo->body(ContentEncoding::Gzip), &logo->identity);
+
+    EXPECT_EQ(assets.getMemoryUsage(), index->identity.size() + index->gzip.size() + index->brotli.size() +
+                                           main->identity.size() + main->gzip.size() + main->brotli.size() +
+                                           logo->identity.size());
+}
+
+TEST_F(StaticAssetsTest, EtagFollowsContent) {
+    writeFile("app.js", "console.log(1);");
+    StaticAssets assets;
+    ASSERT_TRUE(assets.load(root_));
+    const std::string first = assets.find("/app.js")->etag;
+    ASSERT_TRUE(assets.load(root_));
+    EXPECT_EQ(assets.find("/app.js")->etag, first);
+
+    writeFile("app.js", "console.log(2);");
+    ASSERT_TRUE(assets.load(root_));
+    EXPECT_NE(assets.find("/app.js")->etag, first);
+
+    // 目录不存在时保留已加载的资源
+    EXPECT_FALSE(assets.load(root_ / "missing"));
+    EXPECT_EQ(assets.size(), 1u);
+}
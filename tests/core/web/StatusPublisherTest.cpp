@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "xxcnc/core/web/StatusPublisher.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace xxcnc::web;
+
+class StatusPublisherTest : public ::testing::Test {
+protected:
+    StatusPublisherTest()
+        : publisher_([this](int channel, StatusResponse& status) {
+                         if (channel >= 2) {
+                             return false;
+                         }
+                         ++samples_;
+                         status.channel = channel;
+                         status.status = "idle";
+                         status.position.x = position_;
+                         status.trajectoryPoints.resize(3);
+                         return true;
+                     },
+                     [](const StatusResponse& status) {
+                         return std::to_string(status.channel) + ":" + status.status + ":" +
+                                std::to_string(status.position.x) + ":" + std::to_string(status.trajectoryPoints.size());
+                     })
+    {
+    }
+
+    std::atomic<int> samples_{0};
+    std::atomic<double> position_{0.0};
+    StatusPublisher publisher_;
+};
+
+TEST_F(StatusPublisherTest, SharesDocumentWithinPeriod) {
+    auto first = publisher_.acquire(0, std::chrono::hours(1));
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first->json, "0:idle:0.000000:0");
+    EXPECT_TRUE(first->status.trajectoryPoints.empty());
+    EXPECT_FALSE(first->etag.empty());
+
+    // 周期内所有读取共享同一份文档
+    position_ = 5.0;
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(publisher_.acquire(0, std::chrono::hours(1)), first);
+    }
+    EXPECT_EQ(samples_, 1);
+
+    // 各通道分别发布，无效通道返回空
+    auto second = publisher_.acquire(1, std::chrono::hours(1));
+    ASSERT_NE(second, nullptr);
+    EXPECT_NE(second->etag, first->etag);
+    EXPECT_EQ(publisher_.acquire(2, std::chrono::hours(1)), nullptr);
+    EXPECT_EQ(publisher_.acquire(-1, std::chrono::hours(1)), nullptr);
+}
+
+TEST_F(StatusPublisherTest, VersionChangesOnlyWithContent) {
+    auto first = publisher_.acquire(0, std::chrono::nanoseconds(0));
+    auto same = publisher_.acquire(0, std::chrono::nanoseconds(0));
+    EXPECT_EQ(samples_, 2);
+    EXPECT_EQ(same, first);
+
+    position_ = 1.0;
+    auto changed = publisher_.acquire(0, std::chrono::nanoseconds(0));
+    EXPECT_GT(changed->version, first->version);
+    EXPECT_NE(changed->etag, first->etag);
+    EXPECT_EQ(changed->json, "0:idle:1.000000:0");
+    // 旧文档不受影响，仍在使用它的请求可以继续发送
+    EXPECT_EQ(first->json, "0:idle:0.000000:0");
+}
+
+TEST_F(StatusPublisherTest, ConcurrentReadersSampleOnce) {
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([this]() {
+            for (int j = 0; j < 1000; ++j) {
+                ASSERT_NE(publisher_.acquire(0, std::chrono::hours(1)), nullptr);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(samples_, 1);
+    EXPECT_EQ(publisher_.getSampleCount(), 1u);
+}
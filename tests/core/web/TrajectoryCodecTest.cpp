@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "xxcnc/core/web/TrajectoryCodec.h"
+#include "xxcnc/core/web/TrajectoryHistory.h"
+#include <cstring>
+
+using namespace xxcnc::web;
+
+namespace {
+
+std::vector<TrajectoryPoint> createPoints(size_t count, uint64_t firstSequence) {
+    std::vector<TrajectoryPoint> points(count);
+    for (size_t i = 0; i < count; ++i) {
+        points[i].x = 0.5 * static_cast<double>(i);
+        points[i].y = -0.25 * static_cast<double>(i);
+        points[i].z = 1.0;
+        points[i].isRapid = (i % 3) == 0;
+        points[i].lineNumber = static_cast<int>(i) + 10;
+        points[i].command = "G01 X1";
+        points[i].sequence = firstSequence + i;
+    }
+    return points;
+}
+
+} // namespace
+
+TEST(TrajectoryCodecTest, RoundTripAndLayout) {
+    BinaryTrajectoryHeader header;
+    header.channel = 2;
+    header.firstSequence = 101;
+    header.latestSequence = 500;
+    header.clearedSequence = 7;
+    header.more = true;
+    const auto points = createPoints(5, header.firstSequence);
+
+    const std::string data = BinaryTrajectoryEncoder::encode(points, header);
+    // 40 字节头部 + 5×12 字节坐标 + 8 字节标志（补齐后）+ 5×4 字节行号 + 5×8 字节序号
+    ASSERT_EQ(data.size(), 40u + 60u + 8u + 20u + 40u);
+    EXPECT_EQ(data.substr(0, 4), "XXTJ");
+
+    // 坐标数组位于 4 字节对齐的偏移处，可以直接按 float 读取
+    float x1 = 0.0f;
+    std::memcpy(&x1, data.data() + BinaryTrajectoryEncoder::kHeaderSize + 12, sizeof(x1));
+    EXPECT_FLOAT_EQ(x1, 0.5f);
+
+    BinaryTrajectoryHeader decodedHeader;
+    std::vector<TrajectoryPoint> decoded;
+    ASSERT_TRUE(BinaryTrajectoryEncoder::decode(data, decodedHeader, decoded));
+    EXPECT_EQ(decodedHeader.channel, 2);
+    EXPECT_EQ(decodedHeader.firstSequence, 101u);
+    EXPECT_EQ(decodedHeader.latestSequence, 500u);
+    EXPECT_EQ(decodedHeader.clearedSequence, 7u);
+    EXPECT_TRUE(decodedHeader.more);
+    ASSERT_EQ(decoded.size(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT_FLOAT_EQ(static_cast<float>(decoded[i].x), static_cast<float>(points[i].x));
+        EXPECT_FLOAT_EQ(static_cast<float>(decoded[i].y), static_cast<float>(points[i].y));
+        EXPECT_FLOAT_EQ(static_cast<float>(decoded[i].z), static_cast<float>(points[i].z));
+        EXPECT_EQ(decoded[i].isRapid, points[i].isRapid);
+        EXPECT_EQ(decoded[i].lineNumber, points[i].lineNumber);
+        EXPECT_EQ(decoded[i].sequence, points[i].sequence);
+    }
+
+    // 截断或魔数错误的数据被拒绝
+    EXPECT_FALSE(BinaryTrajectoryEncoder::decode(data.substr(0, data.size() - 1), decodedHeader, decoded));
+    std::string corrupted = data;
+    corrupted[0] = 'Y';
+    EXPECT_FALSE(BinaryTrajectoryEncoder::decode(corrupted, decodedHeader, decoded));
+}
+
+TEST(TrajectoryCodecTest, KeepsSequencesOfCompactedHistory) {
+    TrajectoryHistory history(TrajectoryHistory::kMinCapacity);
+    TrajectoryPoint point;
+    for (int i = 0; i < 40; ++i) {
+        point.x = i;
+        history.append(point);
+    }
+
+    std::vector<TrajectoryPoint> points;
+    ASSERT_GT(history.read(0, 1000, points), 1u);
+    // 抽稀后序号不连续
+    ASSERT_NE(points.back().sequence - points.front().sequence, points.size() - 1);
+
+    BinaryTrajectoryHeader header;
+    header.firstSequence = points.front().sequence;
+    header.latestSequence = history.getLatestSequence();
+    const std::string data = BinaryTrajectoryEncoder::encode(points, header);
+
+    BinaryTrajectoryHeader decodedHeader;
+    std::vector<TrajectoryPoint> decoded;
+    ASSERT_TRUE(BinaryTrajectoryEncoder::decode(data, decodedHeader, decoded));
+    ASSERT_EQ(decoded.size(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT_EQ(decoded[i].sequence, points[i].sequence);
+        EXPECT_FLOAT_EQ(static_cast<float>(decoded[i].x), static_cast<float>(points[i].x));
+    }
+
+    // 以解码出的最后一个序号为游标继续读取，不重复也不遗漏
+    history.append(point);
+    ASSERT_EQ(history.read(decoded.back().sequence, 1000, points), 1u);
+    EXPECT_EQ(points[0].sequence, history.getLatestSequence());
+}
+
+TEST(TrajectoryCodecTest, ChunksRespectSizeAndMatchWholeEncoding) {
+    const auto points = createPoints(1001, 0);
+    const std::string whole = BinaryTrajectoryEncoder::encode(points, BinaryTrajectoryHeader());
+
+    BinaryTrajectoryEncoder encoder(points, BinaryTrajectoryHeader());
+    EXPECT_EQ(encoder.getEncodedSize(), whole.size());
+    std::string joined;
+    std::string chunk;
+    size_t chunks = 0;
+    while (encoder.nextChunk(chunk, 1000)) {
+        EXPECT_LE(chunk.size(), 1000u);
+        joined += chunk;
+        ++chunks;
+    }
+    EXPECT_EQ(joined, whole);
+    EXPECT_GT(chunks, whole.size() / 1000);
+
+    // 带序号列时分块结果同样与整体编码一致
+    BinaryTrajectoryHeader sequenced;
+    sequenced.firstSequence = 1;
+    const std::string wholeSequenced = BinaryTrajectoryEncoder::encode(createPoints(1001, 1), sequenced);
+    BinaryTrajectoryEncoder sequencedEncoder(createPoints(1001, 1), sequenced);
+    EXPECT_EQ(sequencedEncoder.getEncodedSize(), wholeSequenced.size());
+    joined.clear();
+    while (sequencedEncoder.nextChunk(chunk, 1000)) {
+        EXPECT_LE(chunk.size(), 1000u);
+        joined += chunk;
+    }
+    EXPECT_EQ(joined, wholeSequenced);
+    EXPECT_EQ(wholeSequenced.size(), whole.size() + 1001u * 8);
+
+    // 空轨迹只有头部
+    const std::string empty = BinaryTrajectoryEncoder::encode({}, BinaryTrajectoryHeader());
+    EXPECT_EQ(empty.size(), BinaryTrajectoryEncoder::kHeaderSize);
+}
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include "xxcnc/core/web/TrajectoryHistory.h"
+#include <chrono>
+#include <iostream>
+#include <limits>
+
+using namespace xxcnc::web;
+
+namespace {
+
+TrajectoryPoint createPoint(double x, int lineNumber, const std::string& command) {
+    TrajectoryPoint point;
+    point.x = x;
+    point.y = -x;
+    point.z = 0.5;
+    point.isRapid = lineNumber % 2 == 0;
+    point.lineNumber = lineNumber;
+    point.command = command;
+    return point;
+}
+
+} // namespace
+
+TEST(TrajectoryHistoryTest, AppendAndReadByCursor) {
+    TrajectoryHistory history(100);
+    EXPECT_TRUE(history.empty());
+    EXPECT_EQ(history.getLatestSequence(), 0u);
+
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(history.append(createPoint(i, i + 1, i < 5 ? "G01 X1" : "G00 X2")), static_cast<uint64_t>(i + 1));
+    }
+    EXPECT_EQ(history.size(), 10u);
+    EXPECT_EQ(history.getCommandCount(), 2u);
+
+    std::vector<TrajectoryPoint> points;
+    EXPECT_EQ(history.read(0, 100, points), 10u);
+    EXPECT_EQ(points.front().sequence, 1u);
+    EXPECT_EQ(points[3].command, "G01 X1");
+    EXPECT_EQ(points[7].command, "G00 X2");
+    EXPECT_EQ(points[7].lineNumber, 8);
+    EXPECT_FLOAT_EQ(static_cast<float>(points[7].y), -7.0f);
+    EXPECT_TRUE(points[1].isRapid);
+
+    EXPECT_EQ(history.read(6, 2, points), 2u);
+    EXPECT_EQ(points[0].sequence, 7u);
+    EXPECT_EQ(points[1].sequence, 8u);
+    EXPECT_EQ(history.read(10, 100, points), 0u);
+    EXPECT_EQ(history.read(std::numeric_limits<uint64_t>::max(), 100, points), 0u);
+
+    TrajectoryPoint last;
+    ASSERT_TRUE(history.back(last));
+    EXPECT_EQ(last.sequence, 10u);
+
+    // 清除后序号继续递增
+    history.clear();
+    EXPECT_TRUE(history.empty());
+    EXPECT_FALSE(history.back(last));
+    EXPECT_EQ(history.append(createPoint(1, 1, "")), 11u);
+    EXPECT_EQ(history.read(0, 100, points), 1u);
+    EXPECT_EQ(points[0].sequence, 11u);
+}
+
+TEST(TrajectoryHistoryTest, DownsamplesOlderHistoryWhenFull) {
+    TrajectoryHistory history(64);
+    for (int i = 0; i < 1000; ++i) {
+        history.append(createPoint(i, i + 1, "N" + std::to_string(i)));
+    }
+    EXPECT_LE(history.size(), 64u);
+    EXPECT_EQ(history.capacity(), 64u);
+    // 命令表只保留仍被引用的命令
+    EXPECT_LE(history.getCommandCount(), 64u);
+
+    std::vector<TrajectoryPoint> points;
+    history.read(0, 1000, points);
+    ASSERT_EQ(points.size(), history.size());
+    // 第一个点始终保留，序号严格递增，最近的点保持完整分辨率
+    EXPECT_EQ(points.front().sequence, 1u);
+    EXPECT_EQ(points.back().sequence, 1000u);
+    for (size_t i = 1; i < points.size(); ++i) {
+        EXPECT_LT(points[i - 1].sequence, points[i].sequence);
+        EXPECT_EQ(points[i].command, "N" + std::to_string(points[i].sequence - 1));
+    }
+    for (size_t i = points.size() - 16; i < points.size(); ++i) {
+        EXPECT_EQ(points[i].sequence, points[i - 1].sequence + 1);
+    }
+
+    // 游标落在抽稀过的部分时从下一个保留的点开始
+    for (uint64_t since : {uint64_t(0), uint64_t(2), uint64_t(500), uint64_t(990), uint64_t(999)}) {
+        std::vector<TrajectoryPoint> tail;
+        history.read(since, 1000, tail);
+        ASSERT_FALSE(tail.empty());
+        EXPECT_GT(tail.front().sequence, since);
+        EXPECT_EQ(tail.back().sequence, 1000u);
+        size_t expected = 0;
+        for (const auto& point : points) {
+            expected += point.sequence > since ? 1 : 0;
+        }
+        EXPECT_EQ(tail.size(), expected);
+    }
+}
+
+TEST(TrajectoryHistoryTest, ReadsStayConsistentDuringCompaction) {
+    // 抽稀逐步进行，每次追加后读取到的点都完整有序，命令与点对应
+    TrajectoryHistory history(100);
+    std::vector<TrajectoryPoint> points;
+    for (int i = 0; i < 2000; ++i) {
+        history.append(createPoint(i, i + 1, "N" + std::to_string(i / 3)));
+        ASSERT_LE(history.size(), history.capacity());
+        ASSERT_EQ(history.read(0, 1000, points), history.size());
+        EXPECT_EQ(points.front().sequence, 1u);
+        EXPECT_EQ(points.back().sequence, static_cast<uint64_t>(i + 1));
+        for (size_t j = 0; j < points.size(); ++j) {
+            ASSERT_TRUE(j == 0 || points[j - 1].sequence < points[j].sequence) << "append " << i;
+            ASSERT_EQ(points[j].command, "N" + std::to_string((points[j].sequence - 1) / 3));
+            ASSERT_FLOAT_EQ(static_cast<float>(points[j].x), static_cast<float>(points[j].sequence - 1));
+        }
+
+        // 从中间的游标读取与全部读取的结果一致
+        const uint64_t since = points[points.size() / 3].sequence - 1;
+        std::vector<TrajectoryPoint> tail;
+        history.read(since, 1000, tail);
+        ASSERT_EQ(tail.size(), points.size() - points.size() / 3);
+        EXPECT_EQ(tail.front().sequence, since + 1);
+
+        TrajectoryPoint last;
+        ASSERT_TRUE(history.back(last));
+        EXPECT_EQ(last.sequence, points.back().sequence);
+    }
+    EXPECT_LE(history.getCommandCount(), history.size());
+}
+
+TEST(TrajectoryHistoryTest, CommandTableStaysWithinBudget) {
+    // 每点都是不同的长命令，命令表按字节受限，超出时触发抽稀或不保存命令文本
+    constexpr size_t kCapacity = 1000;
+    TrajectoryHistory history(kCapacity);
+    const size_t columns = history.getMemoryUsage();
+    const std::string padding(200, 'X');
+    for (int i = 0; i < 20000; ++i) {
+        history.append(createPoint(i, i + 1, "N" + std::to_string(i) + padding));
+        ASSERT_LE(history.getMemoryUsage() - columns,
+                  kCapacity * TrajectoryHistory::kCommandBytesPerPoint + 2 * sizeof(std::string) + 8);
+    }
+
+    std::vector<TrajectoryPoint> points;
+    history.read(0, kCapacity, points);
+    ASSERT_FALSE(points.empty());
+    EXPECT_EQ(points.back().command, "N19999" + padding);
+    for (const auto& point : points) {
+        EXPECT_TRUE(point.command.empty() || point.command == "N" + std::to_string(point.sequence - 1) + padding);
+    }
+
+    history.clear();
+    EXPECT_EQ(history.getMemoryUsage(), columns);
+    EXPECT_EQ(history.getCommandCount(), 0u);
+}
+
+TEST(TrajectoryHistoryTest, Performance) {
+    constexpr size_t kCapacity = 100000;
+    constexpr int kPoints = 2000000;
+    TrajectoryHistory history(kCapacity);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < kPoints; ++i) {
+        history.append(createPoint(i * 0.01, i / 100 + 1, "G01 X10 Y20"));
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double appendNs = std::chrono::duration<double, std::nano>(end - start).count() / kPoints;
+
+    std::vector<TrajectoryPoint> points;
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < 10000; ++i) {
+        history.read(history.getLatestSequence() - 10, 100, points);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double readNs = std::chrono::duration<double, std::nano>(end - start).count() / 10000;
+
+    std::cout << "追加 " << kPoints << " 个点，平均每点 " << appendNs << " ns；读取最新10个点平均 " << readNs
+              << " ns；内存 " << history.getMemoryUsage() / 1024 << " KB（" << history.size() << " 点）" << std::endl;
+    EXPECT_LE(history.size(), kCapacity);
+    EXPECT_EQ(points.size(), 10u);
+    EXPECT_LT(history.getMemoryUsage(), kCapacity * 40);
+}
@@ -0,0 +1,138 @@
+#define _USE_MATH_DEFINES
+#include <gtest/gtest.h>
+#include "xxcnc/core/web/TrajectoryPyramid.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+using namespace xxcnc::web;
+
+namespace {
+
+/// 半径 50mm 的螺旋线，每圈 segments 个点，第一个点为快速定位
+std::vector<TrajectoryPoint> createHelix(size_t count, size_t segments) {
+    std::vector<TrajectoryPoint> points(count);
+    for (size_t i = 0; i < count; ++i) {
+        const double angle = 2.0 * M_PI * static_cast<double>(i) / static_cast<double>(segments);
+        points[i].x = 50.0 * std::cos(angle);
+        points[i].y = 50.0 * std::sin(angle);
+        points[i].z = -0.001 * static_cast<double>(i);
+        points[i].isRapid = i == 0;
+        points[i].lineNumber = static_cast<int>(i) + 1;
+        points[i].command = "G01";
+    }
+    return points;
+}
+
+/// 点到折线的最小距离
+double distanceToPolyline(const TrajectoryPoint& p, const std::vector<TrajectoryPoint>& polyline) {
+    double best = 1e300;
+    for (size_t i = 0; i + 1 < polyline.size(); ++i) {
+        const TrajectoryPoint& a = polyline[i];
+        const TrajectoryPoint& b = polyline[i + 1];
+        const double dx = b.x - a.x, dy = b.y - a.y, dz = b.z - a.z;
+        const double lengthSquared = dx * dx + dy * dy + dz * dz;
+        double t = lengthSquared > 0.0 ? ((p.x - a.x) * dx + (p.y - a.y) * dy + (p.z - a.z) * dz) / lengthSquared : 0.0;
+        t = std::min(1.0, std::max(0.0, t));
+        const double ex = a.x + t * dx - p.x, ey = a.y + t * dy - p.y, ez = a.z + t * dz - p.z;
+        best = std::min(best, std::sqrt(ex * ex + ey * ey + ez * ez));
+    }
+    return best;
+}
+
+} // namespace
+
+TEST(TrajectoryPyramidTest, LevelsRespectToleranceAndKeepRapidBoundaries) {
+    auto points = createHelix(4000, 400);
+    // 中间插入一段快速定位
+    for (size_t i = 2000; i < 2010; ++i) {
+        points[i].isRapid = true;
+    }
+
+    TrajectoryPyramidOptions options;
+    options.tilePoints = 256;
+    options.minPoints = 64;
+    TrajectoryPyramid pyramid(points, options);
+
+    ASSERT_GT(pyramid.getLevelCount(), 2u);
+    EXPECT_EQ(pyramid.getLevel(0).points.size(), points.size());
+    EXPECT_TRUE(pyramid.getLevel(0).points[0].command.empty());
+
+    for (size_t level = 1; level < pyramid.getLevelCount(); ++level) {
+        const auto& info = pyramid.getLevel(level);
+        EXPECT_LT(info.points.size(), pyramid.getLevel(level - 1).points.size());
+        EXPECT_EQ(info.points.front().lineNumber, 1);
+        EXPECT_EQ(info.points.back().lineNumber, 4000);
+
+        // 快速定位段的分界点保留
+        bool hasRapidStart = false;
+        bool hasRapidEnd = false;
+        for (const auto& point : info.points) {
+            hasRapidStart |= point.lineNumber == 2000;
+            hasRapidEnd |= point.lineNumber == 2010;
+        }
+        EXPECT_TRUE(hasRapidStart);
+        EXPECT_TRUE(hasRapidEnd);
+
+        // 相对原始轨迹的误差不超过累计容差
+        const double bound = info.tolerance * options.levelFactor / (options.levelFactor - 1.0) + 1e-9;
+        for (size_t i = 0; i < points.size(); i += 37) {
+            EXPECT_LE(distanceToPolyline(points[i], info.points), bound) << "level " << level << " point " << i;
+        }
+    }
+}
+
+TEST(TrajectoryPyramidTest, TilesAreContiguousAndQueryByViewport) {
+    TrajectoryPyramidOptions options;
+    options.tilePoints = 100;
+    TrajectoryPyramid pyramid(createHelix(1000, 1000), options);
+
+    const auto& base = pyramid.getLevel(0);
+    ASSERT_EQ(base.tiles.size(), 11u);
+    EXPECT_EQ(base.tiles.front().begin, 0u);
+    EXPECT_EQ(base.tiles.back().end, 999u);
+    for (size_t i = 1; i < base.tiles.size(); ++i) {
+        EXPECT_EQ(base.tiles[i].begin, base.tiles[i - 1].end);
+    }
+
+    // 第一象限只与前约四分之一的瓦片相交
+    TrajectoryBounds viewport;
+    viewport.minX = 1.0;
+    viewport.minY = 1.0;
+    viewport.maxX = 60.0;
+    viewport.maxY = 60.0;
+    auto tiles = pyramid.queryTiles(0, viewport);
+    ASSERT_FALSE(tiles.empty());
+    EXPECT_EQ(tiles.front(), 0u);
+    EXPECT_LE(tiles.size(), 4u);
+
+    EXPECT_NEAR(pyramid.getBounds().maxX, 50.0, 1e-9);
+    EXPECT_NEAR(pyramid.getBounds().minY, -50.0, 1e-3);
+    EXPECT_TRUE(pyramid.queryTiles(pyramid.getLevelCount(), viewport).empty());
+
+    // 像素越大选择越粗的层
+    EXPECT_EQ(pyramid.selectLevel(0.0), 0u);
+    EXPECT_EQ(pyramid.selectLevel(1e9), pyramid.getLevelCount() - 1);
+
+    // 空轨迹只有第0层，没有瓦片
+    TrajectoryPyramid empty({});
+    EXPECT_EQ(empty.getLevelCount(), 1u);
+    EXPECT_TRUE(empty.getLevel(0).tiles.empty());
+}
+
+TEST(TrajectoryPyramidTest, Performance) {
+    const auto points = createHelix(1000000, 2000);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    TrajectoryPyramid pyramid(points);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    std::cout << "构建 " << points.size() << " 点的轨迹金字塔耗时: "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+    for (size_t level = 0; level < pyramid.getLevelCount(); ++level) {
+        const auto& info = pyramid.getLevel(level);
+        std::cout << "  第 " << level << " 层: 容差 " << info.tolerance << " mm, " << info.points.size()
+                  << " 点, " << info.tiles.size() << " 瓦片" << std::endl;
+    }
+    EXPECT_LT(pyramid.getLevel(pyramid.getLevelCount() - 1).points.size(), points.size() / 10);
+}
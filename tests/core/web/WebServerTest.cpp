@@ -186,3 +186,41 @@ TEST_F(WebServerTest, UpdateConfig_InvalidConfig_ReturnsFalse) {
     auto response = callback.value()(json{{"config", {{"invalidKey", "value"}}}});
     EXPECT_FALSE(response["success"]);
 }
+
+TEST_F(WebServerTest, GetChannelUpdate_ReturnsPointsAfterCursor) {
+    StatusResponse status;
+    status.status = "machining";
+    for (int i = 0; i < 5; ++i) {
+        TrajectoryPoint point;
+        point.x = i;
+        point.sequence = static_cast<uint64_t>(i + 11);
+        status.trajectoryPoints.push_back(point);
+    }
+    EXPECT_CALL(*mockAPI, getSystemStatus())
+        .WillRepeatedly(Return(status));
+
+    StatusResponse update;
+    ASSERT_TRUE(mockAPI->getChannelUpdate(0, 13, 100, update));
+    EXPECT_EQ(update.trajectorySequence, 15u);
+    ASSERT_EQ(update.trajectoryPoints.size(), 2u);
+    EXPECT_EQ(update.trajectoryPoints[0].sequence, 14u);
+
+    // 游标为0时从头获取，并受点数上限限制
+    ASSERT_TRUE(mockAPI->getChannelUpdate(0, 0, 3, update));
+    ASSERT_EQ(update.trajectoryPoints.size(), 3u);
+    EXPECT_EQ(update.trajectoryPoints[0].sequence, 11u);
+
+    ASSERT_TRUE(mockAPI->getChannelUpdate(0, 15, 100, update));
+    EXPECT_TRUE(update.trajectoryPoints.empty());
+
+    EXPECT_FALSE(mockAPI->getChannelUpdate(1, 0, 100, update));
+}
+
+TEST_F(WebServerTest, PushSettings_DefaultsAndSetters) {
+    EXPECT_DOUBLE_EQ(server->getPushRate(), 30.0);
+    EXPECT_DOUBLE_EQ(server->getPushDeadband(), 0.001);
+    server->setPushRate(10.0);
+    server->setPushDeadband(0.01);
+    EXPECT_DOUBLE_EQ(server->getPushRate(), 10.0);
+    EXPECT_DOUBLE_EQ(server->getPushDeadband(), 0.01);
+}